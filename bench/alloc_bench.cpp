@@ -0,0 +1,229 @@
+// Выделения памяти ImGui/ImPlot за кадр: 16 графиков 4x4 с легендами и таблица 40x6, без окна и GPU.
+// Прежний путь - malloc/free через считающую обёртку, установленную ImGui::SetAllocatorFunctions(),
+// новый - FrameAllocator (пулы по размерам) со своей статистикой кадра.
+// alloc_bench [кадров]
+// Первые кадры (рост буферов) выводятся отдельно от установившегося режима.
+#include <FrameAllocator.h>
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <implot.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+static const int Rows = 4, Columns = 4, Lines = 3, Points = 1000;
+static const int TableRows = 40, TableColumns = 6;
+static const int Warmup = 10;
+
+// malloc/free со счётчиками, как их видит ImGui без FrameAllocator
+struct MallocCounter
+{
+    int allocs;
+    size_t bytes;
+};
+
+static void *CountingAlloc(size_t size, void *user_data)
+{
+    MallocCounter *counter = static_cast<MallocCounter *>(user_data);
+    counter->allocs++;
+    counter->bytes += size;
+    return malloc(size);
+}
+
+static void CountingFree(void *ptr, void *user_data)
+{
+    IM_UNUSED(user_data);
+    free(ptr);
+}
+
+struct Totals
+{
+    double allocs;   // выделений через ImGui
+    double mallocs;  // из них дошли до malloc
+    double bytes;    // запрошено байт
+    double frame_us; // весь кадр от NewFrame до Render
+    ImGuiID checksum;
+};
+
+static void CreateContexts()
+{
+    ImGui::CreateContext();
+    ImPlot::CreateContext();
+    ImGuiIO &io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(1920, 1080);
+    io.DeltaTime = 1.0f / 60.0f;
+    unsigned char *pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+}
+
+static void DestroyContexts()
+{
+    ImPlot::DestroyContext();
+    ImGui::DestroyContext();
+}
+
+static void Frame(int frame, const std::vector<double> &xs, const std::vector<std::vector<double>> &ys)
+{
+    static const char *Headers[TableColumns] = {"Channel", "Source", "Last", "Min", "Max", "Rate, Hz"};
+    const ImVec2 display = ImGui::GetIO().DisplaySize;
+    ImGui::NewFrame();
+
+    ImGui::SetNextWindowPos(ImVec2(0, 0));
+    ImGui::SetNextWindowSize(ImVec2(display.x * 0.7f, display.y));
+    ImGui::Begin("Graphs", nullptr, ImGuiWindowFlags_NoDecoration);
+    if (ImPlot::BeginSubplots("##grid", Rows, Columns, ImVec2(-1, -1)))
+    {
+        for (int p = 0; p < Rows * Columns; p++)
+        {
+            char title[48];
+            snprintf(title, sizeof(title), "Accelerometer %d##plot%d", p, p);
+            if (ImPlot::BeginPlot(title))
+            {
+                ImPlot::SetupAxes("time, s", "acceleration, m/s^2");
+                ImPlot::SetupAxisLimits(ImAxis_X1, frame / 60.0, frame / 60.0 + 10, ImGuiCond_Always);
+                ImPlot::SetupAxisLimits(ImAxis_Y1, -2, 2, ImGuiCond_Always);
+                for (int l = 0; l < Lines; l++)
+                {
+                    char label[48];
+                    snprintf(label, sizeof(label), "sensor %d axis %c", p, 'X' + l);
+                    ImPlot::PlotLine(label, xs.data(), ys[p * Lines + l].data(), (int)xs.size());
+                }
+                ImPlot::EndPlot();
+            }
+        }
+        ImPlot::EndSubplots();
+    }
+    ImGui::End();
+
+    ImGui::SetNextWindowPos(ImVec2(display.x * 0.7f, 0));
+    ImGui::SetNextWindowSize(ImVec2(display.x * 0.3f, display.y));
+    ImGui::Begin("Channels", nullptr, ImGuiWindowFlags_NoDecoration);
+    if (ImGui::BeginTable("##stats", TableColumns, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable))
+    {
+        for (int c = 0; c < TableColumns; c++)
+            ImGui::TableSetupColumn(Headers[c]);
+        ImGui::TableHeadersRow();
+        for (int r = 0; r < TableRows; r++)
+        {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::Text("accelerometer_%02d", r);
+            ImGui::TableNextColumn();
+            ImGui::Text("COM%d, frame %d", 3 + r % 4, r / 4);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.4f", sin(frame * 0.01 + r));
+            ImGui::TableNextColumn();
+            ImGui::Text("%.4f", -1.0 - r * 0.01);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.4f", 1.0 + r * 0.01);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", 1000.0 + r);
+        }
+        ImGui::EndTable();
+    }
+    ImGui::End();
+    ImGui::Render();
+}
+
+static ImGuiID Checksum(ImGuiID checksum)
+{
+    const ImDrawData *draw_data = ImGui::GetDrawData();
+    for (int l = 0; l < draw_data->CmdListsCount; l++)
+    {
+        const ImDrawList *list = draw_data->CmdLists[l];
+        checksum = ImHashData(list->VtxBuffer.Data, list->VtxBuffer.Size * sizeof(ImDrawVert), checksum);
+        checksum = ImHashData(list->IdxBuffer.Data, list->IdxBuffer.Size * sizeof(ImDrawIdx), checksum);
+    }
+    return checksum;
+}
+
+static void Print(const char *name, const Totals &warmup, const Totals &steady, int frames)
+{
+    printf("%-15s first %d frames: %7.1f allocs/frame, %7.1f malloc/frame, %8.1f KB/frame\n", name, Warmup,
+           warmup.allocs / Warmup, warmup.mallocs / Warmup, warmup.bytes / Warmup / 1024);
+    printf("%-15s next %4d frames: %7.2f allocs/frame, %7.2f malloc/frame, %8.1f KB/frame, frame %.1f us, checksum %08X\n",
+           "", frames, steady.allocs / frames, steady.mallocs / frames, steady.bytes / frames / 1024, steady.frame_us / frames,
+           steady.checksum);
+}
+
+int main(int argc, char **argv)
+{
+    const int frames = argc > 1 ? atoi(argv[1]) : 400;
+
+    std::vector<double> xs(Points);
+    std::vector<std::vector<double>> ys(Rows * Columns * Lines, std::vector<double>(Points));
+    for (int i = 0; i < Points; i++)
+    {
+        xs[i] = i * 10.0 / Points;
+        for (size_t l = 0; l < ys.size(); l++)
+            ys[l][i] = sin(xs[i] * (l + 1) * 0.3);
+    }
+
+    // malloc: счётчики сбрасываются перед каждым кадром
+    Totals malloc_warmup = {}, malloc_steady = {};
+    {
+        MallocCounter counter = {};
+        ImGui::SetAllocatorFunctions(CountingAlloc, CountingFree, &counter);
+        CreateContexts();
+        for (int frame = 0; frame < Warmup + frames; frame++)
+        {
+            counter = MallocCounter();
+            const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            Frame(frame, xs, ys);
+            const double us = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() * 1e6;
+            Totals &totals = frame < Warmup ? malloc_warmup : malloc_steady;
+            totals.allocs += counter.allocs;
+            totals.mallocs += counter.allocs;
+            totals.bytes += counter.bytes;
+            totals.frame_us += us;
+            if (frame >= Warmup)
+                totals.checksum = Checksum(totals.checksum);
+        }
+        DestroyContexts();
+    }
+
+    // FrameAllocator: статистика кадра закрывается в NewFrame(), как в главном цикле приложения
+    Totals pool_warmup = {}, pool_steady = {};
+    {
+        FrameAllocator allocator;
+        allocator.Install();
+        CreateContexts();
+        for (int frame = 0; frame <= Warmup + frames; frame++)
+        {
+            allocator.NewFrame();
+            if (frame > 0)
+            {
+                const FrameAllocator::Stats &stats = allocator.LastFrame();
+                Totals &totals = frame - 1 < Warmup ? pool_warmup : pool_steady;
+                totals.allocs += stats.Allocs;
+                totals.mallocs += stats.SystemAllocs;
+                totals.bytes += stats.Bytes;
+            }
+            if (frame == Warmup + frames)
+                break;
+            const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            Frame(frame, xs, ys);
+            const double us = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() * 1e6;
+            Totals &totals = frame < Warmup ? pool_warmup : pool_steady;
+            totals.frame_us += us;
+            if (frame >= Warmup)
+                totals.checksum = Checksum(totals.checksum);
+        }
+        DestroyContexts();
+    }
+
+    printf("%d plots x %d lines + %dx%d table\n", Rows * Columns, Lines, TableRows, TableColumns);
+    Print("malloc", malloc_warmup, malloc_steady, frames);
+    Print("FrameAllocator", pool_warmup, pool_steady, frames);
+    if (malloc_steady.checksum != pool_steady.checksum)
+    {
+        printf("frames differ between the allocators\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,141 @@
+// ChannelPublisher -> несколько ChannelReader: пропускная способность, задержка, потери.
+// channel_reader_bench [читатели] [блоки] [пауза после блока, мкс]
+// Читатели в отдельных потоках, каждый со своим отображением кольца, как в другом процессе.
+#include <ChannelPublisher.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+static const char *RingName = "sept_channel_reader_bench";
+static const int Channels = 8;
+
+static float Sample(uint64_t row, int channel)
+{
+    return (float)(row % 1000 + channel);
+}
+
+struct ReaderStats
+{
+    bool opened = false;
+    uint64_t blocks = 0;
+    uint64_t rows = 0;
+    uint64_t lost = 0;
+    uint64_t corrupt = 0;
+    double seconds = 0;
+    std::vector<double> latency_us;
+};
+
+static void ReadAll(uint64_t total_rows, std::atomic<int> *ready, const std::atomic<bool> *writer_done, ReaderStats *stats)
+{
+    ChannelReader reader;
+    stats->opened = reader.Open(RingName);
+    ready->fetch_add(1);
+    if (!stats->opened)
+        return;
+    stats->latency_us.reserve(1 << 20);
+    const uint64_t start = ChannelShm::Now();
+    for (;;)
+    {
+        const ChannelShm::Slot *slot = reader.Next();
+        if (!slot)
+        {
+            if (writer_done->load(std::memory_order_acquire) && !reader.Next())
+                break;
+            std::this_thread::yield();
+            continue;
+        }
+        const uint64_t now = ChannelShm::Now();
+        const uint64_t first = slot->FirstRow;
+        const uint32_t rows = slot->Rows;
+        bool ok = true;
+        for (int c = 0; c < reader.Channels(); c++)
+        {
+            const float *values = reader.Values(slot, c);
+            for (uint32_t i = 0; i < rows; i++)
+                ok = ok && values[i] == Sample(first + i, c);
+        }
+        const uint64_t published = slot->PublishNs;
+        if (reader.Release(slot))
+        {
+            stats->blocks++;
+            stats->rows += rows;
+            stats->corrupt += ok ? 0 : 1;
+            if (stats->latency_us.size() < stats->latency_us.capacity())
+                stats->latency_us.push_back((now - published) * 1e-3);
+        }
+        if (first + rows >= total_rows)
+            break;
+    }
+    stats->seconds = (ChannelShm::Now() - start) * 1e-9;
+    stats->lost = reader.Lost();
+}
+
+int main(int argc, char **argv)
+{
+    const int readers = argc > 1 ? atoi(argv[1]) : 4;
+    const uint64_t blocks = argc > 2 ? strtoull(argv[2], nullptr, 10) : 100000;
+    const int pause_us = argc > 3 ? atoi(argv[3]) : 0;
+    const uint64_t total_rows = blocks * ChannelShm::BlockRows;
+
+    ChannelPublisher publisher;
+    if (!publisher.Open(RingName))
+    {
+        printf("cannot create the ring %s\n", RingName);
+        return 1;
+    }
+    std::vector<std::string> names;
+    for (int c = 0; c < Channels; c++)
+        names.push_back("ch" + std::to_string(c));
+    publisher.SetChannels(names);
+
+    std::atomic<int> ready(0);
+    std::atomic<bool> writer_done(false);
+    std::vector<ReaderStats> stats(readers);
+    std::vector<std::thread> threads;
+    for (int r = 0; r < readers; r++)
+        threads.emplace_back(ReadAll, total_rows, &ready, &writer_done, &stats[r]);
+    while (ready.load() < readers)
+        std::this_thread::yield();
+
+    float row[Channels];
+    const uint64_t start = ChannelShm::Now();
+    for (uint64_t r = 0; r < total_rows; r++)
+    {
+        for (int c = 0; c < Channels; c++)
+            row[c] = Sample(r, c);
+        publisher.Append(r, row);
+        if (pause_us > 0 && (r + 1) % ChannelShm::BlockRows == 0)
+            std::this_thread::sleep_for(std::chrono::microseconds(pause_us));
+    }
+    const double seconds = (ChannelShm::Now() - start) * 1e-9;
+    writer_done.store(true, std::memory_order_release);
+    for (std::thread &t : threads)
+        t.join();
+    publisher.Close();
+
+    printf("writer: %llu blocks of %d rows x %d channels in %.2f s, %.1f M rows/s\n",
+           (unsigned long long)blocks, (int)ChannelShm::BlockRows, Channels, seconds, total_rows / seconds * 1e-6);
+    int failed = 0;
+    for (int r = 0; r < readers; r++)
+    {
+        ReaderStats &s = stats[r];
+        if (!s.opened)
+        {
+            printf("reader %d: cannot open the ring\n", r);
+            failed++;
+            continue;
+        }
+        std::sort(s.latency_us.begin(), s.latency_us.end());
+        const size_t n = s.latency_us.size();
+        printf("reader %d: %llu blocks, %.1f M rows/s (%.0f MB/s), lost %llu, corrupt %llu, latency p50 %.1f us p99 %.1f us max %.1f us\n",
+               r, (unsigned long long)s.blocks, s.rows / s.seconds * 1e-6, s.rows * Channels * 4.0 / s.seconds * 1e-6,
+               (unsigned long long)s.lost, (unsigned long long)s.corrupt,
+               n ? s.latency_us[n / 2] : 0.0, n ? s.latency_us[n * 99 / 100] : 0.0, n ? s.latency_us[n - 1] : 0.0);
+        failed += s.corrupt > 0;
+    }
+    return failed == 0 ? 0 : 1;
+}
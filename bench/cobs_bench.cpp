@@ -0,0 +1,206 @@
+// SLIP против COBS: кодирование и разбор потока кадров, МБ/с данных и байт на линии на кадр.
+// cobs_bench [МБ данных] [байт в кадре]
+// Данные: случайные, все 0xC0 (худший случай SLIP) и все нули (худший случай COBS).
+// Разобранные кадры сверяются с исходными.
+#include <Cobs.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+enum
+{
+    END = 0xC0,
+    ESC = 0xDB,
+    ESC_END = 0xDC,
+    ESC_ESC = 0xDD
+};
+
+struct slip
+{
+    unsigned char *buf;
+    size_t size;
+    size_t len;
+    int mode;
+    unsigned char prev;
+    int overflow;
+    unsigned long overflows;
+};
+
+// Тот же разбор, что в src/main.cpp
+static size_t slip_recv(unsigned char c, struct slip *slip)
+{
+    size_t res = 0;
+    if (slip->mode)
+    {
+        if (slip->prev == ESC && c == ESC_END)
+        {
+            slip->buf[slip->len++] = END;
+        }
+        else if (slip->prev == ESC && c == ESC_ESC)
+        {
+            slip->buf[slip->len++] = ESC;
+        }
+        else if (c == END)
+        {
+            res = slip->overflow ? 0 : slip->len;
+            slip->overflows += slip->overflow;
+        }
+        else if (c != ESC)
+        {
+            slip->buf[slip->len++] = c;
+        }
+        if (slip->len >= slip->size)
+            slip->len = 0, slip->overflow = 1;
+    }
+    slip->prev = c;
+    if (c == END)
+        slip->len = 0, slip->overflow = 0, slip->mode = !slip->mode;
+    return res;
+}
+
+// Как SendFrame в src/main.cpp: END, данные с заменой END и ESC, END
+static size_t EncodeSlip(const unsigned char *p, size_t len, unsigned char *out)
+{
+    unsigned char *o = out;
+    *o++ = END;
+    for (size_t i = 0; i < len; i++)
+    {
+        if (p[i] == END)
+        {
+            *o++ = ESC;
+            *o++ = ESC_END;
+        }
+        else if (p[i] == ESC)
+        {
+            *o++ = ESC;
+            *o++ = ESC_ESC;
+        }
+        else
+        {
+            *o++ = p[i];
+        }
+    }
+    *o++ = END;
+    return o - out;
+}
+
+static size_t EncodeCobs(const unsigned char *p, size_t len, unsigned char *out)
+{
+    const size_t size = Cobs::Encode(p, len, out);
+    out[size] = 0;
+    return size + 1;
+}
+
+// Как DecodeSlip в src/main.cpp: по байту, кадры подряд в out
+static size_t DecodeSlip(const std::vector<unsigned char> &wire, unsigned char *out, size_t out_size, size_t *frames)
+{
+    struct slip slip = {0};
+    slip.buf = out;
+    slip.size = out_size;
+    size_t used = 0;
+    for (unsigned char c : wire)
+    {
+        const size_t len = slip_recv(c, &slip);
+        if (len > 0)
+        {
+            used += len;
+            (*frames)++;
+            slip.buf = out + used;
+            slip.size = out_size - used;
+        }
+    }
+    return used;
+}
+
+// Как DecodeCobs в src/main.cpp: границы memchr, блоки Cobs::Decode
+static size_t DecodeCobs(const std::vector<unsigned char> &wire, unsigned char *out, size_t *frames)
+{
+    const unsigned char *p = wire.data();
+    const unsigned char *end = p + wire.size();
+    size_t used = 0;
+    while (p < end)
+    {
+        const unsigned char *zero = (const unsigned char *)memchr(p, 0, end - p);
+        size_t len = 0;
+        if (zero - p > 0 && Cobs::Decode(p, zero - p, out + used, &len))
+        {
+            used += len;
+            (*frames)++;
+        }
+        p = zero + 1;
+    }
+    return used;
+}
+
+template <typename F>
+static double BestSeconds(int repeats, F f)
+{
+    double best = 1e9;
+    for (int r = 0; r < repeats; r++)
+    {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        f();
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+
+int main(int argc, char **argv)
+{
+    const size_t size = (argc > 1 ? (size_t)atoi(argv[1]) : 16) << 20;
+    const size_t payload = argc > 2 ? (size_t)atoi(argv[2]) : 32;
+    const size_t frames = size / payload;
+
+    struct Pattern
+    {
+        const char *name;
+        std::vector<unsigned char> data;
+    } patterns[] = {{"random", {}}, {"all 0xC0", {}}, {"all zero", {}}};
+    std::mt19937 rng(1);
+    patterns[0].data.resize(frames * payload);
+    for (unsigned char &c : patterns[0].data)
+        c = (unsigned char)rng();
+    patterns[1].data.assign(frames * payload, END);
+    patterns[2].data.assign(frames * payload, 0);
+
+    const size_t wire_capacity = frames * std::max(2 * payload + 2, Cobs::MaxEncodedSize(payload) + 1);
+    std::vector<unsigned char> wire(wire_capacity), decoded(frames * payload + 1); // SLIP: кадр должен быть короче буфера
+    int failures = 0;
+    printf("%zu frames of %zu bytes\n", frames, payload);
+    for (const Pattern &pattern : patterns)
+    {
+        for (int cobs = 0; cobs < 2; cobs++)
+        {
+            size_t wire_size = 0;
+            const double encode_seconds = BestSeconds(3, [&] {
+                wire_size = 0;
+                for (size_t f = 0; f < frames; f++)
+                {
+                    const unsigned char *p = pattern.data.data() + f * payload;
+                    wire_size += cobs ? EncodeCobs(p, payload, wire.data() + wire_size)
+                                      : EncodeSlip(p, payload, wire.data() + wire_size);
+                }
+            });
+            const std::vector<unsigned char> stream(wire.begin(), wire.begin() + wire_size);
+
+            size_t used = 0, decoded_frames = 0;
+            const double decode_seconds = BestSeconds(3, [&] {
+                decoded_frames = 0;
+                used = cobs ? DecodeCobs(stream, decoded.data(), &decoded_frames)
+                            : DecodeSlip(stream, decoded.data(), decoded.size(), &decoded_frames);
+            });
+            const bool ok = decoded_frames == frames && used == pattern.data.size() &&
+                            memcmp(decoded.data(), pattern.data.data(), used) == 0;
+            printf("%-4s %-8s encode %5.0f MB/s, decode %5.0f MB/s, %.2f bytes/frame (x%.3f)%s\n",
+                   cobs ? "COBS" : "SLIP", pattern.name, pattern.data.size() / encode_seconds * 1e-6,
+                   pattern.data.size() / decode_seconds * 1e-6, (double)wire_size / frames,
+                   (double)wire_size / pattern.data.size(), ok ? "" : ", DECODED FRAMES DIFFER");
+            failures += !ok;
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,122 @@
+// FrameCheck: скорость CRC-16/CCITT и CRC-32C на длинном буфере и проверки кадров по 32 байта.
+// crc_bench [МБ данных]
+// Результаты сверяются с побитовым расчётом; цель - не меньше 10 МБ/с на ядро.
+#include <FrameCheck.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+static const double TargetBytesPerSecond = 10e6;
+
+static ImU16 BitwiseCrc16(const unsigned char *p, size_t n)
+{
+    ImU16 crc = 0xFFFF;
+    while (n--)
+    {
+        crc ^= (ImU16)(*p++ << 8);
+        for (int b = 0; b < 8; b++)
+            crc = crc & 0x8000 ? (ImU16)((crc << 1) ^ 0x1021) : (ImU16)(crc << 1);
+    }
+    return crc;
+}
+
+static ImU32 BitwiseCrc32c(const unsigned char *p, size_t n)
+{
+    ImU32 crc = 0xFFFFFFFF;
+    while (n--)
+    {
+        crc ^= *p++;
+        for (int b = 0; b < 8; b++)
+            crc = crc & 1 ? (crc >> 1) ^ 0x82F63B78 : crc >> 1;
+    }
+    return ~crc;
+}
+
+template <typename F>
+static double BestSeconds(int repeats, F f)
+{
+    double best = 1e9;
+    for (int r = 0; r < repeats; r++)
+    {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        f();
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+
+int main(int argc, char **argv)
+{
+    const size_t size = (argc > 1 ? (size_t)atoi(argv[1]) : 16) << 20;
+    std::vector<unsigned char> data(size);
+    std::mt19937 rng(1);
+    for (unsigned char &c : data)
+        c = (unsigned char)rng();
+
+    int failures = 0;
+    if (FrameCheck::Crc16Ccitt("123456789", 9) != 0x29B1 || FrameCheck::Crc32c("123456789", 9) != 0xE3069283)
+    {
+        printf("check values differ\n");
+        failures++;
+    }
+    for (size_t n = 0; n < 300; n++)
+    {
+        const unsigned char *p = data.data() + n;
+        if (FrameCheck::Crc16Ccitt(p, n) != BitwiseCrc16(p, n) || FrameCheck::Crc32c(p, n) != BitwiseCrc32c(p, n))
+        {
+            printf("%zu bytes at offset %zu differ from the bitwise CRC\n", n, n);
+            failures++;
+        }
+    }
+
+    // Весь буфер одним вызовом
+    volatile ImU32 sink = 0;
+    double slowest = 1e18;
+    for (int t = FrameCheck::Type_Crc16; t < FrameCheck::Type_COUNT; t++)
+    {
+        const FrameCheck::Type type = (FrameCheck::Type)t;
+        const double seconds = BestSeconds(5, [&] {
+            sink = sink + (type == FrameCheck::Type_Crc16 ? FrameCheck::Crc16Ccitt(data.data(), size) : FrameCheck::Crc32c(data.data(), size));
+        });
+        printf("%-13s %zu MB: %.0f MB/s\n", FrameCheck::Name(type), size >> 20, size / seconds * 1e-6);
+        slowest = std::min(slowest, size / seconds);
+    }
+
+    // Кадры по 32 байта данных с хвостом, как их проверяет декодер
+    const size_t payload = 32;
+    for (int t = FrameCheck::Type_Crc16; t < FrameCheck::Type_COUNT; t++)
+    {
+        const FrameCheck::Type type = (FrameCheck::Type)t;
+        const size_t frame = payload + FrameCheck::TrailerSize(type);
+        const size_t frames = size / frame;
+        for (size_t i = 0; i < frames; i++)
+            FrameCheck::Trailer(type, data.data() + i * frame, payload, data.data() + i * frame + payload);
+        size_t good = 0;
+        const double seconds = BestSeconds(3, [&] {
+            good = 0;
+            for (size_t i = 0; i < frames; i++)
+            {
+                size_t n = frame;
+                good += FrameCheck::Verify(type, data.data() + i * frame, &n);
+            }
+        });
+        printf("%-13s verify %zu-byte frames: %.0f MB/s, %.1f M frames/s\n", FrameCheck::Name(type), frame,
+               frames * frame / seconds * 1e-6, frames / seconds * 1e-6);
+        if (good != frames)
+        {
+            printf("%zu of %zu frames failed the check\n", frames - good, frames);
+            failures++;
+        }
+        slowest = std::min(slowest, frames * frame / seconds);
+    }
+
+    if (slowest < TargetBytesPerSecond)
+    {
+        printf("below %.0f MB/s\n", TargetBytesPerSecond * 1e-6);
+        failures++;
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,83 @@
+// CsvExport: строки/с и МБ/с против fprintf("%.9g") в одном потоке, с проверкой чтением файла обратно.
+// csv_export_bench [строк] [потоки пула, 0 - по числу ядер] [файл]
+#include <CsvExport.h>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+static const int Columns = 8;
+
+int main(int argc, char **argv)
+{
+    const size_t rows = argc > 1 ? (size_t)atoi(argv[1]) : 2000000;
+    const unsigned threads = argc > 2 ? (unsigned)atoi(argv[2]) : 0;
+    const std::string filename = argc > 3 ? argv[3] : "csv_export_bench.csv";
+
+    // Время и синусы разной частоты, один пропуск (NaN - пустое поле)
+    std::vector<std::string> names;
+    std::vector<std::vector<float>> columns(Columns, std::vector<float>(rows));
+    for (int c = 0; c < Columns; c++)
+    {
+        names.push_back(c == 0 ? "time" : "ch" + std::to_string(c));
+        for (size_t r = 0; r < rows; r++)
+            columns[c][r] = c == 0 ? r * 0.001f : sinf(r * 0.01f * (c + 1)) * 100.0f;
+    }
+    if (rows > 5)
+        columns[3][5] = NAN;
+
+    CsvExport exporter(threads);
+    if (!exporter.Start(filename.c_str(), names, columns))
+        return 1;
+    while (exporter.Busy())
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    const CsvExport::Result result = exporter.GetResult();
+    if (result.Failed)
+    {
+        printf("cannot write %s\n", filename.c_str());
+        return 1;
+    }
+    printf("CsvExport: %llu rows, %.1f MB in %.3f s = %.2f M rows/s, %.0f MB/s\n", (unsigned long long)result.Rows,
+           result.Bytes * 1e-6, result.Seconds, result.Rows / result.Seconds * 1e-6, result.Bytes / result.Seconds * 1e-6);
+
+    // Обратно: каждое значение читается тем же float
+    size_t mismatches = 0;
+    FILE *f = fopen(filename.c_str(), "rb");
+    char line[512];
+    if (!f || !fgets(line, sizeof(line), f))
+        mismatches = rows;
+    for (size_t r = 0; f && r < rows && fgets(line, sizeof(line), f); r++)
+    {
+        char *p = line;
+        for (int c = 0; c < Columns; c++)
+        {
+            float v = NAN;
+            if (*p != ',' && *p != '\n')
+                v = strtof(p, &p);
+            const float expected = columns[c][r];
+            mismatches += !(v == expected || (v != v && expected != expected));
+            p++;
+        }
+    }
+    if (f)
+        fclose(f);
+
+    // Для сравнения: fprintf с точностью, достаточной для обратного чтения
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    f = fopen(filename.c_str(), "wb");
+    for (size_t r = 0; f && r < rows; r++)
+        for (int c = 0; c < Columns; c++)
+            fprintf(f, "%.9g%c", columns[c][r], c + 1 == Columns ? '\n' : ',');
+    if (f)
+        fclose(f);
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printf("fprintf %%.9g: %.3f s = %.2f M rows/s, x%.1f slower\n", seconds, rows / seconds * 1e-6, seconds / result.Seconds);
+    remove(filename.c_str());
+
+    if (mismatches != 0)
+        printf("%zu values read back differ\n", mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
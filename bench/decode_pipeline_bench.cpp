@@ -0,0 +1,204 @@
+// DecodePipeline: 8 портов по 3 Мбод, потоки приёма отдают данные так быстро, как может пул.
+// decode_pipeline_bench [потоки пула, 0 - по числу ядер] [кадров на порт]
+// Проверяется порядок кадров каждого порта (номер кадра в первых 4 байтах) и что пул
+// успевает за 8 x 300 000 байт/с.
+#include <DecodePipeline.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+enum
+{
+    END = 0xC0,
+    ESC = 0xDB,
+    ESC_END = 0xDC,
+    ESC_ESC = 0xDD
+};
+
+static const int Ports = 8;
+static const double PortBytesPerSecond = 3000000 / 10.0; // 8N1
+
+struct slip
+{
+    unsigned char *buf;
+    size_t size;
+    size_t len;
+    int mode;
+    unsigned char prev;
+    int overflow;
+    unsigned long overflows;
+};
+
+// Тот же разбор, что в src/main.cpp
+static size_t slip_recv(unsigned char c, struct slip *slip)
+{
+    size_t res = 0;
+    if (slip->mode)
+    {
+        if (slip->prev == ESC && c == ESC_END)
+        {
+            slip->buf[slip->len++] = END;
+        }
+        else if (slip->prev == ESC && c == ESC_ESC)
+        {
+            slip->buf[slip->len++] = ESC;
+        }
+        else if (c == END)
+        {
+            res = slip->overflow ? 0 : slip->len;
+            slip->overflows += slip->overflow;
+        }
+        else if (c != ESC)
+        {
+            slip->buf[slip->len++] = c;
+        }
+        if (slip->len >= slip->size)
+            slip->len = 0, slip->overflow = 1;
+    }
+    slip->prev = c;
+    if (c == END)
+        slip->len = 0, slip->overflow = 0, slip->mode = !slip->mode;
+    return res;
+}
+
+static void DecodeSlip(DecodePipeline::Batch &batch, void *)
+{
+    batch.Data.resize(batch.Raw.size());
+    struct slip slip = {};
+    slip.mode = batch.Truncated;
+    slip.buf = batch.Data.data();
+    slip.size = batch.Data.size();
+    size_t used = 0;
+    for (unsigned char c : batch.Raw)
+    {
+        const size_t len = slip_recv(c, &slip);
+        if (len > 0)
+        {
+            batch.Frames.push_back({(ImU32)used, (ImU32)len, 0});
+            used += len;
+            slip.buf = batch.Data.data() + used;
+            slip.size = batch.Data.size() - used;
+        }
+    }
+    batch.Data.resize(used);
+}
+
+struct PortCheck
+{
+    ImU32 next = 0;
+    ImU64 frames = 0;
+    bool out_of_order = false;
+};
+
+static void Deliver(const DecodePipeline::Batch &batch, void *user_data)
+{
+    PortCheck &check = *static_cast<PortCheck *>(user_data);
+    for (const DecodePipeline::Frame &frame : batch.Frames)
+    {
+        ImU32 number;
+        memcpy(&number, batch.Data.data() + frame.Offset, sizeof(number));
+        if (number != check.next && !check.out_of_order)
+        {
+            printf("port %d: frame %u after %u\n", batch.Stream, number, check.next - 1);
+            check.out_of_order = true;
+        }
+        check.next = number + 1;
+        check.frames++;
+    }
+}
+
+// Кадры 8..47 байт с номером в начале, между ними иногда текст вне кадров, как лог прошивки
+static std::vector<unsigned char> MakeWire(int port, ImU32 frames)
+{
+    std::mt19937 rng(port);
+    std::vector<unsigned char> wire;
+    for (ImU32 i = 0; i < frames; i++)
+    {
+        unsigned char payload[48];
+        const int len = 8 + rng() % 40;
+        memcpy(payload, &i, sizeof(i));
+        for (int k = 4; k < len; k++)
+            payload[k] = (unsigned char)rng();
+        if (i % 7 == 0)
+            wire.insert(wire.end(), {'l', 'o', 'g', '\n'});
+        wire.push_back(END);
+        for (int k = 0; k < len; k++)
+        {
+            if (payload[k] == END)
+                wire.insert(wire.end(), {ESC, ESC_END});
+            else if (payload[k] == ESC)
+                wire.insert(wire.end(), {ESC, ESC_ESC});
+            else
+                wire.push_back(payload[k]);
+        }
+        wire.push_back(END);
+    }
+    return wire;
+}
+
+int main(int argc, char **argv)
+{
+    const unsigned threads = argc > 1 ? (unsigned)atoi(argv[1]) : 0;
+    const ImU32 frames = argc > 2 ? (ImU32)atoi(argv[2]) : 200000;
+
+    std::vector<std::vector<unsigned char>> wire(Ports);
+    size_t total = 0;
+    for (int p = 0; p < Ports; p++)
+    {
+        wire[p] = MakeWire(p, frames);
+        total += wire[p].size();
+    }
+
+    PortCheck checks[Ports];
+    DecodePipeline::Stats stats;
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    {
+        DecodePipeline pipeline(threads);
+        int streams[Ports];
+        for (int p = 0; p < Ports; p++)
+            streams[p] = pipeline.AddStream({END, true}, DecodeSlip, Deliver, &checks[p]);
+
+        // Чтения разной длины, как их отдаёт драйвер порта
+        std::vector<std::thread> readers;
+        for (int p = 0; p < Ports; p++)
+            readers.emplace_back([&, p] {
+                std::mt19937 rng(100 + p);
+                const std::vector<unsigned char> &w = wire[p];
+                for (size_t pos = 0; pos < w.size();)
+                {
+                    const size_t n = std::min(w.size() - pos, (size_t)(1 + rng() % 512));
+                    pipeline.Push(streams[p], w.data() + pos, n, 0);
+                    pos += n;
+                }
+            });
+        for (std::thread &t : readers)
+            t.join();
+        while (pipeline.GetStats().Frames < (ImU64)frames * Ports)
+            std::this_thread::yield();
+        stats = pipeline.GetStats();
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    bool ok = true;
+    for (int p = 0; p < Ports; p++)
+    {
+        if (checks[p].frames != frames)
+            printf("port %d: %llu frames of %u\n", p, (unsigned long long)checks[p].frames, frames);
+        ok = ok && !checks[p].out_of_order && checks[p].frames == frames;
+    }
+    const double rate = total / seconds;
+    const double needed = Ports * PortBytesPerSecond;
+    printf("workers %d, batches %llu, frames %llu, stalls %llu, steals %llu, reordered %llu, max queued %d\n",
+           stats.Workers, (unsigned long long)stats.Batches, (unsigned long long)stats.Frames,
+           (unsigned long long)stats.Stalls, (unsigned long long)stats.Steals, (unsigned long long)stats.Reordered,
+           stats.MaxQueued);
+    printf("%.1f MB in %.3f s = %.1f MB/s, %.1fx of %d ports at 3 Mbaud (%.1f MB/s)%s\n",
+           total * 1e-6, seconds, rate * 1e-6, rate / needed, Ports, needed * 1e-6,
+           ok ? ", order kept" : ", ORDER BROKEN");
+    return ok && rate >= needed ? 0 : 1;
+}
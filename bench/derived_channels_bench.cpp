@@ -0,0 +1,211 @@
+// DerivedChannels против наивного интерпретатора, который обходит дерево выражения на каждом отсчёте.
+// derived_channels_bench [строк]
+// Оба разбирают одни и те же выражения; результаты сверяются.
+#include <DerivedChannels.h>
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+static const char *Sources[] = {"ax", "ay", "az", "raw", "offset"};
+static const int SourceCount = sizeof(Sources) / sizeof(Sources[0]);
+
+// Наивный интерпретатор: + - * / унарный минус, скобки, sqrt, имена источников и числа
+struct Node
+{
+    char op; // 'k' число, 'c' канал, 'n' минус, 's' sqrt, иначе бинарная операция
+    float value;
+    int channel;
+    std::unique_ptr<Node> a, b;
+};
+
+struct TreeParser
+{
+    const char *p;
+
+    void SkipSpace()
+    {
+        while (*p == ' ')
+            p++;
+    }
+
+    std::unique_ptr<Node> Make(char op, std::unique_ptr<Node> a = nullptr, std::unique_ptr<Node> b = nullptr)
+    {
+        std::unique_ptr<Node> node(new Node());
+        node->op = op;
+        node->a = std::move(a);
+        node->b = std::move(b);
+        return node;
+    }
+
+    std::unique_ptr<Node> Primary()
+    {
+        SkipSpace();
+        if (*p == '(')
+        {
+            p++;
+            std::unique_ptr<Node> node = Sum();
+            SkipSpace();
+            p++; // ')'
+            return node;
+        }
+        if (*p == '-')
+        {
+            p++;
+            return Make('n', Primary());
+        }
+        if (strncmp(p, "sqrt(", 5) == 0)
+        {
+            p += 4;
+            return Make('s', Primary());
+        }
+        std::unique_ptr<Node> node = Make('k');
+        char *end;
+        node->value = strtof(p, &end);
+        if (end != p)
+        {
+            p = end;
+            return node;
+        }
+        node->op = 'c';
+        for (int c = 0; c < SourceCount; c++)
+        {
+            const size_t n = strlen(Sources[c]);
+            if (strncmp(p, Sources[c], n) == 0 && !isalnum((unsigned char)p[n]))
+            {
+                node->channel = c;
+                p += n;
+            }
+        }
+        return node;
+    }
+
+    std::unique_ptr<Node> Product()
+    {
+        std::unique_ptr<Node> node = Primary();
+        for (SkipSpace(); *p == '*' || *p == '/'; SkipSpace())
+        {
+            const char op = *p++;
+            node = Make(op, std::move(node), Primary());
+        }
+        return node;
+    }
+
+    std::unique_ptr<Node> Sum()
+    {
+        std::unique_ptr<Node> node = Product();
+        for (SkipSpace(); *p == '+' || *p == '-'; SkipSpace())
+        {
+            const char op = *p++;
+            node = Make(op, std::move(node), Product());
+        }
+        return node;
+    }
+};
+
+static float Evaluate(const Node *node, const float *row)
+{
+    switch (node->op)
+    {
+    case 'k':
+        return node->value;
+    case 'c':
+        return row[node->channel];
+    case 'n':
+        return -Evaluate(node->a.get(), row);
+    case 's':
+        return sqrtf(Evaluate(node->a.get(), row));
+    case '+':
+        return Evaluate(node->a.get(), row) + Evaluate(node->b.get(), row);
+    case '-':
+        return Evaluate(node->a.get(), row) - Evaluate(node->b.get(), row);
+    case '*':
+        return Evaluate(node->a.get(), row) * Evaluate(node->b.get(), row);
+    default:
+        return Evaluate(node->a.get(), row) / Evaluate(node->b.get(), row);
+    }
+}
+
+static double Seconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char **argv)
+{
+    const size_t rows = argc > 1 ? (size_t)atoi(argv[1]) : 2000000;
+    const char *expressions[] = {
+        "(raw - offset) * 0.01",
+        "sqrt(ax*ax + ay*ay + az*az)",
+        "sqrt((ax - 0.1)*(ax - 0.1) + (ay + 0.2)*(ay + 0.2)) / (raw - offset + 5) * -2",
+    };
+
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> uniform(-2.0f, 2.0f);
+    std::vector<float> samples(rows * SourceCount);
+    for (float &v : samples)
+        v = uniform(rng);
+
+    DerivedChannels channels(rows);
+    for (const char *name : Sources)
+        channels.AddSource(name);
+    for (size_t r = 0; r < rows; r++)
+        channels.Append(&samples[r * SourceCount]);
+
+    int failures = 0;
+    std::vector<float> naive(rows);
+    for (const char *expression : expressions)
+    {
+        std::string error;
+        if (!channels.Define("x", expression, &error))
+        {
+            printf("%s: %s\n", expression, error.c_str());
+            failures++;
+            continue;
+        }
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        channels.Update(); // переопределённый канал считается заново целиком
+        const double block_seconds = Seconds(start);
+
+        TreeParser parser = {expression};
+        const std::unique_ptr<Node> tree = parser.Sum();
+        start = std::chrono::steady_clock::now();
+        for (size_t r = 0; r < rows; r++)
+            naive[r] = Evaluate(tree.get(), &samples[r * SourceCount]);
+        const double naive_seconds = Seconds(start);
+
+        const float *values = channels.Values(channels.Find("x"));
+        double max_error = 0;
+        for (size_t r = 0; r < rows; r++)
+            max_error = std::max(max_error, (double)fabsf(values[r] - naive[r]) / std::max(1.0f, fabsf(naive[r])));
+        printf("%s\n    blocks %.0f M samples/s, per sample %.0f M samples/s, x%.1f, max relative error %g\n", expression,
+               rows / block_seconds * 1e-6, rows / naive_seconds * 1e-6, naive_seconds / block_seconds, max_error);
+        if (!(max_error < 1e-5))
+            failures++;
+    }
+
+    // Живой поток: по 1000 строк, после каждой порции Update() считает только новые
+    const size_t batch = 1000, live = std::min(rows, (size_t)200000);
+    std::chrono::steady_clock::duration update(0);
+    for (size_t r = 0; r < live; r++)
+    {
+        channels.Append(&samples[r * SourceCount]);
+        if ((r + 1) % batch == 0)
+        {
+            const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            channels.Update();
+            update += std::chrono::steady_clock::now() - start;
+        }
+    }
+    const double update_seconds = std::chrono::duration<double>(update).count();
+    printf("appended %zu rows by %zu: Update() %.1f us per call, %.0f M samples/s\n", live, batch,
+           update_seconds / (live / batch) * 1e6, live / update_seconds * 1e-6);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,133 @@
+// FilterStage: отсчётов/с при разном порядке фильтров и децимации против скалярного каскада по каналу.
+// filter_stage_bench [строк] [каналов] [строк в порции]
+// Скалярный каскад - та же транспонированная форма II в float, канал за каналом; выходы сверяются.
+#include <FilterStage.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+static const double SampleRate = 1000.0;
+
+// Скалярно, по строкам: для каждой строки каждый канал проходит свой каскад
+struct ScalarCascade
+{
+    int channels = 0;
+    std::vector<int> counts;
+    std::vector<FilterStage::Biquad> sections; // MaxSections на канал
+    std::vector<float> s1, s2;
+
+    void Configure(int n, const FilterStage::Design *designs)
+    {
+        channels = n;
+        counts.assign(n, 0);
+        sections.assign(n * FilterStage::MaxSections, FilterStage::Biquad());
+        s1.assign(n * FilterStage::MaxSections, 0.0f);
+        s2.assign(n * FilterStage::MaxSections, 0.0f);
+        for (int c = 0; c < n; c++)
+            counts[c] = FilterStage::DesignBiquads(designs[c], SampleRate, &sections[c * FilterStage::MaxSections]);
+    }
+
+    void Process(float *data, int rows)
+    {
+        for (int row = 0; row < rows; row++)
+            for (int c = 0; c < channels; c++)
+            {
+                float x = data[row * channels + c];
+                for (int s = 0; s < counts[c]; s++)
+                {
+                    const int i = c * FilterStage::MaxSections + s;
+                    const FilterStage::Biquad &k = sections[i];
+                    const float y = (float)k.B0 * x + s1[i];
+                    s1[i] = (float)k.B1 * x - (float)k.A1 * y + s2[i];
+                    s2[i] = (float)k.B2 * x - (float)k.A2 * y;
+                    x = y;
+                }
+                data[row * channels + c] = x;
+            }
+    }
+};
+
+static double Seconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char **argv)
+{
+    const int rows = argc > 1 ? atoi(argv[1]) : 1000000;
+    const int channels = argc > 2 ? atoi(argv[2]) : 16;
+    const int block = argc > 3 ? atoi(argv[3]) : 1000;
+
+    std::vector<float> input((size_t)rows * channels);
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+    for (float &v : input)
+        v = noise(rng);
+
+    struct Case
+    {
+        FilterStage::Type kind;
+        int order;
+        int decimation;
+    } cases[] = {
+        {FilterStage::Type_Notch, 2, 1},
+        {FilterStage::Type_ButterworthLowPass, 4, 1},
+        {FilterStage::Type_ButterworthLowPass, 8, 1},
+        {FilterStage::Type_ChebyshevLowPass, 16, 1},
+        {FilterStage::Type_ButterworthLowPass, 4, 4},
+        {FilterStage::Type_ButterworthLowPass, 4, 16},
+    };
+    int failures = 0;
+    printf("%d rows x %d channels, blocks of %d rows\n", rows, channels, block);
+    for (const Case &test : cases)
+    {
+        std::vector<FilterStage::Design> designs(channels);
+        for (FilterStage::Design &design : designs)
+        {
+            design.Kind = test.kind;
+            design.Order = test.order;
+            design.Cutoff = 40.0;
+        }
+        FilterStage filter;
+        filter.Configure(channels, designs.data(), SampleRate, test.decimation);
+        std::vector<float> data = input;
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        size_t out_rows = 0;
+        for (int row = 0; row < rows; row += block)
+        {
+            float *p = data.data() + (size_t)row * channels;
+            out_rows += filter.Process(p, std::min(block, rows - row), p);
+        }
+        const double seconds = Seconds(start);
+
+        char name[96];
+        snprintf(name, sizeof(name), "%s, order %d, decimation %d", FilterStage::TypeName(test.kind), test.order, test.decimation);
+        if (test.decimation > 1)
+        {
+            printf("%-44s %6.1f M samples/s in, %zu rows out\n", name, (double)rows * channels / seconds * 1e-6, out_rows);
+            continue;
+        }
+
+        // Без децимации - сравнение со скалярным каскадом
+        ScalarCascade scalar;
+        scalar.Configure(channels, designs.data());
+        std::vector<float> reference = input;
+        const std::chrono::steady_clock::time_point scalar_start = std::chrono::steady_clock::now();
+        for (int row = 0; row < rows; row += block)
+            scalar.Process(reference.data() + (size_t)row * channels, std::min(block, rows - row));
+        const double scalar_seconds = Seconds(scalar_start);
+        double max_error = 0;
+        for (size_t i = 0; i < reference.size(); i++)
+            max_error = std::max(max_error, (double)fabsf(reference[i] - data[i]));
+        printf("%-44s %6.1f M samples/s, scalar %6.1f M samples/s, x%.1f, max difference %g\n", name,
+               (double)rows * channels / seconds * 1e-6, (double)rows * channels / scalar_seconds * 1e-6,
+               scalar_seconds / seconds, max_error);
+        if (!(max_error < 1e-3))
+            failures++;
+    }
+    return failures == 0 ? 0 : 1;
+}
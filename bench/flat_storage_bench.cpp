@@ -0,0 +1,98 @@
+// ImGuiStorage (отсортированный вектор) против ImGuiFlatStorage на 1k, 10k и 100k ключей:
+// вставка, поиск присутствующих и отсутствующих ключей, нс на операцию.
+// flat_storage_bench [поисков на замер]
+// Ключи - ImHashStr меток в случайном порядке, как ID окон, таблиц и графиков.
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+template <typename F>
+static double BestSeconds(int repeats, F f)
+{
+    double best = 1e9;
+    for (int r = 0; r < repeats; r++)
+    {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        f();
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+
+struct Result
+{
+    double insert_ns, hit_ns, miss_ns;
+    long long sum;
+};
+
+template <typename Storage>
+static Result Measure(const std::vector<ImGuiID> &keys, const std::vector<ImGuiID> &hits, const std::vector<ImGuiID> &misses)
+{
+    Result result;
+    Storage storage;
+    const double insert = BestSeconds(3, [&] {
+        storage.Clear();
+        for (size_t i = 0; i < keys.size(); i++)
+            storage.SetInt(keys[i], (int)i);
+    });
+    long long sum = 0;
+    const double hit = BestSeconds(3, [&] {
+        sum = 0;
+        for (ImGuiID key : hits)
+            sum += storage.GetInt(key, -1);
+    });
+    long long missing = 0;
+    const double miss = BestSeconds(3, [&] {
+        missing = 0;
+        for (ImGuiID key : misses)
+            missing += storage.GetInt(key, -1);
+    });
+    result.insert_ns = insert / keys.size() * 1e9;
+    result.hit_ns = hit / hits.size() * 1e9;
+    result.miss_ns = miss / misses.size() * 1e9;
+    result.sum = sum + missing;
+    return result;
+}
+
+int main(int argc, char **argv)
+{
+    const size_t lookups = argc > 1 ? (size_t)atoi(argv[1]) : 1000000;
+    std::mt19937 rng(34);
+    int failures = 0;
+    printf("%zu lookups per measure, ns per operation\n", lookups);
+    printf("keys    storage    insert/key      hit     miss\n");
+    for (int count : {1000, 10000, 100000})
+    {
+        std::vector<ImGuiID> keys, hits, misses;
+        char label[32];
+        for (int i = 0; i < count; i++)
+        {
+            snprintf(label, sizeof(label), "item%d", i);
+            keys.push_back(ImHashStr(label));
+        }
+        std::shuffle(keys.begin(), keys.end(), rng);
+        for (size_t i = 0; i < lookups; i++)
+        {
+            hits.push_back(keys[rng() % keys.size()]);
+            snprintf(label, sizeof(label), "missing%u", (unsigned)(rng() % (count * 4)));
+            misses.push_back(ImHashStr(label));
+        }
+
+        const Result sorted = Measure<ImGuiStorage>(keys, hits, misses);
+        const Result flat = Measure<ImGuiFlatStorage>(keys, hits, misses);
+        printf("%-7d sorted  %10.1f %8.1f %8.1f\n", count, sorted.insert_ns, sorted.hit_ns, sorted.miss_ns);
+        printf("        flat    %10.1f %8.1f %8.1f   x%.1f insert, x%.1f hit, x%.1f miss\n", flat.insert_ns, flat.hit_ns,
+               flat.miss_ns, sorted.insert_ns / flat.insert_ns, sorted.hit_ns / flat.hit_ns, sorted.miss_ns / flat.miss_ns);
+        if (sorted.sum != flat.sum)
+        {
+            printf("lookups return different values\n");
+            failures++;
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,106 @@
+// Запуск с атласом шрифтов: холодный (CreateContext, Build() и ImFontAtlasBuildSaveCache(), как при первом
+// запуске приложения) против тёплого (CreateContext и ImFontAtlasBuildLoadCache()), без окна и GPU.
+// Оба пути заканчиваются GetTexDataAsRGBA32(), как при создании текстуры бэкендом OpenGL3.
+// font_cache_bench [повторов] [шрифт.ttf ...]
+// Без файлов шрифтов - только шрифт по умолчанию. Атлас из кэша должен совпасть с построенным.
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <implot.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+static const char *CacheFile = "font_cache_bench.cache";
+
+struct Startup
+{
+    double seconds;
+    ImGuiID pixels;  // хеш текстуры Alpha8
+    ImGuiID glyphs;  // хеш таблиц глифов всех шрифтов
+    int width, height;
+    bool loaded;     // атлас взят из кэша
+};
+
+// Шрифт по умолчанию и каждый файл в трёх размерах с кириллицей, как подписи каналов в приложении
+static void AddFonts(ImFontAtlas *atlas, const std::vector<std::string> &files)
+{
+    atlas->AddFontDefault();
+    for (const std::string &file : files)
+        for (float size : {13.0f, 16.0f, 20.0f})
+            atlas->AddFontFromFileTTF(file.c_str(), size, nullptr, atlas->GetGlyphRangesCyrillic());
+}
+
+static Startup Start(const std::vector<std::string> &files, bool use_cache)
+{
+    Startup result;
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    ImGui::CreateContext();
+    ImPlot::CreateContext();
+    ImGuiIO &io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    AddFonts(io.Fonts, files);
+    result.loaded = use_cache && ImFontAtlasBuildLoadCache(io.Fonts, CacheFile);
+    if (!result.loaded)
+    {
+        io.Fonts->Build();
+        ImFontAtlasBuildSaveCache(io.Fonts, CacheFile);
+    }
+    unsigned char *pixels;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &result.width, &result.height);
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    result.pixels = ImHashData(io.Fonts->TexPixelsAlpha8, (size_t)result.width * result.height, 0);
+    result.glyphs = 0;
+    for (ImFont *font : io.Fonts->Fonts)
+        result.glyphs = ImHashData(font->Glyphs.Data, font->Glyphs.Size * sizeof(ImFontGlyph), result.glyphs);
+    ImPlot::DestroyContext();
+    ImGui::DestroyContext();
+    return result;
+}
+
+static double Median(std::vector<double> values)
+{
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+int main(int argc, char **argv)
+{
+    const int repeats = argc > 1 ? atoi(argv[1]) : 20;
+    std::vector<std::string> files;
+    for (int i = 2; i < argc; i++)
+        files.push_back(argv[i]);
+
+    int failures = 0;
+    std::vector<double> cold, warm;
+    Startup built = {}, loaded = {};
+    for (int r = 0; r < repeats; r++)
+    {
+        remove(CacheFile);
+        built = Start(files, false);
+        cold.push_back(built.seconds * 1e3);
+        loaded = Start(files, true);
+        warm.push_back(loaded.seconds * 1e3);
+        if (!loaded.loaded)
+        {
+            printf("the cache written by the cold start was not accepted\n");
+            failures++;
+            break;
+        }
+    }
+    remove(CacheFile);
+
+    printf("default font + %zu files x 3 sizes, atlas %dx%d, %d runs\n", files.size(), built.width, built.height, repeats);
+    printf("cold (Build + save cache): median %.2f ms, best %.2f ms\n", Median(cold), *std::min_element(cold.begin(), cold.end()));
+    printf("warm (load cache):         median %.2f ms, best %.2f ms, x%.1f\n", Median(warm), *std::min_element(warm.begin(), warm.end()),
+           Median(cold) / Median(warm));
+    if (built.pixels != loaded.pixels || built.glyphs != loaded.glyphs || built.width != loaded.width || built.height != loaded.height)
+    {
+        printf("the loaded atlas differs from the built one\n");
+        failures++;
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,137 @@
+// ImHashData/ImHashStr: МБ/с на буферах разной длины и нс на метку против прежнего цикла по байту.
+// hash_bench [МБ на замер]
+// hash_bench_tables - то же без crc32 (IMGUI_DISABLE_CRC32_DISPATCH), только таблицы.
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+// Прежняя реализация Dear ImGui 1.91.7: таблица, один байт за шаг
+static ImU32 OldTable[256];
+
+static ImGuiID OldHashData(const void *data_p, size_t data_size, ImGuiID seed)
+{
+    ImU32 crc = ~seed;
+    const unsigned char *data = (const unsigned char *)data_p;
+    while (data_size-- != 0)
+        crc = (crc >> 8) ^ OldTable[(crc & 0xFF) ^ *data++];
+    return ~crc;
+}
+
+static ImGuiID OldHashStr(const char *data_p, ImGuiID seed)
+{
+    seed = ~seed;
+    ImU32 crc = seed;
+    const unsigned char *data = (const unsigned char *)data_p;
+    while (unsigned char c = *data++)
+    {
+        if (c == '#' && data[0] == '#' && data[1] == '#')
+            crc = seed;
+        crc = (crc >> 8) ^ OldTable[(crc & 0xFF) ^ c];
+    }
+    return ~crc;
+}
+
+template <typename F>
+static double BestSeconds(int repeats, F f)
+{
+    double best = 1e9;
+    for (int r = 0; r < repeats; r++)
+    {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        f();
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+
+int main(int argc, char **argv)
+{
+    const size_t total = (argc > 1 ? (size_t)atoi(argv[1]) : 64) << 20;
+    for (ImU32 i = 0; i < 256; i++)
+    {
+        ImU32 crc = i;
+        for (int b = 0; b < 8; b++)
+            crc = crc & 1 ? (crc >> 1) ^ 0x82F63B78 : crc >> 1;
+        OldTable[i] = crc;
+    }
+
+    int failures = 0;
+    volatile ImGuiID sink = 0;
+    std::vector<unsigned char> data(1 << 20);
+    std::mt19937 rng(9);
+    for (unsigned char &c : data)
+        c = (unsigned char)rng();
+
+    // Буферы одной длины подряд, всего `total` байт
+    const size_t sizes[] = {4, 8, 16, 64, 1024, 1 << 20};
+    for (size_t size : sizes)
+    {
+        const size_t count = total / size;
+        const size_t span = data.size() - size + 1;
+        ImGuiID now = 0, old = 0;
+        const double seconds = BestSeconds(3, [&] {
+            now = 0;
+            for (size_t i = 0; i < count; i++)
+                now += ImHashData(data.data() + (i * 8) % span, size, (ImGuiID)i);
+        });
+        const double old_seconds = BestSeconds(3, [&] {
+            old = 0;
+            for (size_t i = 0; i < count; i++)
+                old += OldHashData(data.data() + (i * 8) % span, size, (ImGuiID)i);
+        });
+        sink = sink + now;
+        printf("ImHashData %7zu bytes: %6.0f MB/s %6.1f ns/call, old %6.0f MB/s %6.1f ns/call, x%.1f\n", size,
+               count * size / seconds * 1e-6, seconds / count * 1e9, count * size / old_seconds * 1e-6,
+               old_seconds / count * 1e9, old_seconds / seconds);
+        if (now != old)
+        {
+            printf("ImHashData differs from the old implementation\n");
+            failures++;
+        }
+    }
+
+    // Метки, как их хеширует приложение каждый кадр
+    std::vector<std::string> labels;
+    char label[64];
+    for (int i = 0; i < 64; i++)
+    {
+        snprintf(label, sizeof(label), "ch%d", i);
+        labels.push_back(label);
+        snprintf(label, sizeof(label), "Plot %d##plot%d", i % 16, i);
+        labels.push_back(label);
+        snprintf(label, sizeof(label), "##row%d", i);
+        labels.push_back(label);
+        snprintf(label, sizeof(label), "Temperature sensor %d, deg C###channel%d", i, i);
+        labels.push_back(label);
+    }
+    const size_t rounds = total / 2048;
+    ImGuiID now = 0, old = 0;
+    const double seconds = BestSeconds(3, [&] {
+        now = 0;
+        for (size_t r = 0; r < rounds; r++)
+            for (const std::string &s : labels)
+                now += ImHashStr(s.c_str(), 0, (ImGuiID)r);
+    });
+    const double old_seconds = BestSeconds(3, [&] {
+        old = 0;
+        for (size_t r = 0; r < rounds; r++)
+            for (const std::string &s : labels)
+                old += OldHashStr(s.c_str(), (ImGuiID)r);
+    });
+    sink = sink + now;
+    const double calls = (double)rounds * labels.size();
+    printf("ImHashStr %zu labels: %.1f ns/label, old %.1f ns/label, x%.1f\n", labels.size(), seconds / calls * 1e9,
+           old_seconds / calls * 1e9, old_seconds / seconds);
+    if (now != old)
+    {
+        printf("ImHashStr differs from the old implementation\n");
+        failures++;
+    }
+    return failures == 0 ? 0 : 1;
+}
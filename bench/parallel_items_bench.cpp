@@ -0,0 +1,141 @@
+// Вершины линий ImPlot между BeginParallelItems/EndParallelItems: сразу в списке отрисовки (без
+// SetParallelForFunc) против отложенных заданий на WorkerPool из 1..N потоков, мс на кадр, без окна и GPU.
+// parallel_items_bench [кадров] [потоков]
+// По умолчанию потоков - std::thread::hardware_concurrency(). 1 поток - отложенный путь без пула:
+// цена второй записи геометрии. Контрольная сумма вершин должна совпасть у всех вариантов.
+#include <WorkerPool.h>
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <implot.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+static const int Series = 64, Points = 20000;
+
+struct Result
+{
+    double frame_ms; // медиана кадра от NewFrame до Render
+    ImGuiID checksum;
+};
+
+// Задания по порядку в вызывающем потоке
+static void SerialFor(ImPlotJob job, void *job_data, int count, void *user_data)
+{
+    IM_UNUSED(user_data);
+    for (int i = 0; i < count; i++)
+        job(i, job_data);
+}
+
+static Result Run(int frames, const std::vector<double> &xs, const std::vector<std::vector<double>> &ys)
+{
+    std::vector<double> times;
+    Result result = {0, 0};
+    const int warmup = 3;
+    for (int frame = 0; frame < warmup + frames; frame++)
+    {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2(0, 0));
+        ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+        ImGui::Begin("Graphs", nullptr, ImGuiWindowFlags_NoDecoration);
+        if (ImPlot::BeginPlot("##lines", ImVec2(-1, -1)))
+        {
+            ImPlot::SetupAxisLimits(ImAxis_X1, 0, 10, ImGuiCond_Always);
+            ImPlot::SetupAxisLimits(ImAxis_Y1, -1.5, Series + 0.5, ImGuiCond_Always);
+            ImPlot::BeginParallelItems();
+            for (int s = 0; s < Series; s++)
+            {
+                char label[32];
+                snprintf(label, sizeof(label), "channel %d", s);
+                ImPlot::PlotLine(label, xs.data(), ys[s].data(), Points);
+                // Элементы, которые рисуются сразу, между отложенными: порядок должен сохраниться
+                if (s % 16 == 15)
+                    ImPlot::PlotText("marker", 5.0, s);
+            }
+            ImPlot::EndParallelItems();
+            ImPlot::EndPlot();
+        }
+        ImGui::End();
+        ImGui::Render();
+        const double ms = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() * 1e3;
+        if (frame < warmup)
+            continue;
+        times.push_back(ms);
+        const ImDrawData *draw_data = ImGui::GetDrawData();
+        for (int l = 0; l < draw_data->CmdListsCount; l++)
+        {
+            const ImDrawList *list = draw_data->CmdLists[l];
+            result.checksum = ImHashData(list->VtxBuffer.Data, list->VtxBuffer.Size * sizeof(ImDrawVert), result.checksum);
+            result.checksum = ImHashData(list->IdxBuffer.Data, list->IdxBuffer.Size * sizeof(ImDrawIdx), result.checksum);
+        }
+    }
+    std::sort(times.begin(), times.end());
+    result.frame_ms = times[times.size() / 2];
+    return result;
+}
+
+int main(int argc, char **argv)
+{
+    const int frames = argc > 1 ? atoi(argv[1]) : 20;
+    const unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+    const int max_threads = argc > 2 ? atoi(argv[2]) : (int)hardware;
+
+    ImGui::CreateContext();
+    ImPlot::CreateContext();
+    ImGuiIO &io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(1920, 1080);
+    io.DeltaTime = 1.0f / 60.0f;
+    unsigned char *pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+    std::vector<double> xs(Points);
+    std::vector<std::vector<double>> ys(Series, std::vector<double>(Points));
+    for (int i = 0; i < Points; i++)
+    {
+        xs[i] = i * 10.0 / Points;
+        for (int s = 0; s < Series; s++)
+            ys[s][i] = s + sin(xs[i] * (s + 1)) * 0.4;
+    }
+
+    printf("%d lines x %d points, %d frames, %u hardware threads\n", Series, Points, frames, hardware);
+    ImPlot::SetParallelForFunc(nullptr);
+    const Result immediate = Run(frames, xs, ys);
+    printf("immediate           %8.2f ms/frame, checksum %08X\n", immediate.frame_ms, immediate.checksum);
+
+    int failures = 0;
+    for (int threads = 1; threads <= max_threads; threads++)
+    {
+        // WorkerPool(0) выбирает число потоков сам, поэтому 1 поток - SerialFor
+        std::unique_ptr<WorkerPool> pool;
+        if (threads > 1)
+        {
+            pool.reset(new WorkerPool(threads - 1));
+            ImPlot::SetParallelForFunc(WorkerPool::ParallelForImPlot, pool.get());
+        }
+        else
+        {
+            ImPlot::SetParallelForFunc(SerialFor);
+        }
+        const Result deferred = Run(frames, xs, ys);
+        ImPlot::SetParallelForFunc(nullptr);
+        printf("deferred, %2d thread%s %8.2f ms/frame, checksum %08X, x%.2f vs immediate\n", threads, threads > 1 ? "s" : " ",
+               deferred.frame_ms, deferred.checksum, immediate.frame_ms / deferred.frame_ms);
+        if (deferred.checksum != immediate.checksum)
+        {
+            printf("deferred frames differ from immediate ones\n");
+            failures++;
+        }
+    }
+
+    ImPlot::DestroyContext();
+    ImGui::DestroyContext();
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,169 @@
+// Кадр с большим количеством текста: 16 графиков 4x4 с легендами и подписями осей и таблица 40x6,
+// без окна и GPU. text_bench - с кешем размеров строк ImFont, text_bench_uncached - собран с
+// IMGUI_DISABLE_FONT_TEXT_RUN_CACHE. Отдельно - CalcTextSize() меток разной длины.
+// text_bench [кадров]
+// Контрольная сумма вершин кадров должна совпасть у обеих сборок.
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <implot.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+static const int Rows = 4, Columns = 4, Lines = 3, Points = 1000;
+static const int TableRows = 40, TableColumns = 6;
+
+static double Seconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void Frame(int frame, const std::vector<double> &xs, const std::vector<std::vector<double>> &ys)
+{
+    static const char *Headers[TableColumns] = {"Channel", "Source", "Last", "Min", "Max", "Rate, Hz"};
+    const ImVec2 display = ImGui::GetIO().DisplaySize;
+    ImGui::NewFrame();
+
+    ImGui::SetNextWindowPos(ImVec2(0, 0));
+    ImGui::SetNextWindowSize(ImVec2(display.x * 0.7f, display.y));
+    ImGui::Begin("Graphs", nullptr, ImGuiWindowFlags_NoDecoration);
+    if (ImPlot::BeginSubplots("##grid", Rows, Columns, ImVec2(-1, -1)))
+    {
+        for (int p = 0; p < Rows * Columns; p++)
+        {
+            char title[48];
+            snprintf(title, sizeof(title), "Accelerometer %d##plot%d", p, p);
+            if (ImPlot::BeginPlot(title))
+            {
+                ImPlot::SetupAxes("time, s", "acceleration, m/s^2");
+                ImPlot::SetupAxisLimits(ImAxis_X1, 0, 10, ImGuiCond_Always);
+                ImPlot::SetupAxisLimits(ImAxis_Y1, -2, 2, ImGuiCond_Always);
+                for (int l = 0; l < Lines; l++)
+                {
+                    char label[48];
+                    snprintf(label, sizeof(label), "sensor %d axis %c", p, 'X' + l);
+                    ImPlot::PlotLine(label, xs.data(), ys[p * Lines + l].data(), (int)xs.size());
+                }
+                ImPlot::EndPlot();
+            }
+        }
+        ImPlot::EndSubplots();
+    }
+    ImGui::End();
+
+    ImGui::SetNextWindowPos(ImVec2(display.x * 0.7f, 0));
+    ImGui::SetNextWindowSize(ImVec2(display.x * 0.3f, display.y));
+    ImGui::Begin("Channels", nullptr, ImGuiWindowFlags_NoDecoration);
+    if (ImGui::BeginTable("##stats", TableColumns, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable))
+    {
+        for (int c = 0; c < TableColumns; c++)
+            ImGui::TableSetupColumn(Headers[c]);
+        ImGui::TableHeadersRow();
+        for (int r = 0; r < TableRows; r++)
+        {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::Text("accelerometer_%02d", r);
+            ImGui::TableNextColumn();
+            ImGui::Text("COM%d, frame %d", 3 + r % 4, r / 4);
+            // Значения меняются каждый кадр, как в живой таблице статистики
+            const double value = sin(frame * 0.01 + r);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.4f", value);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.4f", -1.0 - r * 0.01);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.4f", 1.0 + r * 0.01);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", 1000.0 + r);
+        }
+        ImGui::EndTable();
+    }
+    ImGui::End();
+    ImGui::Render();
+}
+
+int main(int argc, char **argv)
+{
+    const int frames = argc > 1 ? atoi(argv[1]) : 400;
+
+    ImGui::CreateContext();
+    ImPlot::CreateContext();
+    ImGuiIO &io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(1920, 1080);
+    io.DeltaTime = 1.0f / 60.0f;
+    unsigned char *pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+    std::vector<double> xs(Points);
+    std::vector<std::vector<double>> ys(Rows * Columns * Lines, std::vector<double>(Points));
+    for (int i = 0; i < Points; i++)
+    {
+        xs[i] = i * 10.0 / Points;
+        for (size_t l = 0; l < ys.size(); l++)
+            ys[l][i] = sin(xs[i] * (l + 1) * 0.3);
+    }
+
+#ifdef IMGUI_DISABLE_FONT_TEXT_RUN_CACHE
+    printf("text run cache disabled\n");
+#else
+    printf("text run cache enabled\n");
+#endif
+
+    // Кадры: среднее и медиана, вершины всех кадров в контрольную сумму
+    for (int frame = 0; frame < 10; frame++)
+        Frame(frame, xs, ys);
+    std::vector<double> times;
+    ImGuiID checksum = 0;
+    for (int frame = 0; frame < frames; frame++)
+    {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        Frame(frame, xs, ys);
+        times.push_back(Seconds(start) * 1e6);
+        const ImDrawData *draw_data = ImGui::GetDrawData();
+        for (int l = 0; l < draw_data->CmdListsCount; l++)
+        {
+            const ImDrawList *list = draw_data->CmdLists[l];
+            checksum = ImHashData(list->VtxBuffer.Data, list->VtxBuffer.Size * sizeof(ImDrawVert), checksum);
+            checksum = ImHashData(list->IdxBuffer.Data, list->IdxBuffer.Size * sizeof(ImDrawIdx), checksum);
+        }
+    }
+    double total = 0;
+    for (double t : times)
+        total += t;
+    std::sort(times.begin(), times.end());
+    printf("%d plots + %dx%d table, %d frames: mean %.1f us, median %.1f us, checksum %08X\n", Rows * Columns,
+           TableRows, TableColumns, frames, total / frames, times[times.size() / 2], checksum);
+
+    // CalcTextSize() одних и тех же меток, как каждый кадр
+    ImGui::NewFrame();
+    for (int length : {6, 16, 40})
+    {
+        std::vector<std::string> labels;
+        for (int i = 0; i < 64; i++)
+        {
+            std::string label = "label " + std::to_string(i) + " ";
+            label.resize(length, 'x');
+            labels.push_back(label);
+        }
+        const int rounds = 20000;
+        volatile float sink = 0;
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int r = 0; r < rounds; r++)
+            for (const std::string &label : labels)
+                sink = sink + ImGui::CalcTextSize(label.c_str(), label.c_str() + label.size()).x;
+        const double seconds = Seconds(start);
+        printf("CalcTextSize %2d bytes: %.1f ns/label\n", length, seconds / (rounds * labels.size()) * 1e9);
+    }
+    ImGui::EndFrame();
+
+    ImPlot::DestroyContext();
+    ImGui::DestroyContext();
+    return 0;
+}
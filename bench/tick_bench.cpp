@@ -0,0 +1,141 @@
+// Метки осей ImPlot: время LocateTicks (расстановка и подписи делений) на кадр для 16 графиков 4x4,
+// без окна и GPU. tick_bench - с кешем делений и подписей, tick_bench_uncached - собран с
+// IMPLOT_DISABLE_TICK_CACHE, прежний путь: каждый кадр заново.
+// tick_bench [кадров]
+// Контрольная сумма вершин кадров должна совпасть у обеих сборок.
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <implot.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+static const int Rows = 4, Columns = 4, Points = 2000;
+
+struct Scenario
+{
+    const char *name;
+    bool time_axis;
+    bool scrolling;
+};
+
+struct Result
+{
+    double locate_us;   // LocateTicks за кадр
+    double frame_us;    // весь кадр от NewFrame до Render
+    ImGuiID checksum;   // вершины всех кадров
+};
+
+static Result Run(const Scenario &scenario, int frames, const std::vector<std::vector<double>> &ys, const std::vector<double> &xs)
+{
+    const double origin = scenario.time_axis ? 1.7e9 : 0.0; // секунды эпохи - подписи даты и времени
+    const double width = 10.0;
+    std::vector<double> shifted(xs.size());
+    std::vector<ProfileZones::Zone> zones;
+    Result result = {0, 0, 0};
+    const int warmup = 10;
+    for (int frame = 0; frame < warmup + frames; frame++)
+    {
+        const double start = origin + (scenario.scrolling ? frame / 60.0 : 0.0);
+        for (size_t i = 0; i < xs.size(); i++)
+            shifted[i] = start + xs[i];
+
+        const uint64_t begin = ProfileZones::Now();
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2(0, 0));
+        ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+        ImGui::Begin("Graphs", nullptr, ImGuiWindowFlags_NoDecoration);
+        if (ImPlot::BeginSubplots("##grid", Rows, Columns, ImVec2(-1, -1)))
+        {
+            for (int p = 0; p < Rows * Columns; p++)
+            {
+                char title[32];
+                snprintf(title, sizeof(title), "Channel %d", p);
+                if (ImPlot::BeginPlot(title))
+                {
+                    ImPlot::SetupAxes(nullptr, nullptr);
+                    if (scenario.time_axis)
+                        ImPlot::SetupAxisScale(ImAxis_X1, ImPlotScale_Time);
+                    ImPlot::SetupAxisLimits(ImAxis_X1, start, start + width, ImGuiCond_Always);
+                    ImPlot::SetupAxisLimits(ImAxis_Y1, -1.5 * (p + 1), 1.5 * (p + 1), ImGuiCond_Always);
+                    ImPlot::PlotLine("value", shifted.data(), ys[p].data(), (int)xs.size());
+                    ImPlot::EndPlot();
+                }
+            }
+            ImPlot::EndSubplots();
+        }
+        ImGui::End();
+        ImGui::Render();
+        const uint64_t end = ProfileZones::Now();
+
+        zones.clear();
+        ProfileZones::Get().Collect(begin, zones);
+        if (frame < warmup)
+            continue;
+        for (const ProfileZones::Zone &zone : zones)
+            if (strcmp(zone.Name, "ImPlot::LocateTicks") == 0)
+                result.locate_us += (zone.End - zone.Begin) * 1e-3;
+        result.frame_us += (end - begin) * 1e-3;
+        const ImDrawData *draw_data = ImGui::GetDrawData();
+        for (int l = 0; l < draw_data->CmdListsCount; l++)
+        {
+            const ImDrawList *list = draw_data->CmdLists[l];
+            result.checksum = ImHashData(list->VtxBuffer.Data, list->VtxBuffer.Size * sizeof(ImDrawVert), result.checksum);
+            result.checksum = ImHashData(list->IdxBuffer.Data, list->IdxBuffer.Size * sizeof(ImDrawIdx), result.checksum);
+        }
+    }
+    result.locate_us /= frames;
+    result.frame_us /= frames;
+    return result;
+}
+
+int main(int argc, char **argv)
+{
+    const int frames = argc > 1 ? atoi(argv[1]) : 400;
+
+    ImGui::CreateContext();
+    ImPlot::CreateContext();
+    ImGuiIO &io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(1600, 1000);
+    io.DeltaTime = 1.0f / 60.0f;
+    unsigned char *pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+    // 10 с по 2000 точек на канал
+    std::vector<double> xs(Points);
+    std::vector<std::vector<double>> ys(Rows * Columns, std::vector<double>(Points));
+    for (int i = 0; i < Points; i++)
+    {
+        xs[i] = i * 10.0 / Points;
+        for (int p = 0; p < Rows * Columns; p++)
+            ys[p][i] = (p + 1) * sin(xs[i] * (p + 1));
+    }
+
+    const Scenario scenarios[] = {
+        {"linear, scrolling", false, true},
+        {"linear, paused", false, false},
+        {"time, scrolling", true, true},
+        {"time, paused", true, false},
+    };
+#ifdef IMPLOT_DISABLE_TICK_CACHE
+    printf("tick cache disabled, %d frames of %d subplots\n", frames, Rows * Columns);
+#else
+    printf("tick cache enabled, %d frames of %d subplots\n", frames, Rows * Columns);
+#endif
+    for (const Scenario &scenario : scenarios)
+    {
+        const Result result = Run(scenario, frames, ys, xs);
+        printf("%-18s LocateTicks %6.1f us/frame, frame %6.1f us, checksum %08X\n", scenario.name, result.locate_us,
+               result.frame_us, result.checksum);
+    }
+
+    ImPlot::DestroyContext();
+    ImGui::DestroyContext();
+    return 0;
+}
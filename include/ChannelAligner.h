@@ -0,0 +1,177 @@
+#pragma once
+
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <cmath>
+#include <deque>
+#include <string>
+#include <vector>
+
+// Resamples series of different rates and jittered timestamps onto one grid of Step() seconds,
+// so that any two of them can be plotted against each other or correlated straight from
+// contiguous columns. Samples are appended per series in time order; Update() emits the grid
+// rows whose value is known for every series (the next sample after the row has arrived) or
+// that are older than Timeout seconds, holding the last value then. Series and grid are walked
+// together as a merge join of sorted times, so every sample and every row is visited once.
+// Interpolation is zero-order hold (the last sample at or before the row) or linear between
+// the samples around the row; rows before the first sample of a series are NaN. When more than
+// twice the capacity is retained the oldest rows are discarded down to the capacity.
+class ChannelAligner {
+public:
+    enum Mode {
+        Mode_Hold,
+        Mode_Linear
+    };
+
+    explicit ChannelAligner(double step = 0.01, size_t capacity = 1 << 16)
+        : step_(step), mode_(Mode_Linear), timeout_(0.5), capacity_(capacity), started_(false), next_(0) {}
+
+    // Existing series keep their pending samples, the grid starts again
+    int AddSeries(const char* name) {
+        Series series;
+        series.Name = name;
+        series_.push_back(std::move(series));
+        Restart();
+        return (int)series_.size() - 1;
+    }
+
+    void Clear() {
+        series_.clear();
+        Restart();
+    }
+
+    // Restart the grid with the samples that are still pending
+    void SetStep(double step) {
+        step_ = ImMax(step, 1e-6);
+        Restart();
+    }
+
+    void SetMode(Mode mode) {
+        mode_ = mode;
+        Restart();
+    }
+
+    void SetTimeout(double seconds) { timeout_ = seconds; }
+
+    // `t` must not decrease within a series
+    void Append(int series, double t, float v) {
+        Series& s = series_[series];
+        s.Pending.push_back(Sample{ t, v });
+        if (!started_) {
+            started_ = true;
+            next_ = floor(t / step_) * step_;
+        }
+    }
+
+    // Emits the rows that are complete, or older than `now` - Timeout. At most the capacity per
+    // call, the rest on the next calls. Rows that would be discarded right away (a restart from an
+    // old held sample, a long pause) are skipped; the samples before them still set the held value.
+    void Update(double now) {
+        if (!started_ || series_.empty())
+            return;
+        const double oldest = now - timeout_ - (double)capacity_ * step_;
+        if (next_ < oldest)
+            next_ += floor((oldest - next_) / step_) * step_;
+        for (size_t rows = 0; rows < capacity_; rows++) {
+            const double g = next_;
+            bool ready = g <= now - timeout_;
+            if (!ready) {
+                ready = true;
+                for (const Series& s : series_)
+                    ready = ready && !s.Pending.empty() && s.Pending.back().Time >= g;
+            }
+            if (!ready)
+                break;
+            time_.push_back(g);
+            for (Series& s : series_) {
+                while (!s.Pending.empty() && s.Pending.front().Time <= g) {
+                    s.Prev = s.Pending.front();
+                    s.HasPrev = true;
+                    s.Pending.pop_front();
+                }
+                float v = s.HasPrev ? s.Prev.Value : NAN;
+                if (mode_ == Mode_Linear && s.HasPrev && !s.Pending.empty()) {
+                    const Sample& b = s.Pending.front();
+                    v = (float)(s.Prev.Value + (b.Value - s.Prev.Value) * ((g - s.Prev.Time) / (b.Time - s.Prev.Time)));
+                }
+                s.Column.push_back(v);
+            }
+            next_ += step_;
+            if (time_.size() >= 2 * capacity_) {
+                const size_t drop = time_.size() - capacity_;
+                time_.erase(time_.begin(), time_.begin() + drop);
+                for (Series& s : series_)
+                    s.Column.erase(s.Column.begin(), s.Column.begin() + drop);
+            }
+        }
+    }
+
+    int Count() const { return (int)series_.size(); }
+    const char* Name(int series) const { return series_[series].Name.c_str(); }
+    double Step() const { return step_; }
+    Mode GetMode() const { return mode_; }
+
+    // Aligned rows: Time()[i] and Column(s)[i] for every series
+    size_t Rows() const { return time_.size(); }
+    const double* Time() const { return time_.data(); }
+    const float* Column(int series) const { return series_[series].Column.data(); }
+
+    // Normalised cross-correlation of `a` and `b` for lags -max_lag..max_lag (b shifted later
+    // by the lag), written to out[lag + max_lag]. NaN rows are skipped per lag.
+    static void CrossCorrelation(const float* a, const float* b, int n, int max_lag, float* out) {
+        for (int lag = -max_lag; lag <= max_lag; lag++) {
+            double sa = 0, sb = 0, saa = 0, sbb = 0, sab = 0;
+            int count = 0;
+            for (int i = ImMax(0, -lag); i < n && i + lag < n; i++) {
+                const double x = a[i], y = b[i + lag];
+                if (x != x || y != y)
+                    continue;
+                sa += x, sb += y, saa += x * x, sbb += y * y, sab += x * y;
+                count++;
+            }
+            const double va = saa - sa * sa / ImMax(count, 1), vb = sbb - sb * sb / ImMax(count, 1);
+            out[lag + max_lag] = count > 1 && va > 0 && vb > 0 ? (float)((sab - sa * sb / count) / sqrt(va * vb)) : 0.0f;
+        }
+    }
+
+private:
+    struct Sample {
+        double Time;
+        float  Value;
+    };
+
+    struct Series {
+        std::string        Name;
+        std::deque<Sample> Pending;       // after the last emitted row
+        Sample             Prev = {};     // last sample at or before it
+        bool               HasPrev = false;
+        std::vector<float> Column;
+    };
+
+    void Restart() {
+        time_.clear();
+        started_ = false;
+        double first = INFINITY;
+        for (Series& s : series_) {
+            s.Column.clear();
+            if (s.HasPrev)
+                s.Pending.push_front(s.Prev); // keeps the value held across the restart
+            s.HasPrev = false;
+            if (!s.Pending.empty())
+                first = ImMin(first, s.Pending.front().Time);
+        }
+        if (first != INFINITY) {
+            started_ = true;
+            next_ = floor(first / step_) * step_;
+        }
+    }
+
+    double step_;
+    Mode   mode_;
+    double timeout_;
+    const size_t capacity_;
+    bool   started_;
+    double next_;                // time of the next row
+    std::vector<double> time_;
+    std::vector<Series> series_;
+};
@@ -0,0 +1,375 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Decoded channels for other processes on the same machine: the app is the only writer of a
+// named shared memory ring ("Local\<name>" on Windows, "/<name>" under POSIX), any number of
+// readers map it read-only and read the blocks in place. Self-contained, so that other tools
+// can include just this header; the layout is plain enough to map from numpy as well.
+//
+// Layout, little endian, every field at its natural alignment:
+//   Header (HeaderBytes):
+//     u32 Magic 'SEPT', u32 Version, u32 SlotCount, u32 BlockRows, u32 MaxChannels, u32 SlotBytes,
+//     u64 WriteSeq   blocks published so far (the newest one is WriteSeq - 1)
+//     u64 LayoutSeq  even: names are stable, odd: being rewritten
+//     u32 Channels, u32 reserved, char Names[MaxChannels][NameBytes]
+//   Slots at HeaderBytes + (seq % SlotCount) * SlotBytes:
+//     u64 Seq        seq + 1 once block `seq` is complete, 0 while it is being written
+//     u64 FirstRow, u64 PublishNs (steady_clock of the writer), u64 Layout (LayoutSeq of the names)
+//     u32 Rows, u32 Channels, u64 reserved, then float Values[Channels][BlockRows], channel-major
+//
+// A block is read like a seqlock: check Seq, read the values, check Seq again. A reader more than
+// SlotCount blocks behind finds a newer Seq, counts the lost blocks and continues at the oldest
+// block still in the ring; the writer never waits for readers.
+namespace ChannelShm {
+    enum : uint32_t {
+        Magic       = 0x54504553, // "SEPT"
+        Version     = 1,
+        SlotCount   = 64,
+        BlockRows   = 256,
+        MaxChannels = 32,
+        NameBytes   = 32,
+        HeaderBytes = 4096,
+        SlotHeader  = 48,
+        SlotBytes   = SlotHeader + MaxChannels * BlockRows * 4,
+        TotalBytes  = HeaderBytes + SlotCount * SlotBytes
+    };
+
+    struct Header {
+        uint32_t Magic, Version, SlotCount, BlockRows, MaxChannels, SlotBytes;
+        std::atomic<uint64_t> WriteSeq;
+        std::atomic<uint64_t> LayoutSeq;
+        uint32_t Channels, Reserved;
+        char Names[ChannelShm::MaxChannels][ChannelShm::NameBytes];
+    };
+
+    struct Slot {
+        std::atomic<uint64_t> Seq;
+        uint64_t FirstRow;
+        uint64_t PublishNs;
+        uint64_t Layout;
+        uint32_t Rows, Channels;
+        uint64_t Reserved;
+        float Values[1];   // [Channels][BlockRows]
+    };
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared atomics must be address-free");
+    static_assert(sizeof(Header) <= HeaderBytes, "header does not fit");
+    static_assert(offsetof(Slot, Values) == SlotHeader, "slot layout");
+
+    inline uint64_t Now() {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Named mapping of TotalBytes, created by the writer or opened read-only by a reader
+    class Mapping {
+    public:
+        Mapping() : base_(nullptr) {
+#ifdef _WIN32
+            handle_ = nullptr;
+#endif
+        }
+
+        ~Mapping() { Close(); }
+
+        Mapping(const Mapping&) = delete;
+        Mapping& operator=(const Mapping&) = delete;
+
+        bool Open(const char* name, bool writer) {
+            Close();
+#ifdef _WIN32
+            const std::string path = std::string("Local\\") + name;
+            handle_ = writer ? CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, TotalBytes, path.c_str())
+                             : OpenFileMappingA(FILE_MAP_READ, FALSE, path.c_str());
+            if (!handle_)
+                return false;
+            base_ = MapViewOfFile(handle_, writer ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, TotalBytes);
+#else
+            name_ = std::string("/") + name;
+            const int fd = writer ? shm_open(name_.c_str(), O_CREAT | O_RDWR, 0644) : shm_open(name_.c_str(), O_RDONLY, 0);
+            if (fd < 0)
+                return false;
+            struct stat st;
+            if ((writer && ftruncate(fd, TotalBytes) != 0) || fstat(fd, &st) != 0 || (size_t)st.st_size < TotalBytes) {
+                close(fd);
+                return false;
+            }
+            base_ = mmap(nullptr, TotalBytes, writer ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+            close(fd);
+            if (base_ == MAP_FAILED)
+                base_ = nullptr;
+            owner_ = writer;
+#endif
+            if (!base_)
+                Close();
+            return base_ != nullptr;
+        }
+
+        void Close() {
+#ifdef _WIN32
+            if (base_)
+                UnmapViewOfFile(base_);
+            if (handle_)
+                CloseHandle(handle_);
+            handle_ = nullptr;
+#else
+            if (base_)
+                munmap(base_, TotalBytes);
+            if (base_ && owner_)
+                shm_unlink(name_.c_str()); // readers keep their mapping
+#endif
+            base_ = nullptr;
+        }
+
+        void* Base() const { return base_; }
+
+    private:
+        void* base_;
+#ifdef _WIN32
+        HANDLE handle_;
+#else
+        std::string name_;
+        bool owner_ = false;
+#endif
+    };
+}
+
+// Writer side. Rows are gathered into a block of BlockRows and published when the block is full
+// or on Flush(). One thread only.
+class ChannelPublisher {
+public:
+    ChannelPublisher() : header_(nullptr), pending_(0), first_row_(0) {}
+
+    bool Open(const char* name) {
+        if (!mapping_.Open(name, true))
+            return false;
+        header_ = (ChannelShm::Header*)mapping_.Base();
+        header_->Magic = 0; // readers wait until the header is complete
+        std::atomic_thread_fence(std::memory_order_release);
+        header_->Version = ChannelShm::Version;
+        header_->SlotCount = ChannelShm::SlotCount;
+        header_->BlockRows = ChannelShm::BlockRows;
+        header_->MaxChannels = ChannelShm::MaxChannels;
+        header_->SlotBytes = ChannelShm::SlotBytes;
+        header_->WriteSeq.store(0, std::memory_order_relaxed);
+        header_->LayoutSeq.store(0, std::memory_order_relaxed);
+        header_->Channels = 0;
+        for (uint32_t i = 0; i < ChannelShm::SlotCount; i++)
+            SlotAt(i)->Seq.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        header_->Magic = ChannelShm::Magic;
+        pending_ = 0;
+        names_.clear();
+        return true;
+    }
+
+    void Close() {
+        mapping_.Close();
+        header_ = nullptr;
+    }
+
+    bool IsOpen() const { return header_ != nullptr; }
+    uint64_t Published() const { return header_ ? header_->WriteSeq.load(std::memory_order_relaxed) : 0; }
+
+    // Flushes the pending rows first. At most MaxChannels names, longer names are cut.
+    void SetChannels(const std::vector<std::string>& names) {
+        Flush();
+        names_.assign(names.begin(), names.begin() + std::min<size_t>(names.size(), ChannelShm::MaxChannels));
+        if (!header_)
+            return;
+        const uint64_t seq = header_->LayoutSeq.load(std::memory_order_relaxed);
+        header_->LayoutSeq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        memset(header_->Names, 0, sizeof(header_->Names));
+        for (size_t i = 0; i < names_.size(); i++)
+            strncpy(header_->Names[i], names_[i].c_str(), ChannelShm::NameBytes - 1);
+        header_->Channels = (uint32_t)names_.size();
+        header_->LayoutSeq.store(seq + 2, std::memory_order_release);
+    }
+
+    // One value per channel; `row` is the index of the row in the writer's store
+    void Append(uint64_t row, const float* values) {
+        if (!header_ || names_.empty())
+            return;
+        if (pending_ == 0) {
+            first_row_ = row;
+            Begin();
+        }
+        ChannelShm::Slot* slot = Current();
+        for (size_t c = 0; c < names_.size(); c++)
+            slot->Values[c * ChannelShm::BlockRows + pending_] = values[c];
+        if (++pending_ == ChannelShm::BlockRows)
+            Flush();
+    }
+
+    // Publishes the pending rows as a block
+    void Flush() {
+        if (!header_ || pending_ == 0)
+            return;
+        const uint64_t seq = header_->WriteSeq.load(std::memory_order_relaxed);
+        ChannelShm::Slot* slot = Current();
+        slot->FirstRow = first_row_;
+        slot->PublishNs = ChannelShm::Now();
+        slot->Layout = header_->LayoutSeq.load(std::memory_order_relaxed);
+        slot->Rows = pending_;
+        slot->Channels = (uint32_t)names_.size();
+        slot->Seq.store(seq + 1, std::memory_order_release);
+        header_->WriteSeq.store(seq + 1, std::memory_order_release);
+        pending_ = 0;
+    }
+
+private:
+    ChannelShm::Slot* SlotAt(uint64_t seq) const {
+        return (ChannelShm::Slot*)((char*)header_ + ChannelShm::HeaderBytes + (seq % ChannelShm::SlotCount) * ChannelShm::SlotBytes);
+    }
+
+    ChannelShm::Slot* Current() const { return SlotAt(header_->WriteSeq.load(std::memory_order_relaxed)); }
+
+    // Marks the slot as being written before its values change
+    void Begin() {
+        Current()->Seq.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    ChannelShm::Mapping mapping_;
+    ChannelShm::Header* header_;
+    std::vector<std::string> names_;
+    uint32_t pending_;   // rows in the current block
+    uint64_t first_row_;
+};
+
+// Reader side, for other processes. Values point into the shared ring: read them, then
+// Release() tells whether the writer overwrote the block meanwhile.
+//
+//     ChannelReader reader;
+//     reader.Open("sept_channels");
+//     while (const ChannelShm::Slot* block = reader.Next()) {
+//         const float* x = reader.Values(block, reader.Find("mouse_y"));
+//         ... block->Rows values of x ...
+//         if (!reader.Release(block))
+//             ... the values were overwritten, discard them ...
+//     }
+class ChannelReader {
+public:
+    ChannelReader() : header_(nullptr), next_(0), lost_(0), layout_(1) {}
+
+    // Starts at the newest block, or at the oldest one still in the ring
+    bool Open(const char* name, bool from_oldest = false) {
+        if (!mapping_.Open(name, false))
+            return false;
+        header_ = (const ChannelShm::Header*)mapping_.Base();
+        if (header_->Magic != ChannelShm::Magic || header_->Version != ChannelShm::Version) {
+            Close();
+            return false;
+        }
+        const uint64_t written = header_->WriteSeq.load(std::memory_order_acquire);
+        next_ = from_oldest && written > ChannelShm::SlotCount ? written - ChannelShm::SlotCount : from_oldest ? 0 : written;
+        lost_ = 0;
+        layout_ = 1;
+        return true;
+    }
+
+    void Close() {
+        mapping_.Close();
+        header_ = nullptr;
+    }
+
+    bool IsOpen() const { return header_ != nullptr; }
+
+    // Next published block, or nullptr if there is none yet
+    const ChannelShm::Slot* Next() {
+        for (;;) {
+            const uint64_t written = header_->WriteSeq.load(std::memory_order_acquire);
+            if (next_ >= written)
+                return nullptr;
+            if (written - next_ > ChannelShm::SlotCount - 1) {
+                // lapped: skip to the oldest block that is not being rewritten
+                lost_ += written - (ChannelShm::SlotCount - 1) - next_;
+                next_ = written - (ChannelShm::SlotCount - 1);
+            }
+            const ChannelShm::Slot* slot = SlotAt(next_);
+            if (slot->Seq.load(std::memory_order_acquire) == next_ + 1) {
+                if (slot->Layout != layout_)
+                    ReadLayout();
+                if (slot->Layout == layout_)
+                    return slot;
+                // written with names that were replaced since, nothing to read it by
+            }
+            lost_++;
+            next_++;
+        }
+    }
+
+    // False if the block was overwritten while it was read; moves on in both cases
+    bool Release(const ChannelShm::Slot* slot) {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const bool valid = slot->Seq.load(std::memory_order_relaxed) == next_ + 1;
+        lost_ += valid ? 0 : 1;
+        next_++;
+        return valid;
+    }
+
+    int Channels() const { return (int)names_.size(); }
+    const char* Name(int channel) const { return names_[channel].c_str(); }
+
+    int Find(const char* name) const {
+        for (size_t i = 0; i < names_.size(); i++)
+            if (names_[i] == name)
+                return (int)i;
+        return -1;
+    }
+
+    const float* Values(const ChannelShm::Slot* slot, int channel) const {
+        return slot->Values + (size_t)channel * ChannelShm::BlockRows;
+    }
+
+    uint64_t Lost() const { return lost_; }
+
+private:
+    const ChannelShm::Slot* SlotAt(uint64_t seq) const {
+        return (const ChannelShm::Slot*)((const char*)header_ + ChannelShm::HeaderBytes + (seq % ChannelShm::SlotCount) * ChannelShm::SlotBytes);
+    }
+
+    // Names under the layout seqlock
+    void ReadLayout() {
+        for (;;) {
+            const uint64_t seq = header_->LayoutSeq.load(std::memory_order_acquire);
+            if (seq % 2 == 0) {
+                std::vector<std::string> names;
+                const uint32_t channels = std::min<uint32_t>(header_->Channels, ChannelShm::MaxChannels);
+                for (uint32_t i = 0; i < channels; i++)
+                    names.emplace_back(header_->Names[i], strnlen(header_->Names[i], ChannelShm::NameBytes));
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (header_->LayoutSeq.load(std::memory_order_relaxed) == seq) {
+                    names_.swap(names);
+                    layout_ = seq;
+                    return;
+                }
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    ChannelShm::Mapping mapping_;
+    const ChannelShm::Header* header_;
+    std::vector<std::string> names_;
+    uint64_t next_;     // sequence of the next block to read
+    uint64_t lost_;
+    uint64_t layout_;   // LayoutSeq the names were read at
+};
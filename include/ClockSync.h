@@ -0,0 +1,188 @@
+#pragma once
+
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <implot.h>
+#include <mutex>
+#include <vector>
+#include <cstring>
+
+// Maps the timestamps a device puts into its frames onto the host steady_clock. Every frame
+// gives a point (device time, host read time - device time): the transport only ever adds
+// delay, so the clock relation is the lower envelope of the points. The points are reduced to
+// the minimum per Bucket of device time, and the offset and drift come from the edge of the
+// lower convex hull of the last Buckets minima that spans their mean: the line below every
+// point with the least total distance to them (linear programming fit, as in Moon, Skelly
+// and Towsley). Slow frames and bursts do not move it, and it follows drift as old buckets
+// leave the window. The host time of a sample includes the smallest transport delay, which is
+// the same for devices on similar links, so their captures line up.
+// Update() and Reset() from one thread at a time, Draw() from the UI thread.
+class ClockSync {
+public:
+    enum {
+        Buckets  = 64,        // window of 32 s
+        BucketUs = 500000,    // device time per bucket
+        History  = 2048       // residuals kept for the plot
+    };
+
+    struct State {
+        ImU64  Samples;
+        ImU64  Resets;        // device clock jumped, estimation restarted
+        int    Points;        // bucket minima in the fit
+        int    HullPoints;
+        double OffsetMs;      // host - device at the last sample, including the smallest delay
+        double DriftPpm;      // device clock is slow by this much
+        double ResidualMs;    // delay of the last sample above the envelope
+        double JitterMs;      // average of the residuals
+    };
+
+    ClockSync() : state_() {
+        Reset();
+    }
+
+    // Forgets the device, e.g. when the port is reopened
+    void Reset() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const ImU64 resets = state_.Resets;
+        memset(&state_, 0, sizeof(state_));
+        state_.Resets = resets;
+        started_ = false;
+        device_last_ = 0;
+        device_wraps_ = 0;
+        points_.clear();
+        residuals_.clear();
+        residual_next_ = 0;
+        slope_ = intercept_ = 0.0;
+    }
+
+    // `device_us` is the free-running 32-bit microsecond counter of the device, `host_ns` the
+    // steady_clock time of the read that delivered the frame. Returns the host time of the sample.
+    ImU64 Update(ImU32 device_us, ImU64 host_ns) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (started_ && (ImS32)(device_us - device_last_) < -1000000) {
+            state_.Resets++; // more than a second back: the device restarted
+            started_ = false;
+        }
+        if (!started_) {
+            started_ = true;
+            device_wraps_ = 0;
+            device_origin_ = device_us;
+            host_origin_ = host_ns;
+            points_.clear();
+            slope_ = intercept_ = 0.0;
+        } else if (device_us < device_last_ && (ImS32)(device_us - device_last_) >= 0) {
+            device_wraps_++;
+        }
+        device_last_ = device_us;
+        const double x = (double)((ImS64)(((ImU64)device_wraps_ << 32) + device_us) - (ImS64)device_origin_); // us
+        const double y = ((double)(ImS64)(host_ns - host_origin_) * 1e-3) - x;                                 // us
+        state_.Samples++;
+
+        const ImS64 bucket = (ImS64)(x / BucketUs);
+        bool changed = false;
+        if (points_.empty() || points_.back().Bucket < bucket) {
+            points_.push_back(Point{ bucket, x, y });
+            if ((int)points_.size() > Buckets)
+                points_.erase(points_.begin());
+            changed = true;
+        } else if (y < points_.back().Y) {
+            points_.back().X = x;
+            points_.back().Y = y;
+            changed = true;
+        }
+        if (changed)
+            Fit();
+
+        const double envelope = intercept_ + slope_ * x;
+        const double residual = ImMax(y - envelope, 0.0);
+        state_.OffsetMs = (envelope + (double)host_origin_ * 1e-3 - (double)device_origin_) * 1e-3;
+        state_.DriftPpm = slope_ * 1e6;
+        state_.ResidualMs = residual * 1e-3;
+        state_.JitterMs += (state_.ResidualMs - state_.JitterMs) * (state_.Samples == 1 ? 1.0 : 0.01);
+        if ((int)residuals_.size() < History)
+            residuals_.push_back(ImVec2((float)(x * 1e-6), (float)state_.ResidualMs));
+        else
+            residuals_[residual_next_] = ImVec2((float)(x * 1e-6), (float)state_.ResidualMs);
+        residual_next_ = (residual_next_ + 1) % History;
+        return host_origin_ + (ImU64)(ImS64)((x + envelope) * 1e3);
+    }
+
+    State GetState() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return state_;
+    }
+
+    void Draw(const char* title, bool* p_open = nullptr) {
+        if (!ImGui::Begin(title, p_open)) {
+            ImGui::End();
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (state_.Samples == 0) {
+            ImGui::TextDisabled("No device timestamps received");
+            ImGui::End();
+            return;
+        }
+        ImGui::Text("Offset %.3f ms, drift %+.2f ppm", state_.OffsetMs, state_.DriftPpm);
+        ImGui::Text("Residual %.3f ms, jitter %.3f ms", state_.ResidualMs, state_.JitterMs);
+        ImGui::Text("%llu samples, %d buckets, %d hull points, %llu resets", (unsigned long long)state_.Samples,
+                    state_.Points, state_.HullPoints, (unsigned long long)state_.Resets);
+        if (ImPlot::BeginPlot("##residuals", ImVec2(-1, -1))) {
+            ImPlot::SetupAxes("device time, s", "delay above envelope, ms", ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_AutoFit);
+            ImPlot::PlotScatter("residual", &residuals_[0].x, &residuals_[0].y, (int)residuals_.size(), 0,
+                                residual_next_ % (int)residuals_.size(), sizeof(ImVec2));
+            ImPlot::EndPlot();
+        }
+        ImGui::End();
+    }
+
+private:
+    struct Point {
+        ImS64  Bucket;
+        double X, Y; // device time and host - device time, us from the origins
+    };
+
+    // Lower hull by monotone chain (points are in X order), then the hull edge over the mean X
+    void Fit() {
+        hull_.clear();
+        double mean = 0.0;
+        for (const Point& p : points_) {
+            mean += p.X;
+            while (hull_.size() >= 2) {
+                const Point& a = hull_[hull_.size() - 2];
+                const Point& b = hull_.back();
+                if ((b.X - a.X) * (p.Y - a.Y) - (b.Y - a.Y) * (p.X - a.X) > 0.0)
+                    break;
+                hull_.pop_back();
+            }
+            hull_.push_back(p);
+        }
+        mean /= points_.size();
+        state_.Points = (int)points_.size();
+        state_.HullPoints = (int)hull_.size();
+        if (hull_.size() < 2) {
+            intercept_ = hull_[0].Y - slope_ * hull_[0].X;
+            return;
+        }
+        size_t i = 0;
+        while (i + 2 < hull_.size() && hull_[i + 1].X < mean)
+            i++;
+        const Point& a = hull_[i];
+        const Point& b = hull_[i + 1];
+        slope_ = (b.Y - a.Y) / (b.X - a.X);
+        intercept_ = a.Y - slope_ * a.X;
+    }
+
+    std::mutex mutex_;             // guards everything below
+    State  state_;
+    bool   started_;
+    ImU32  device_last_;
+    ImU32  device_wraps_;
+    ImU64  device_origin_;          // first device time, us
+    ImU64  host_origin_;            // its read time, ns
+    std::vector<Point> points_;     // bucket minima, oldest first
+    std::vector<Point> hull_;       // Fit() scratch
+    double slope_, intercept_;      // envelope: y = intercept_ + slope_ * x
+    std::vector<ImVec2> residuals_; // ring for the plot
+    int    residual_next_;
+};
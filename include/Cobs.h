@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+
+// Consistent Overhead Byte Stuffing: a frame without zero bytes, so that a single 0 delimits
+// frames and boundaries are found with memchr(). Each block is a code byte n followed by n - 1
+// non-zero bytes and an implied zero, except after code 0xFF and after the last block. The
+// overhead is one byte per 254 bytes of payload (at least one). Blocks are located with memchr()
+// and moved with memcpy(), so the codec works on runs rather than one byte at a time.
+// Output is byte for byte that of StuffData by Cheshire and Baker, including the final 0x01 block
+// after a payload that ends in a full run of 254 non-zero bytes; the delimiter is not written.
+class Cobs {
+public:
+    static size_t MaxEncodedSize(size_t size) {
+        return size + size / 254 + 1;
+    }
+
+    // Writes at most MaxEncodedSize(size) bytes to `out`, returns the encoded size
+    static size_t Encode(const void* data, size_t size, unsigned char* out) {
+        const unsigned char* p = (const unsigned char*)data;
+        const unsigned char* end = p + size;
+        unsigned char* o = out;
+        for (;;) {
+            size_t run = end - p < 254 ? end - p : 254;
+            const unsigned char* zero = (const unsigned char*)memchr(p, 0, run);
+            if (zero != nullptr)
+                run = zero - p;
+            *o++ = (unsigned char)(run + 1);
+            memcpy(o, p, run);
+            o += run;
+            p += run;
+            if (zero != nullptr)
+                p++; // a trailing zero still needs the final block
+            else if (run < 254)
+                break; // p == end; after a full run the final block is 0x01
+        }
+        return o - out;
+    }
+
+    // Decodes one frame without its delimiter, `out` needs `size` bytes (may be `in`). Returns
+    // false on a zero byte or a block that runs past the end, `out_size` is then unspecified.
+    static bool Decode(const unsigned char* in, size_t size, unsigned char* out, size_t* out_size) {
+        const unsigned char* end = in + size;
+        unsigned char* o = out;
+        while (in < end) {
+            const size_t code = *in++;
+            if (code == 0 || code - 1 > (size_t)(end - in))
+                return false;
+            if (memchr(in, 0, code - 1) != nullptr)
+                return false;
+            memmove(o, in, code - 1);
+            o += code - 1;
+            in += code - 1;
+            if (code != 0xFF && in < end)
+                *o++ = 0;
+        }
+        *out_size = o - out;
+        return true;
+    }
+};
@@ -1,6 +1,15 @@
 #pragma once
 
+#ifdef _WIN32
 #include <windows.h>
+#else
+#include <termios.h>
+#include <poll.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#endif
+#include <cstdint>
 #include <iostream>
 #include <thread>
 #include <functional>
@@ -8,13 +17,16 @@
 #include <vector>
 #include <time.h>
 
+// Serial port with a reader thread that hands everything received to the callback in batches.
+// Takes the paths listed by PortScanner: \\.\COM3 on Windows, /dev/ttyUSB0 under POSIX.
+#ifdef _WIN32
 class ComPort {
 public:
     ComPort(void) 
         :portHandle_(INVALID_HANDLE_VALUE) {
     }
 
-    ComPort(const std::string& portName, size_t baud, std::function<void(char)> callback)
+    ComPort(const std::string& portName, size_t baud, std::function<void(const char*, size_t)> callback)
         : callback_(callback), portHandle_(INVALID_HANDLE_VALUE) {
         OpenPort(portName, baud);
         if (portHandle_ != INVALID_HANDLE_VALUE) {
@@ -31,7 +43,7 @@ public:
         }
     }
 
-    bool open(const std::string& portName, size_t baud, std::function<void(char)> callback) {
+    bool open(const std::string& portName, size_t baud, std::function<void(const char*, size_t)> callback) {
         if(portHandle_ != INVALID_HANDLE_VALUE) 
             return false;
         
@@ -100,27 +112,6 @@ public:
         return true;
     }
 
-    std::vector<std::string> GetCOMPortsFromRegistry() {
-        std::vector<std::string> ports;
-        HKEY hKey;
-        if (RegOpenKeyExA(HKEY_LOCAL_MACHINE, "HARDWARE\\DEVICEMAP\\SERIALCOMM", 0, KEY_READ, &hKey) == ERROR_SUCCESS) {
-            char valueName[256];
-            char valueData[256];
-            DWORD valueNameLen = sizeof(valueName);
-            DWORD valueDataLen = sizeof(valueData);
-            DWORD index = 0;
-    
-            while (RegEnumValueA(hKey, index, valueName, &valueNameLen, NULL, NULL, (LPBYTE)valueData, &valueDataLen) == ERROR_SUCCESS) {
-                ports.push_back(valueData);
-                valueNameLen = sizeof(valueName);
-                valueDataLen = sizeof(valueData);
-                index++;
-            }
-            RegCloseKey(hKey);
-        }
-        return ports;
-    }
-
     bool Write(const std::string& data) {
         if (portHandle_ == INVALID_HANDLE_VALUE) {
             std::cerr << "Port is not open" << std::endl;
@@ -242,9 +233,12 @@ private:
             return;
         }
 
-        char buffer[1];
+        // Всё, что накопилось в драйвере, читается одним ReadFile и отдаётся обработчику пачкой
+        char buffer[4096];
         DWORD dwEventMask;
         DWORD dwRead;
+        DWORD dwErrors;
+        COMSTAT stat;
 
         while (true) {
             if (!WaitCommEvent(portHandle_, &dwEventMask, &overlapped)) {
@@ -262,16 +256,20 @@ private:
             }
 
             if (dwEventMask & EV_RXCHAR) {
-                if (ReadFile(portHandle_, buffer, 1, &dwRead, &overlapped)) {
+                DWORD toRead = 1;
+                if (ClearCommError(portHandle_, &dwErrors, &stat) && stat.cbInQue > 0) {
+                    toRead = stat.cbInQue < sizeof(buffer) ? stat.cbInQue : (DWORD)sizeof(buffer);
+                }
+                if (ReadFile(portHandle_, buffer, toRead, &dwRead, &overlapped)) {
                     if (dwRead > 0) {
-                        callback_(buffer[0]);
+                        callback_(buffer, dwRead);
                     }
                 } else {
                     if (GetLastError() == ERROR_IO_PENDING) {
                         WaitForSingleObject(overlapped.hEvent, INFINITE);
                         if (GetOverlappedResult(portHandle_, &overlapped, &dwRead, FALSE)) {
                             if (dwRead > 0) {
-                                callback_(buffer[0]);
+                                callback_(buffer, dwRead);
                             }
                         }
                     } else {
@@ -286,7 +284,201 @@ private:
         CloseHandle(overlapped.hEvent);
     }
 
-    std::function<void(char)> callback_;
+    std::function<void(const char*, size_t)> callback_;
     HANDLE portHandle_;
     std::thread listenerThread_;
-};
\ No newline at end of file
+};
+#else
+// POSIX version: raw 8N1 termios, poll() on the port and on a self-pipe that wakes the reader for close()
+class ComPort {
+public:
+    ComPort(void)
+        :fd_(-1) {
+        wake_[0] = wake_[1] = -1;
+    }
+
+    ComPort(const std::string& portName, size_t baud, std::function<void(const char*, size_t)> callback)
+        : ComPort() {
+        open(portName, baud, callback);
+    }
+
+    ~ComPort() {
+        close();
+    }
+
+    bool open(const std::string& portName, size_t baud, std::function<void(const char*, size_t)> callback) {
+        if (fd_ >= 0)
+            return false;
+
+        callback_ = callback;
+        if (!OpenPort(portName, baud))
+            return false;
+        if (pipe(wake_) != 0) {
+            std::cerr << "Failed to create wake pipe" << std::endl;
+            ::close(fd_);
+            fd_ = -1;
+            return false;
+        }
+        listenerThread_ = std::thread(&ComPort::Listen, this);
+        return true;
+    }
+
+    bool is_opened(void) {
+        return fd_ >= 0;
+    }
+
+    // The reader is stopped before the descriptor is closed, so it never polls a reused number
+    void close()
+    {
+        if (fd_ < 0)
+            return;
+        const char c = 0;
+        if (write(wake_[1], &c, 1) < 0) {
+            std::cerr << "Failed to wake the port reader" << std::endl;
+        }
+        if (listenerThread_.joinable()) {
+            listenerThread_.join();
+        }
+        ::close(wake_[0]);
+        ::close(wake_[1]);
+        wake_[0] = wake_[1] = -1;
+        ::close(fd_);
+        fd_ = -1;
+    }
+
+    // Метод для записи данных в COM-порт
+    bool Write(uint8_t buf[], size_t len) {
+        return WriteAll(buf, len);
+    }
+
+    bool Write(const std::string& data) {
+        return WriteAll(data.data(), data.size());
+    }
+
+    void Write(const unsigned char b) {
+        WriteAll(&b, 1);
+    }
+
+private:
+    bool WriteAll(const void* data, size_t len) {
+        if (fd_ < 0) {
+            std::cerr << "Port is not open" << std::endl;
+            return false;
+        }
+        const char* p = static_cast<const char*>(data);
+        while (len > 0) {
+            const ssize_t written = write(fd_, p, len);
+            if (written < 0) {
+                if (errno == EINTR)
+                    continue;
+                std::cerr << "write failed" << std::endl;
+                return false;
+            }
+            p += written;
+            len -= (size_t)written;
+        }
+        return true;
+    }
+
+    static bool Speed(size_t baud, speed_t* speed) {
+        switch (baud) {
+        case 1200: *speed = B1200; return true;
+        case 2400: *speed = B2400; return true;
+        case 4800: *speed = B4800; return true;
+        case 9600: *speed = B9600; return true;
+        case 19200: *speed = B19200; return true;
+        case 38400: *speed = B38400; return true;
+        case 57600: *speed = B57600; return true;
+        case 115200: *speed = B115200; return true;
+        case 230400: *speed = B230400; return true;
+#ifdef B460800
+        case 460800: *speed = B460800; return true;
+#endif
+#ifdef B921600
+        case 921600: *speed = B921600; return true;
+#endif
+#ifdef B1000000
+        case 1000000: *speed = B1000000; return true;
+#endif
+#ifdef B2000000
+        case 2000000: *speed = B2000000; return true;
+#endif
+#ifdef B3000000
+        case 3000000: *speed = B3000000; return true;
+#endif
+        default: return false;
+        }
+    }
+
+    bool OpenPort(const std::string& portName, size_t baud) {
+        speed_t speed;
+        if (!Speed(baud, &speed)) {
+            std::cerr << "Unsupported baud rate: " << baud << std::endl;
+            return false;
+        }
+        fd_ = ::open(portName.c_str(), O_RDWR | O_NOCTTY | O_CLOEXEC);
+        if (fd_ < 0) {
+            std::cerr << "Failed to open port: " << portName << std::endl;
+            return false;
+        }
+
+        termios tty;
+        if (tcgetattr(fd_, &tty) != 0) {
+            std::cerr << "Failed to get comm state" << std::endl;
+            ::close(fd_);
+            fd_ = -1;
+            return false;
+        }
+        cfmakeraw(&tty);
+        tty.c_cflag |= CLOCAL | CREAD;
+        tty.c_cflag &= ~(CSTOPB | PARENB);
+        // read() after poll() returns what is there, never waits for more
+        tty.c_cc[VMIN] = 0;
+        tty.c_cc[VTIME] = 0;
+        cfsetispeed(&tty, speed);
+        cfsetospeed(&tty, speed);
+        if (tcsetattr(fd_, TCSANOW, &tty) != 0) {
+            std::cerr << "Failed to set comm state" << std::endl;
+            ::close(fd_);
+            fd_ = -1;
+            return false;
+        }
+        tcflush(fd_, TCIOFLUSH);
+        return true;
+    }
+
+    void Listen() {
+        // Всё, что накопилось в драйвере, читается одним read и отдаётся обработчику пачкой
+        char buffer[4096];
+        while (true) {
+            pollfd fds[2] = { { fd_, POLLIN, 0 }, { wake_[0], POLLIN, 0 } };
+            if (poll(fds, 2, -1) < 0) {
+                if (errno == EINTR)
+                    continue;
+                std::cerr << "poll failed" << std::endl;
+                break;
+            }
+            if (fds[1].revents != 0)
+                break; // close()
+            if (fds[0].revents & (POLLIN | POLLHUP | POLLERR)) {
+                const ssize_t n = read(fd_, buffer, sizeof(buffer));
+                if (n > 0) {
+                    callback_(buffer, (size_t)n);
+                } else if (n == 0 || (errno != EINTR && errno != EAGAIN)) {
+                    // the device is gone, the port stays open until close() like on Windows
+                    std::cerr << "Port disconnected" << std::endl;
+                    break;
+                }
+            }
+        }
+    }
+
+    std::function<void(const char*, size_t)> callback_;
+    int fd_;
+    int wake_[2];
+    std::thread listenerThread_;
+};
+
+// termios.h names the hang-up rate B0, as FilterStage names its biquad coefficients
+#undef B0
+#endif
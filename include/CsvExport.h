@@ -0,0 +1,165 @@
+#pragma once
+
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <WorkerPool.h>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Writes columns of floats as CSV or TSV in the background. The rows are split into chunks of
+// ChunkRows; a WorkerPool owned by the export thread formats a batch of chunks at a time into
+// per-chunk buffers with std::to_chars (shortest representation that reads back to the same
+// float, no locale and no locks), then the export thread writes the buffers in row order with
+// one fwrite each. The columns are handed over by value, so the caller may keep appending to
+// its own store while the file is written. Start(), Cancel() and the queries from one thread.
+class CsvExport {
+public:
+    enum {
+        ChunkRows = 16384,
+        MaxField  = 16      // "-1.23456789e-38" and a separator
+    };
+
+    struct Result {
+        bool   Done;
+        bool   Failed;
+        bool   Cancelled;
+        ImU64  Rows;
+        ImU64  Bytes;
+        double Seconds;
+    };
+
+    explicit CsvExport(unsigned threads = 0) : threads_(threads), rows_total_(0), rows_done_(0), cancel_(false), result_() {}
+
+    ~CsvExport() {
+        Cancel();
+        if (thread_.joinable())
+            thread_.join();
+    }
+
+    CsvExport(const CsvExport&) = delete;
+    CsvExport& operator=(const CsvExport&) = delete;
+
+    // `columns` are the same length, `names` go to the header line. False if an export is running.
+    bool Start(const char* filename, std::vector<std::string> names, std::vector<std::vector<float>> columns, char separator = ',') {
+        if (Busy())
+            return false;
+        if (thread_.joinable())
+            thread_.join();
+        rows_total_ = columns.empty() ? 0 : columns[0].size();
+        rows_done_ = 0;
+        cancel_ = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            result_ = Result();
+            filename_ = filename;
+        }
+        thread_ = std::thread(&CsvExport::Run, this, std::string(filename), std::move(names), std::move(columns), separator);
+        return true;
+    }
+
+    void Cancel() { cancel_ = true; }
+
+    bool Busy() const { return thread_.joinable() && !GetResult().Done; }
+
+    // 0..1 of the rows
+    float Progress() const {
+        return rows_total_ == 0 ? 0.0f : (float)((double)rows_done_ / (double)rows_total_);
+    }
+
+    Result GetResult() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return result_;
+    }
+
+    std::string Filename() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return filename_;
+    }
+
+    // Fields of a row, `separator` after all but the last one and '\n' after it. `out` has room
+    // for MaxField bytes per column.
+    static char* FormatRow(const std::vector<std::vector<float>>& columns, size_t row, char separator, char* out) {
+        for (size_t c = 0; c < columns.size(); c++) {
+            const float v = columns[c][row];
+            if (v == v)
+                out = std::to_chars(out, out + MaxField - 1, v).ptr;
+            *out++ = c + 1 == columns.size() ? '\n' : separator; // NaN as an empty field
+        }
+        return out;
+    }
+
+private:
+    struct Batch {
+        const std::vector<std::vector<float>>* Columns;
+        size_t First;        // row of chunk 0
+        size_t Rows;         // rows after First
+        char   Separator;
+        std::vector<std::string>* Buffers;
+    };
+
+    static void FormatChunk(int idx, void* data) {
+        const Batch& batch = *static_cast<const Batch*>(data);
+        const size_t begin = idx * (size_t)ChunkRows, end = ImMin(begin + ChunkRows, batch.Rows);
+        std::string& buf = (*batch.Buffers)[idx];
+        buf.resize((end - begin) * batch.Columns->size() * MaxField);
+        char* out = &buf[0];
+        for (size_t row = begin; row < end; row++)
+            out = FormatRow(*batch.Columns, batch.First + row, batch.Separator, out);
+        buf.resize(out - buf.data());
+    }
+
+    void Run(std::string filename, std::vector<std::string> names, std::vector<std::vector<float>> columns, char separator) {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        Result result = Result();
+        FILE* f = fopen(filename.c_str(), "wb");
+        if (f) {
+            setvbuf(f, nullptr, _IONBF, 0); // chunks are large already
+            std::string header;
+            for (size_t c = 0; c < names.size(); c++)
+                header += names[c] + (c + 1 == names.size() ? '\n' : separator);
+            result.Failed = fwrite(header.data(), 1, header.size(), f) != header.size();
+            result.Bytes = header.size();
+
+            WorkerPool pool(threads_);
+            std::vector<std::string> buffers(2 * pool.threads());
+            const size_t rows = rows_total_, batch_rows = buffers.size() * (size_t)ChunkRows;
+            for (size_t first = 0; first < rows && !result.Failed && !cancel_; first += batch_rows) {
+                Batch batch{ &columns, first, ImMin(batch_rows, rows - first), separator, &buffers };
+                const int chunks = (int)((batch.Rows + ChunkRows - 1) / ChunkRows);
+                pool.ParallelFor(FormatChunk, &batch, chunks);
+                for (int i = 0; i < chunks && !result.Failed; i++) {
+                    result.Failed = fwrite(buffers[i].data(), 1, buffers[i].size(), f) != buffers[i].size();
+                    result.Bytes += buffers[i].size();
+                }
+                result.Rows += batch.Rows;
+                rows_done_ = result.Rows;
+            }
+            result.Failed = fclose(f) != 0 || result.Failed;
+        } else {
+            result.Failed = true;
+        }
+        result.Cancelled = cancel_ && result.Rows < rows_total_;
+        if (result.Cancelled || result.Failed)
+            remove(filename.c_str());
+        result.Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        result.Done = true;
+        std::lock_guard<std::mutex> lock(mutex_);
+        result_ = result;
+    }
+
+    unsigned           threads_;
+    std::thread        thread_;
+    std::atomic<ImU64> rows_total_;
+    std::atomic<ImU64> rows_done_;
+    std::atomic<bool>  cancel_;
+    mutable std::mutex mutex_;     // guards result_ and filename_
+    Result             result_;
+    std::string        filename_;
+};
@@ -0,0 +1,314 @@
+#pragma once
+
+#include <imgui.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstring>
+
+// Decode stage between the port listener threads and the stores. Push() runs on the I/O thread
+// of a stream and only looks for frame delimiters: everything up to the last frame completed by
+// a read becomes a Batch, decoded by a pool of workers (one deque each, idle workers steal).
+// Decoded batches reach the stream's sink strictly in read order through sequence numbers and
+// a reorder window of Window batches; when the window is full Push() waits, which is counted
+// as a stall. The sinks run on the workers and must outlive the pipeline.
+class DecodePipeline {
+public:
+    struct Frame {
+        ImU32 Offset; // into Batch::Data
+        ImU32 Size;
+        int   Status; // 0 for a good frame, otherwise a decoder-defined reason it was rejected
+    };
+
+    struct Batch {
+        int    Stream;
+        ImU64  Seq;
+        ImU64  ReadTime;                  // timestamp passed with the read that completed the frames
+        bool   Truncated;                 // Raw starts inside a frame whose head was dropped (too long)
+        std::vector<unsigned char> Raw;   // as read, ends with a frame delimiter
+        std::vector<unsigned char> Data;  // decoded frames back to back
+        std::vector<Frame> Frames;
+    };
+
+    // Raw -> Data/Frames, on a worker, possibly concurrently with other batches of the stream
+    typedef void (*DecodeFunc)(Batch& batch, void* user_data);
+    // Called in Seq order and never concurrently for one stream, on a worker
+    typedef void (*SinkFunc)(const Batch& batch, void* user_data);
+
+    // Frames end at Delimiter. With Toggles the delimiter alternately opens and closes a frame
+    // (SLIP as used by slip_recv), bytes between frames are dropped right away.
+    struct Framing {
+        unsigned char Delimiter;
+        bool          Toggles;
+    };
+
+    struct Stats {
+        int   Workers;
+        int   Queued;     // batches waiting for a worker
+        int   MaxQueued;
+        ImU64 Batches;
+        ImU64 Frames;     // including rejected ones
+        ImU64 Bytes;
+        ImU64 Stalls;     // Push() calls that waited for the reorder window
+        ImU64 Steals;     // batches decoded by a worker other than the one they were queued on
+        ImU64 Reordered;  // batches decoded before an older batch of their stream
+        ImU64 Dropped;    // bytes of frames longer than MaxCarry
+    };
+
+    enum {
+        Window   = 64,         // batches in flight per stream
+        MaxCarry = 64 * 1024   // longest frame kept across reads
+    };
+
+    // threads = 0 picks one worker less than the number of hardware threads, at least one
+    explicit DecodePipeline(unsigned threads = 0)
+        : next_worker_(0), queued_(0), max_queued_(0), batches_(0), frames_(0), bytes_(0),
+          stalls_(0), steals_(0), reordered_(0), dropped_(0), quit_(false) {
+        if (threads == 0) {
+            unsigned hw = std::thread::hardware_concurrency();
+            threads = hw > 1 ? hw - 1 : 1;
+        }
+        for (unsigned i = 0; i < threads; i++)
+            workers_.emplace_back(new Worker());
+        for (unsigned i = 0; i < threads; i++)
+            workers_[i]->Thread = std::thread(&DecodePipeline::Work, this, (int)i);
+    }
+
+    // Queued batches are still decoded and delivered
+    ~DecodePipeline() {
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            quit_ = true;
+        }
+        wake_.notify_all();
+        for (std::unique_ptr<Worker>& worker : workers_)
+            worker->Thread.join();
+    }
+
+    DecodePipeline(const DecodePipeline&) = delete;
+    DecodePipeline& operator=(const DecodePipeline&) = delete;
+
+    // Before any Push() to the stream
+    int AddStream(Framing framing, DecodeFunc decode, SinkFunc sink, void* user_data) {
+        std::lock_guard<std::mutex> lock(streams_mutex_);
+        Stream* stream = new Stream();
+        stream->Id = (int)streams_.size();
+        stream->Format = framing;
+        stream->Decode = decode;
+        stream->Sink = sink;
+        stream->UserData = user_data;
+        stream->Filling = stream->Acquire();
+        streams_.emplace_back(stream);
+        return stream->Id;
+    }
+
+    // Forgets a partial frame and sets the framing for what follows, e.g. when the port is
+    // reopened. Not concurrently with Push().
+    void ResetStream(int stream, Framing framing) {
+        Stream& s = GetStream(stream);
+        s.Format = framing;
+        s.Filling->Raw.clear();
+        s.Filling->Truncated = false;
+        s.InFrame = false;
+    }
+
+    // I/O thread of the stream: one read as it came from the port
+    void Push(int stream, const void* data, size_t len, ImU64 read_time) {
+        Stream& s = GetStream(stream);
+        const unsigned char* begin = (const unsigned char*)data;
+        const unsigned char* end = begin + len;
+        const unsigned char* cut = begin; // past the last delimiter that ends a frame
+        for (const unsigned char* p = begin; p < end; p++) {
+            p = (const unsigned char*)memchr(p, s.Format.Delimiter, end - p);
+            if (p == nullptr)
+                break;
+            if (!s.Format.Toggles || s.InFrame)
+                cut = p + 1;
+            if (s.Format.Toggles)
+                s.InFrame = !s.InFrame;
+        }
+        bytes_.fetch_add(len, std::memory_order_relaxed);
+        if (cut != begin) {
+            s.Filling->Raw.insert(s.Filling->Raw.end(), begin, cut);
+            s.Filling->ReadTime = read_time;
+            Submit(s);
+        }
+        if (s.Format.Toggles && !s.InFrame)
+            return; // the rest is between frames
+        s.Filling->Raw.insert(s.Filling->Raw.end(), cut, end);
+        if (s.Filling->Raw.size() > MaxCarry) {
+            dropped_.fetch_add(s.Filling->Raw.size(), std::memory_order_relaxed);
+            s.Filling->Raw.clear();
+            s.Filling->Truncated = true;
+        }
+    }
+
+    Stats GetStats() const {
+        Stats stats;
+        stats.Workers = (int)workers_.size();
+        stats.Queued = queued_.load(std::memory_order_relaxed);
+        stats.MaxQueued = max_queued_.load(std::memory_order_relaxed);
+        stats.Batches = batches_.load(std::memory_order_relaxed);
+        stats.Frames = frames_.load(std::memory_order_relaxed);
+        stats.Bytes = bytes_.load(std::memory_order_relaxed);
+        stats.Stalls = stalls_.load(std::memory_order_relaxed);
+        stats.Steals = steals_.load(std::memory_order_relaxed);
+        stats.Reordered = reordered_.load(std::memory_order_relaxed);
+        stats.Dropped = dropped_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+private:
+    struct Stream {
+        int        Id;
+        Framing    Format;
+        DecodeFunc Decode;
+        SinkFunc   Sink;
+        void*      UserData;
+
+        // I/O thread only
+        Batch*     Filling;
+        ImU64      NextSeq = 0;
+        bool       InFrame = false;
+
+        std::mutex Mutex;                 // guards the fields below
+        std::condition_variable Space;    // the reorder window moved
+        Batch*     Pending[Window] = {};  // decoded, waiting for older batches
+        ImU64      NextDeliver = 0;
+        bool       Delivering = false;    // a worker is running the sink
+        std::vector<Batch*> Free;
+        std::vector<std::unique_ptr<Batch>> All;
+
+        // Caller holds Mutex, or the stream is not shared yet
+        Batch* Acquire() {
+            Batch* batch;
+            if (Free.empty()) {
+                All.emplace_back(new Batch());
+                batch = All.back().get();
+            } else {
+                batch = Free.back();
+                Free.pop_back();
+            }
+            batch->Stream = Id;
+            batch->Truncated = false;
+            batch->Raw.clear();
+            batch->Data.clear();
+            batch->Frames.clear();
+            return batch;
+        }
+    };
+
+    struct Worker {
+        std::mutex Mutex;                 // guards Queue
+        std::deque<Batch*> Queue;
+        std::thread Thread;
+    };
+
+    Stream& GetStream(int stream) {
+        std::lock_guard<std::mutex> lock(streams_mutex_);
+        return *streams_[stream];
+    }
+
+    // Hands the filled batch to a worker and starts the next one. I/O thread.
+    void Submit(Stream& s) {
+        Batch* batch = s.Filling;
+        batch->Seq = s.NextSeq++;
+        {
+            std::unique_lock<std::mutex> lock(s.Mutex);
+            if (batch->Seq - s.NextDeliver >= Window) {
+                stalls_.fetch_add(1, std::memory_order_relaxed);
+                s.Space.wait(lock, [&] { return batch->Seq - s.NextDeliver < Window; });
+            }
+            s.Filling = s.Acquire();
+        }
+        batches_.fetch_add(1, std::memory_order_relaxed);
+        Worker& worker = *workers_[next_worker_.fetch_add(1, std::memory_order_relaxed) % workers_.size()];
+        {
+            std::lock_guard<std::mutex> lock(worker.Mutex);
+            worker.Queue.push_back(batch);
+            const int queued = queued_.fetch_add(1, std::memory_order_relaxed) + 1;
+            if (queued > max_queued_.load(std::memory_order_relaxed))
+                max_queued_.store(queued, std::memory_order_relaxed);
+        }
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        wake_.notify_one();
+    }
+
+    // Oldest batch of the worker's own queue, else of the first other queue that has one
+    Batch* Take(int self) {
+        const int count = (int)workers_.size();
+        for (int i = 0; i < count; i++) {
+            Worker& worker = *workers_[(self + i) % count];
+            std::lock_guard<std::mutex> lock(worker.Mutex);
+            if (worker.Queue.empty())
+                continue;
+            Batch* batch = worker.Queue.front();
+            worker.Queue.pop_front();
+            queued_.fetch_sub(1, std::memory_order_relaxed);
+            if (i != 0)
+                steals_.fetch_add(1, std::memory_order_relaxed);
+            return batch;
+        }
+        return nullptr;
+    }
+
+    void Work(int self) {
+        for (;;) {
+            Batch* batch = Take(self);
+            if (batch == nullptr) {
+                std::unique_lock<std::mutex> lock(wake_mutex_);
+                wake_.wait(lock, [&] { return quit_ || queued_.load(std::memory_order_relaxed) > 0; });
+                if (quit_ && queued_.load(std::memory_order_relaxed) == 0)
+                    return;
+                continue;
+            }
+            Stream& s = GetStream(batch->Stream);
+            s.Decode(*batch, s.UserData);
+            frames_.fetch_add(batch->Frames.size(), std::memory_order_relaxed);
+            Complete(s, batch);
+        }
+    }
+
+    // Parks the batch in the reorder window; the worker that fills the gap runs the sink for
+    // every batch that is now in order
+    void Complete(Stream& s, Batch* batch) {
+        std::unique_lock<std::mutex> lock(s.Mutex);
+        s.Pending[batch->Seq % Window] = batch;
+        if (batch->Seq != s.NextDeliver)
+            reordered_.fetch_add(1, std::memory_order_relaxed);
+        if (s.Delivering)
+            return;
+        s.Delivering = true;
+        for (;;) {
+            Batch*& slot = s.Pending[s.NextDeliver % Window];
+            if (slot == nullptr || slot->Seq != s.NextDeliver)
+                break;
+            Batch* ready = slot;
+            slot = nullptr;
+            lock.unlock();
+            s.Sink(*ready, s.UserData);
+            lock.lock();
+            s.NextDeliver++;
+            s.Free.push_back(ready);
+            s.Space.notify_one();
+        }
+        s.Delivering = false;
+    }
+
+    std::mutex streams_mutex_;                   // guards the list, not the streams
+    std::vector<std::unique_ptr<Stream>> streams_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::atomic<unsigned> next_worker_;
+
+    std::atomic<int>   queued_;
+    std::atomic<int>   max_queued_;
+    std::atomic<ImU64> batches_, frames_, bytes_, stalls_, steals_, reordered_, dropped_;
+
+    std::mutex wake_mutex_;                      // guards quit_, pairs with wake_
+    std::condition_variable wake_;
+    bool quit_;
+};
@@ -0,0 +1,617 @@
+#pragma once
+
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Equally sampled channels: source channels appended row by row, and derived channels defined
+// by expressions over other channels, e.g. "sqrt(ax*ax + ay*ay + az*az)" or "(raw - 512) * 0.01".
+// An expression is parsed once and compiled to bytecode for a register machine whose registers
+// are blocks of BlockSize samples. Every instruction runs over a whole block in a plain loop the
+// compiler vectorizes, so the dispatch costs once per block instead of once per sample. Update()
+// evaluates only the rows appended since the last call, derived channels in dependency order;
+// redefining a channel recomputes it and everything that depends on it. When more than twice
+// the capacity is retained the oldest rows are discarded down to the capacity. UI thread only.
+//
+// Grammar: numbers, channel names, + - * / ^ (power), unary minus, parentheses and the
+// functions sqrt abs exp log sin cos (one argument), min max pow (two arguments).
+class DerivedChannels {
+public:
+    enum {
+        BlockSize    = 512,
+        MaxRegisters = 16
+    };
+
+    explicit DerivedChannels(size_t capacity = 1 << 20) : capacity_(capacity), first_(0), rows_(0), version_(0) {
+        name_buf_[0] = expression_buf_[0] = '\0';
+    }
+
+    DerivedChannels(const DerivedChannels&) = delete;
+    DerivedChannels& operator=(const DerivedChannels&) = delete;
+
+    // Before the first row. Returns the channel index, or -1 if the name is taken or not a name.
+    int AddSource(const char* name) {
+        if (!IsName(name) || Find(name) >= 0 || rows_ != 0)
+            return -1;
+        Channel channel;
+        channel.Name = name;
+        channels_.push_back(std::move(channel));
+        sources_.push_back((int)channels_.size() - 1);
+        return (int)channels_.size() - 1;
+    }
+
+    // One value per source channel, in the order they were added
+    void Append(const float* values) {
+        for (size_t i = 0; i < sources_.size(); i++)
+            channels_[sources_[i]].Values.push_back(values[i]);
+        rows_++;
+        if (rows_ - first_ >= 2 * capacity_)
+            Discard(rows_ - first_ - capacity_);
+    }
+
+    // Defines or redefines a derived channel. On error the channel stays as it was.
+    bool Define(const char* name, const char* expression, std::string* error) {
+        if (!IsName(name)) {
+            *error = std::string("'") + name + "' is not a name: letters, digits and '_', not starting with a digit";
+            return false;
+        }
+        int index = Find(name);
+        if (index >= 0 && !channels_[index].Derived) {
+            *error = std::string("'") + name + "' is a source channel";
+            return false;
+        }
+        Program program;
+        if (!Compile(expression, index, &program, error))
+            return false;
+        if (index < 0) {
+            // nothing can refer to a new channel yet, so it cannot close a cycle
+            Channel channel;
+            channel.Name = name;
+            channel.Derived = true;
+            channels_.push_back(std::move(channel));
+            index = (int)channels_.size() - 1;
+        }
+        Channel& channel = channels_[index];
+        std::swap(channel.Code, program);
+        if (!Sort()) {
+            std::swap(channel.Code, program);
+            Sort();
+            *error = "cycle through '" + std::string(name) + "'";
+            return false;
+        }
+        channel.Expression = expression;
+        Invalidate(index);
+        return true;
+    }
+
+    // Derived channels only, and only if no other channel uses them
+    bool Remove(const char* name, std::string* error) {
+        const int index = Find(name);
+        if (index < 0 || !channels_[index].Derived) {
+            *error = std::string("no derived channel '") + name + "'";
+            return false;
+        }
+        for (const Channel& channel : channels_) {
+            for (int input : channel.Code.Inputs) {
+                if (input == index) {
+                    *error = "'" + channel.Name + "' uses '" + name + "'";
+                    return false;
+                }
+            }
+        }
+        channels_.erase(channels_.begin() + index);
+        for (Channel& channel : channels_)
+            for (int& input : channel.Code.Inputs)
+                input -= input > index;
+        for (int& source : sources_)
+            source -= source > index;
+        Sort();
+        return true;
+    }
+
+    // Evaluates the rows appended since the last call
+    void Update() {
+        std::vector<const float*> inputs;
+        for (int index : order_) {
+            Channel& channel = channels_[index];
+            ImU64 end = rows_;
+            for (int input : channel.Code.Inputs)
+                end = ImMin(end, first_ + channels_[input].Values.size());
+            ImU64 row = first_ + channel.Values.size();
+            channel.Values.resize((size_t)(end - first_));
+            for (; row < end; row += BlockSize) {
+                const size_t local = (size_t)(row - first_);
+                const size_t n = (size_t)ImMin((ImU64)BlockSize, end - row);
+                inputs.clear();
+                for (int input : channel.Code.Inputs)
+                    inputs.push_back(channels_[input].Values.data() + local);
+                Run(channel.Code, inputs.data(), n, channel.Values.data() + local);
+            }
+        }
+    }
+
+    // What an expression can refer to: [A-Za-z_][A-Za-z0-9_]*. Also keeps CSV headers and
+    // ImGui labels of the channels unambiguous.
+    static bool IsName(const char* name) {
+        if (*name == '\0' || (*name >= '0' && *name <= '9'))
+            return false;
+        for (; *name != '\0'; name++)
+            if (!Parser::IsNameChar(*name))
+                return false;
+        return true;
+    }
+
+    int Find(const char* name) const {
+        for (size_t i = 0; i < channels_.size(); i++)
+            if (channels_[i].Name == name)
+                return (int)i;
+        return -1;
+    }
+
+    int Count() const { return (int)channels_.size(); }
+    const char* Name(int channel) const { return channels_[channel].Name.c_str(); }
+    const char* Expression(int channel) const { return channels_[channel].Expression.c_str(); } // "" for a source
+    bool IsDerived(int channel) const { return channels_[channel].Derived; }
+    unsigned Version(int channel) const { return channels_[channel].Version; }
+
+    // Retained values, the first one is row FirstRow(). Derived channels have fewer until Update().
+    const float* Values(int channel) const { return channels_[channel].Values.data(); }
+    size_t Size(int channel) const { return channels_[channel].Values.size(); }
+    ImU64 FirstRow() const { return first_; }
+    ImU64 Rows() const { return rows_; }
+
+    // List of channels and an editor for derived ones
+    void Draw(const char* title, bool* p_open = nullptr) {
+        if (!ImGui::Begin(title, p_open)) {
+            ImGui::End();
+            return;
+        }
+        if (ImGui::BeginTable("channels", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+            ImGui::TableSetupColumn("Name", ImGuiTableColumnFlags_WidthFixed, ImGui::GetFontSize() * 8);
+            ImGui::TableSetupColumn("Expression");
+            ImGui::TableSetupColumn("", ImGuiTableColumnFlags_WidthFixed);
+            ImGui::TableHeadersRow();
+            int remove = -1;
+            for (int i = 0; i < Count(); i++) {
+                ImGui::PushID(i);
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(Name(i));
+                ImGui::TableNextColumn();
+                if (IsDerived(i)) {
+                    ImGui::TextUnformatted(Expression(i));
+                    ImGui::TableNextColumn();
+                    if (ImGui::SmallButton("Edit")) {
+                        ImFormatString(name_buf_, IM_ARRAYSIZE(name_buf_), "%s", Name(i));
+                        ImFormatString(expression_buf_, IM_ARRAYSIZE(expression_buf_), "%s", Expression(i));
+                    }
+                    ImGui::SameLine();
+                    if (ImGui::SmallButton("Remove"))
+                        remove = i;
+                } else {
+                    ImGui::TextDisabled("source");
+                    ImGui::TableNextColumn();
+                }
+                ImGui::PopID();
+            }
+            ImGui::EndTable();
+            if (remove >= 0 && Remove(Name(remove), &error_))
+                error_.clear();
+        }
+        ImGui::SetNextItemWidth(ImGui::GetFontSize() * 8);
+        ImGui::InputText("##name", name_buf_, IM_ARRAYSIZE(name_buf_));
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(-ImGui::GetFontSize() * 4);
+        const bool enter = ImGui::InputText("##expression", expression_buf_, IM_ARRAYSIZE(expression_buf_), ImGuiInputTextFlags_EnterReturnsTrue);
+        ImGui::SameLine();
+        if ((ImGui::Button("Define") || enter) && Define(name_buf_, expression_buf_, &error_))
+            error_.clear();
+        if (!error_.empty())
+            ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "%s", error_.c_str());
+        ImGui::End();
+    }
+
+private:
+    enum Op {
+        Op_Const, Op_Neg, Op_Abs, Op_Sqrt, Op_Exp, Op_Log, Op_Sin, Op_Cos,
+        Op_Add, Op_Sub, Op_Mul, Op_Div, Op_Min, Op_Max, Op_Pow,
+        Op_AddK, Op_MulK, Op_SubK, Op_KSub, Op_DivK, Op_KDiv // with the constant K on one side
+    };
+
+    // Operand slots below MaxRegisters are registers, MaxRegisters + i is Program::Inputs[i]
+    struct Instr {
+        Op    Code;
+        int   Dst, A, B;
+        float K;
+    };
+
+    struct Program {
+        std::vector<Instr> Code;
+        std::vector<int>   Inputs;    // channel indices
+        int                Result = 0;    // slot holding the value after the last instruction
+        int                Registers = 0; // used
+    };
+
+    struct Channel {
+        std::string        Name;
+        bool               Derived = false;
+        unsigned           Version = 0;  // changes when the values are recomputed from the start
+        std::string        Expression;
+        Program            Code;
+        std::vector<float> Values;
+    };
+
+    enum NodeKind { Node_Number, Node_Input, Node_Unary, Node_Binary };
+
+    struct Node {
+        NodeKind Kind;
+        Op       Code;
+        float    Value;  // Node_Number
+        int      Input;  // Node_Input: index into Program::Inputs
+        int      Left, Right;
+    };
+
+    struct Parser {
+        DerivedChannels* Owner;
+        int              Self;    // channel being defined, -1 if new
+        const char*      P;
+        std::vector<Node>* Nodes;
+        Program*         Target;
+        std::string      Error;
+
+        void SkipSpace() {
+            while (*P == ' ' || *P == '\t')
+                P++;
+        }
+
+        bool Accept(char c) {
+            SkipSpace();
+            if (*P != c)
+                return false;
+            P++;
+            return true;
+        }
+
+        int Add(Node node) {
+            Nodes->push_back(node);
+            return (int)Nodes->size() - 1;
+        }
+
+        int Number(float value) {
+            return Add(Node{ Node_Number, Op_Const, value, -1, -1, -1 });
+        }
+
+        // Folds constants, so only nodes with a non-constant operand are kept
+        int Unary(Op op, int a) {
+            const Node& x = (*Nodes)[a];
+            if (x.Kind == Node_Number)
+                return Number(Apply(op, x.Value, 0.0f));
+            return Add(Node{ Node_Unary, op, 0.0f, -1, a, -1 });
+        }
+
+        int Binary(Op op, int a, int b) {
+            if (a < 0 || b < 0)
+                return -1;
+            const Node& x = (*Nodes)[a];
+            const Node& y = (*Nodes)[b];
+            if (x.Kind == Node_Number && y.Kind == Node_Number)
+                return Number(Apply(op, x.Value, y.Value));
+            return Add(Node{ Node_Binary, op, 0.0f, -1, a, b });
+        }
+
+        int Fail(const char* message) {
+            if (Error.empty())
+                Error = message;
+            return -1;
+        }
+
+        // expr := term (('+' | '-') term)*
+        int Expr() {
+            int a = Term();
+            while (a >= 0) {
+                if (Accept('+'))
+                    a = Binary(Op_Add, a, Term());
+                else if (Accept('-'))
+                    a = Binary(Op_Sub, a, Term());
+                else
+                    break;
+            }
+            return a;
+        }
+
+        // term := unary (('*' | '/') unary)*
+        int Term() {
+            int a = UnaryExpr();
+            while (a >= 0) {
+                if (Accept('*'))
+                    a = Binary(Op_Mul, a, UnaryExpr());
+                else if (Accept('/'))
+                    a = Binary(Op_Div, a, UnaryExpr());
+                else
+                    break;
+            }
+            return a;
+        }
+
+        // unary := '-' unary | primary ('^' unary)?
+        int UnaryExpr() {
+            if (Accept('-')) {
+                const int a = UnaryExpr();
+                return a < 0 ? -1 : Unary(Op_Neg, a);
+            }
+            const int a = Primary();
+            if (a >= 0 && Accept('^'))
+                return Binary(Op_Pow, a, UnaryExpr());
+            return a;
+        }
+
+        int Primary() {
+            SkipSpace();
+            if (Accept('(')) {
+                const int a = Expr();
+                if (a >= 0 && !Accept(')'))
+                    return Fail("missing ')'");
+                return a;
+            }
+            if ((*P >= '0' && *P <= '9') || *P == '.') {
+                char* end;
+                const float value = (float)strtod(P, &end);
+                if (end == P)
+                    return Fail("bad number");
+                P = end;
+                return Number(value);
+            }
+            if (!IsNameChar(*P) || (*P >= '0' && *P <= '9'))
+                return Fail(*P == '\0' ? "unexpected end" : "unexpected character");
+            const char* begin = P;
+            while (IsNameChar(*P))
+                P++;
+            const std::string name(begin, P);
+            if (Accept('('))
+                return Call(name);
+            const int channel = Owner->Find(name.c_str());
+            if (channel < 0 || channel == Self) {
+                Error = channel < 0 ? "unknown channel '" + name + "'" : "'" + name + "' refers to itself";
+                return -1;
+            }
+            int input = 0;
+            while (input < (int)Target->Inputs.size() && Target->Inputs[input] != channel)
+                input++;
+            if (input == (int)Target->Inputs.size())
+                Target->Inputs.push_back(channel);
+            return Add(Node{ Node_Input, Op_Const, 0.0f, input, -1, -1 });
+        }
+
+        int Call(const std::string& name) {
+            static const struct { const char* Name; Op Code; int Args; } functions[] = {
+                { "sqrt", Op_Sqrt, 1 }, { "abs", Op_Abs, 1 }, { "exp", Op_Exp, 1 }, { "log", Op_Log, 1 },
+                { "sin", Op_Sin, 1 }, { "cos", Op_Cos, 1 }, { "min", Op_Min, 2 }, { "max", Op_Max, 2 }, { "pow", Op_Pow, 2 },
+            };
+            for (const auto& f : functions) {
+                if (name != f.Name)
+                    continue;
+                const int a = Expr();
+                if (a < 0)
+                    return -1;
+                int result;
+                if (f.Args == 2) {
+                    if (!Accept(','))
+                        return Fail("expected ','");
+                    result = Binary(f.Code, a, Expr());
+                } else {
+                    result = Unary(f.Code, a);
+                }
+                if (result >= 0 && !Accept(')'))
+                    return Fail("missing ')'");
+                return result;
+            }
+            Error = "unknown function '" + name + "'";
+            return -1;
+        }
+
+        static bool IsNameChar(char c) {
+            return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+        }
+    };
+
+    // Scalar semantics of every operation, used for constant folding
+    static float Apply(Op op, float a, float b) {
+        switch (op) {
+        case Op_Neg:  return -a;
+        case Op_Abs:  return fabsf(a);
+        case Op_Sqrt: return sqrtf(a);
+        case Op_Exp:  return expf(a);
+        case Op_Log:  return logf(a);
+        case Op_Sin:  return sinf(a);
+        case Op_Cos:  return cosf(a);
+        case Op_Add:  return a + b;
+        case Op_Sub:  return a - b;
+        case Op_Mul:  return a * b;
+        case Op_Div:  return a / b;
+        case Op_Min:  return a < b ? a : b;
+        case Op_Max:  return a > b ? a : b;
+        case Op_Pow:  return powf(a, b);
+        default:      return 0.0f;
+        }
+    }
+
+    bool Compile(const char* expression, int self, Program* program, std::string* error) {
+        std::vector<Node> nodes;
+        Parser parser = { this, self, expression, &nodes, program, std::string() };
+        const int root = parser.Expr();
+        parser.SkipSpace();
+        if (root >= 0 && *parser.P != '\0')
+            parser.Fail("unexpected character");
+        if (root < 0 || !parser.Error.empty()) {
+            *error = parser.Error + " at " + std::to_string(parser.P - expression);
+            return false;
+        }
+        int next = 0;
+        program->Registers = 0;
+        program->Result = Emit(nodes, root, program, &next);
+        if (program->Result < 0) {
+            *error = "expression too deep";
+            return false;
+        }
+        return true;
+    }
+
+    // Post-order code generation. Registers are allocated as a stack: the result of an
+    // operation reuses the register of its first operand when it has one.
+    static int Emit(const std::vector<Node>& nodes, int n, Program* program, int* next) {
+        const Node& node = nodes[n];
+        if (node.Kind == Node_Input)
+            return MaxRegisters + node.Input;
+        if (node.Kind == Node_Number) {
+            const int dst = Alloc(program, next);
+            if (dst >= 0)
+                program->Code.push_back(Instr{ Op_Const, dst, -1, -1, node.Value });
+            return dst;
+        }
+        if (node.Kind == Node_Binary) {
+            const Node& left = nodes[node.Left];
+            const Node& right = nodes[node.Right];
+            Op op = node.Code;
+            int other = -1;
+            float k = 0.0f;
+            if (right.Kind == Node_Number && (op == Op_Add || op == Op_Mul || op == Op_Sub || op == Op_Div)) {
+                other = node.Left;
+                k = right.Value;
+                op = op == Op_Add ? Op_AddK : op == Op_Mul ? Op_MulK : op == Op_Sub ? Op_SubK : Op_DivK;
+            } else if (left.Kind == Node_Number && (op == Op_Add || op == Op_Mul || op == Op_Sub || op == Op_Div)) {
+                other = node.Right;
+                k = left.Value;
+                op = op == Op_Add ? Op_AddK : op == Op_Mul ? Op_MulK : op == Op_Sub ? Op_KSub : Op_KDiv;
+            }
+            if (other >= 0) {
+                const int a = Emit(nodes, other, program, next);
+                const int dst = a < 0 ? -1 : a < MaxRegisters ? a : Alloc(program, next);
+                if (dst >= 0)
+                    program->Code.push_back(Instr{ op, dst, a, -1, k });
+                return dst;
+            }
+            const int a = Emit(nodes, node.Left, program, next);
+            const int b = a < 0 ? -1 : Emit(nodes, node.Right, program, next);
+            if (b < 0)
+                return -1;
+            int dst = a < MaxRegisters ? a : b < MaxRegisters ? b : Alloc(program, next);
+            if (dst < 0)
+                return -1;
+            program->Code.push_back(Instr{ op, dst, a, b, 0.0f });
+            if (b < MaxRegisters && b != dst)
+                (*next)--; // b was allocated after a, so it is on top
+            return dst;
+        }
+        const int a = Emit(nodes, node.Left, program, next);
+        const int dst = a < 0 ? -1 : a < MaxRegisters ? a : Alloc(program, next);
+        if (dst >= 0)
+            program->Code.push_back(Instr{ node.Code, dst, a, -1, 0.0f });
+        return dst;
+    }
+
+    static int Alloc(Program* program, int* next) {
+        if (*next == MaxRegisters)
+            return -1;
+        program->Registers = ImMax(program->Registers, *next + 1);
+        return (*next)++;
+    }
+
+    // Runs the program over `n` <= BlockSize rows
+    void Run(const Program& program, const float* const* inputs, size_t n, float* out) {
+        registers_.resize(MaxRegisters * BlockSize);
+        float* reg = registers_.data();
+        for (const Instr& in : program.Code) {
+            float* d = reg + in.Dst * BlockSize;
+            const float* a = in.A < 0 ? nullptr : in.A < MaxRegisters ? reg + in.A * BlockSize : inputs[in.A - MaxRegisters];
+            const float* b = in.B < 0 ? nullptr : in.B < MaxRegisters ? reg + in.B * BlockSize : inputs[in.B - MaxRegisters];
+            const float k = in.K;
+            switch (in.Code) {
+            case Op_Const: for (size_t i = 0; i < n; i++) d[i] = k; break;
+            case Op_Neg:   for (size_t i = 0; i < n; i++) d[i] = -a[i]; break;
+            case Op_Abs:   for (size_t i = 0; i < n; i++) d[i] = fabsf(a[i]); break;
+            case Op_Sqrt:  for (size_t i = 0; i < n; i++) d[i] = sqrtf(a[i]); break;
+            case Op_Exp:   for (size_t i = 0; i < n; i++) d[i] = expf(a[i]); break;
+            case Op_Log:   for (size_t i = 0; i < n; i++) d[i] = logf(a[i]); break;
+            case Op_Sin:   for (size_t i = 0; i < n; i++) d[i] = sinf(a[i]); break;
+            case Op_Cos:   for (size_t i = 0; i < n; i++) d[i] = cosf(a[i]); break;
+            case Op_Add:   for (size_t i = 0; i < n; i++) d[i] = a[i] + b[i]; break;
+            case Op_Sub:   for (size_t i = 0; i < n; i++) d[i] = a[i] - b[i]; break;
+            case Op_Mul:   for (size_t i = 0; i < n; i++) d[i] = a[i] * b[i]; break;
+            case Op_Div:   for (size_t i = 0; i < n; i++) d[i] = a[i] / b[i]; break;
+            case Op_Min:   for (size_t i = 0; i < n; i++) d[i] = a[i] < b[i] ? a[i] : b[i]; break;
+            case Op_Max:   for (size_t i = 0; i < n; i++) d[i] = a[i] > b[i] ? a[i] : b[i]; break;
+            case Op_Pow:   for (size_t i = 0; i < n; i++) d[i] = powf(a[i], b[i]); break;
+            case Op_AddK:  for (size_t i = 0; i < n; i++) d[i] = a[i] + k; break;
+            case Op_MulK:  for (size_t i = 0; i < n; i++) d[i] = a[i] * k; break;
+            case Op_SubK:  for (size_t i = 0; i < n; i++) d[i] = a[i] - k; break;
+            case Op_KSub:  for (size_t i = 0; i < n; i++) d[i] = k - a[i]; break;
+            case Op_DivK:  for (size_t i = 0; i < n; i++) d[i] = a[i] / k; break;
+            case Op_KDiv:  for (size_t i = 0; i < n; i++) d[i] = k / a[i]; break;
+            }
+        }
+        const int r = program.Result;
+        memcpy(out, r < MaxRegisters ? reg + r * BlockSize : inputs[r - MaxRegisters], n * sizeof(float));
+    }
+
+    // Derived channels in dependency order, false on a cycle
+    bool Sort() {
+        order_.clear();
+        std::vector<int> state(channels_.size(), 0); // 0 new, 1 on the path, 2 done
+        for (size_t i = 0; i < channels_.size(); i++)
+            if (!Visit((int)i, state))
+                return false;
+        return true;
+    }
+
+    bool Visit(int index, std::vector<int>& state) {
+        if (state[index] == 2)
+            return true;
+        if (state[index] == 1)
+            return false;
+        state[index] = 1;
+        for (int input : channels_[index].Code.Inputs)
+            if (!Visit(input, state))
+                return false;
+        state[index] = 2;
+        if (channels_[index].Derived)
+            order_.push_back(index);
+        return true;
+    }
+
+    // Drops the values of `index` and of every channel that depends on it
+    void Invalidate(int index) {
+        std::vector<bool> dirty(channels_.size(), false);
+        dirty[index] = true;
+        for (int i : order_) {
+            for (int input : channels_[i].Code.Inputs)
+                dirty[i] = dirty[i] || dirty[input];
+            if (dirty[i]) {
+                channels_[i].Values.clear();
+                channels_[i].Version = ++version_;
+            }
+        }
+    }
+
+    void Discard(ImU64 count) {
+        for (Channel& channel : channels_)
+            channel.Values.erase(channel.Values.begin(), channel.Values.begin() + (size_t)ImMin((ImU64)channel.Values.size(), count));
+        first_ += count;
+    }
+
+    const size_t capacity_;
+    ImU64 first_;                  // row of Values[0]
+    ImU64 rows_;                   // rows ever appended
+    unsigned version_;             // last Channel::Version handed out
+    std::vector<Channel> channels_;
+    std::vector<int> sources_;     // channel indices in Append() order
+    std::vector<int> order_;       // derived channels, inputs first
+    std::vector<float> registers_; // Run() scratch, MaxRegisters blocks
+
+    char name_buf_[64];            // editor of Draw()
+    char expression_buf_[256];
+    std::string error_;
+};
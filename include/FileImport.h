@@ -0,0 +1,520 @@
+#pragma once
+
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <WorkerPool.h>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Offline view of a recorded CSV/TSV file or raw serial dump of SLIP frames, without reading it
+// into memory. The file is split into chunks of ChunkBytes; a record (line or frame) belongs to
+// the chunk its first byte is in, so every chunk is parsed on its own from a mapped view of the
+// chunk and MaxRecord bytes past it. A background thread with its own WorkerPool parses the
+// chunks a batch at a time, straight into columns (std::from_chars, no row objects), and keeps
+// only the sparse index: rows and time range per chunk. Columns of at most CacheChunks chunks
+// are held (the first ones after Open(), then the most recently used), others are parsed again
+// when Get() asks for them, so memory stays bounded whatever the file size. Chunks are usable
+// as soon as they are indexed, the first screen does not wait for the whole file.
+//
+// CSV: a header line is detected when its first field is not a number; separator ',', '\t' or
+// ';' from the first line; time is the column named "t" or "time", otherwise the first one.
+// Empty or malformed fields are NaN. SLIP dump: one row per frame with its decoded size; time
+// is the 32-bit microsecond counter at the start of the frame (unwrapped) or the frame index.
+// Open(), Close(), Get() and the queries from one thread.
+class FileImport {
+public:
+    enum Format {
+        Format_Csv,
+        Format_SlipDump
+    };
+
+    enum {
+        ChunkBytes  = 4 << 20,
+        MaxRecord   = 1 << 20,  // longer lines and frames are cut
+        CacheChunks = 32
+    };
+
+    // One chunk of rows: Time[i] and Columns[c][i]
+    struct Data {
+        std::vector<double>             Time;
+        std::vector<std::vector<float>> Columns;
+    };
+
+    // Sparse index entry, valid for chunks below Indexed()
+    struct ChunkInfo {
+        ImU64  FirstRow;
+        int    Rows;
+        double FirstTime, LastTime; // NaN if the chunk has no rows
+    };
+
+    explicit FileImport(unsigned threads = 0) : threads_(threads), quit_(false), indexed_(0) { Close(); }
+
+    ~FileImport() { Close(); }
+
+    FileImport(const FileImport&) = delete;
+    FileImport& operator=(const FileImport&) = delete;
+
+    // Maps the file and starts indexing. `device_timestamps` applies to SLIP dumps.
+    bool Open(const char* filename, Format format, bool device_timestamps, std::string* error) {
+        Close();
+        if (!file_.Open(filename)) {
+            *error = std::string("cannot open ") + filename;
+            return false;
+        }
+        format_ = format;
+        timestamps_ = device_timestamps;
+        if (format == Format_Csv && !ReadHeader(error)) {
+            file_.Close();
+            return false;
+        }
+        if (format == Format_SlipDump) {
+            time_name_ = timestamps_ ? "device_t" : "frame";
+            names_.assign(1, "size");
+        }
+        const ImU64 count = (file_.Size() + ChunkBytes - 1) / ChunkBytes;
+        chunks_.assign((size_t)count, Chunk());
+        quit_ = false;
+        thread_ = std::thread(&FileImport::IndexAll, this);
+        return true;
+    }
+
+    void Close() {
+        quit_ = true;
+        if (thread_.joinable())
+            thread_.join();
+        file_.Close();
+        chunks_.clear();
+        indexed_ = 0;
+        names_.clear();
+        time_name_.clear();
+        header_end_ = 0;
+        separator_ = ',';
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        cache_.clear();
+        use_clock_ = 0;
+    }
+
+    bool IsOpen() const { return file_.Size() != 0; }
+    ImU64 FileSize() const { return file_.Size(); }
+    int ChunkCount() const { return (int)chunks_.size(); }
+    int Indexed() const { return indexed_; }
+    bool Done() const { return indexed_ == (int)chunks_.size(); }
+    const char* TimeName() const { return time_name_.c_str(); }
+    int ColumnCount() const { return (int)names_.size(); }
+    const char* ColumnName(int column) const { return names_[column].c_str(); }
+    const ChunkInfo& Info(int chunk) const { return chunks_[chunk].Info; }
+
+    ImU64 IndexedRows() const {
+        const int n = indexed_;
+        return n == 0 ? 0 : chunks_[n - 1].Info.FirstRow + chunks_[n - 1].Info.Rows;
+    }
+
+    // First indexed chunk whose rows reach time `t`, Indexed() if none
+    int Seek(double t) const {
+        const int n = indexed_;
+        int lo = 0, hi = n;
+        while (lo < hi) {
+            const int mid = (lo + hi) / 2;
+            const ChunkInfo& info = chunks_[mid].Info;
+            if (info.Rows == 0 || info.LastTime < t)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo;
+    }
+
+    // Columns of a chunk below Indexed(), from the cache or parsed now
+    std::shared_ptr<const Data> Get(int chunk) {
+        {
+            std::lock_guard<std::mutex> lock(cache_mutex_);
+            for (CacheEntry& entry : cache_) {
+                if (entry.Chunk == chunk) {
+                    entry.Used = ++use_clock_;
+                    return entry.Rows;
+                }
+            }
+        }
+        std::shared_ptr<Data> data = std::make_shared<Data>();
+        Parse(chunk, data.get());
+        Finish(chunk, data.get());
+        Cache(chunk, data);
+        return data;
+    }
+
+private:
+    // Read-only view of part of a file, mapped on demand
+    class MappedFile {
+    public:
+        MappedFile() : size_(0), granularity_(1) {
+#ifdef _WIN32
+            file_ = INVALID_HANDLE_VALUE;
+            mapping_ = nullptr;
+            SYSTEM_INFO info;
+            GetSystemInfo(&info);
+            granularity_ = info.dwAllocationGranularity;
+#else
+            fd_ = -1;
+            granularity_ = (ImU64)sysconf(_SC_PAGESIZE);
+#endif
+        }
+
+        ~MappedFile() { Close(); }
+
+        bool Open(const char* filename) {
+            Close();
+#ifdef _WIN32
+            file_ = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING,
+                                FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            LARGE_INTEGER size;
+            if (file_ == INVALID_HANDLE_VALUE || !GetFileSizeEx(file_, &size)) {
+                Close();
+                return false;
+            }
+            size_ = (ImU64)size.QuadPart;
+            mapping_ = size_ != 0 ? CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+            if (size_ != 0 && !mapping_) {
+                Close();
+                return false;
+            }
+#else
+            fd_ = open(filename, O_RDONLY);
+            struct stat st;
+            if (fd_ < 0 || fstat(fd_, &st) != 0) {
+                Close();
+                return false;
+            }
+            size_ = (ImU64)st.st_size;
+#endif
+            return true;
+        }
+
+        void Close() {
+#ifdef _WIN32
+            if (mapping_)
+                CloseHandle(mapping_);
+            if (file_ != INVALID_HANDLE_VALUE)
+                CloseHandle(file_);
+            mapping_ = nullptr;
+            file_ = INVALID_HANDLE_VALUE;
+#else
+            if (fd_ >= 0)
+                close(fd_);
+            fd_ = -1;
+#endif
+            size_ = 0;
+        }
+
+        ImU64 Size() const { return size_; }
+
+        // Maps [begin, end) clipped to the file; `*base` points at `begin`. Unmap() with the view.
+        void* Map(ImU64 begin, ImU64 end, const char** base, size_t* length) const {
+            end = ImMin(end, size_);
+            const ImU64 aligned = begin / granularity_ * granularity_;
+            *length = (size_t)(end - aligned);
+            void* view = nullptr;
+#ifdef _WIN32
+            view = MapViewOfFile(mapping_, FILE_MAP_READ, (DWORD)(aligned >> 32), (DWORD)aligned, *length);
+#else
+            view = mmap(nullptr, *length, PROT_READ, MAP_PRIVATE, fd_, (off_t)aligned);
+            if (view == MAP_FAILED)
+                view = nullptr;
+            else
+                madvise(view, *length, MADV_SEQUENTIAL);
+#endif
+            *base = view ? (const char*)view + (begin - aligned) : nullptr;
+            return view;
+        }
+
+        void Unmap(void* view, size_t length) const {
+#ifdef _WIN32
+            (void)length;
+            UnmapViewOfFile(view);
+#else
+            munmap(view, length);
+#endif
+        }
+
+    private:
+        ImU64 size_;
+        ImU64 granularity_;
+#ifdef _WIN32
+        HANDLE file_;
+        HANDLE mapping_;
+#else
+        int fd_;
+#endif
+    };
+
+    struct Chunk {
+        ChunkInfo Info = { 0, 0, NAN, NAN };
+        ImU32 LastUs = 0;              // device counter of the last frame up to this chunk, SLIP dumps
+        ImU32 Wraps = 0;               // of the counter from the first frame of the file to LastUs
+    };
+
+    struct CacheEntry {
+        int   Chunk;
+        ImU64 Used;
+        std::shared_ptr<const Data> Rows;
+    };
+
+    struct Batch {
+        FileImport* Import;
+        int First;
+        std::vector<std::shared_ptr<Data>>* Out;
+    };
+
+    enum {
+        SLIP_END     = 0xC0,
+        SLIP_ESC     = 0xDB,
+        SLIP_ESC_END = 0xDC,
+        SLIP_ESC_ESC = 0xDD
+    };
+
+    static bool IsNumber(const char* p, const char* end) {
+        while (p < end && (*p == ' ' || *p == '"'))
+            p++;
+        double v;
+        return std::from_chars(p, end, v).ec == std::errc();
+    }
+
+    // Field from `p` to the separator or the end of the line; returns the position after it
+    template <typename T>
+    static const char* Field(const char* p, const char* end, char separator, T* out) {
+        while (p < end && (*p == ' ' || *p == '"'))
+            p++;
+        const std::from_chars_result r = std::from_chars(p, end, *out);
+        if (r.ec != std::errc())
+            *out = (T)NAN;
+        p = r.ec == std::errc() ? r.ptr : p;
+        while (p < end && *p != separator)
+            p++;
+        return p < end ? p + 1 : p;
+    }
+
+    bool ReadHeader(std::string* error) {
+        const char* base;
+        size_t length;
+        void* view = file_.Map(0, MaxRecord, &base, &length);
+        if (!view) {
+            *error = file_.Size() == 0 ? "empty file" : "cannot map the file";
+            return false;
+        }
+        const char* end = (const char*)memchr(base, '\n', length);
+        end = end ? end : base + length;
+        const char* line_end = end > base && end[-1] == '\r' ? end - 1 : end;
+        separator_ = memchr(base, '\t', line_end - base) ? '\t' : memchr(base, ';', line_end - base) ? ';' : ',';
+        std::vector<std::string> fields;
+        for (const char* p = base; p <= line_end;) {
+            const char* q = p;
+            while (q < line_end && *q != separator_)
+                q++;
+            std::string field(p, q);
+            field.erase(std::remove(field.begin(), field.end(), '"'), field.end());
+            fields.push_back(field);
+            p = q + 1;
+        }
+        const bool header = !IsNumber(base, line_end);
+        header_end_ = header ? (ImU64)(end - base) + 1 : 0;
+        for (size_t i = 0; i < fields.size(); i++)
+            fields[i] = header ? fields[i] : "c" + std::to_string(i);
+        file_.Unmap(view, length);
+        time_column_ = 0;
+        for (size_t i = 0; i < fields.size(); i++) {
+            std::string lower = fields[i];
+            std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return (char)tolower(c); });
+            if (lower == "t" || lower == "time") {
+                time_column_ = (int)i;
+                break;
+            }
+        }
+        time_name_ = fields[time_column_];
+        fields.erase(fields.begin() + time_column_);
+        names_ = fields;
+        return true;
+    }
+
+    // Rows of the chunk with chunk-local time: SLIP counters unwrapped from zero wraps, frame index from 0
+    void Parse(int chunk, Data* data) const {
+        const ImU64 begin = (ImU64)chunk * ChunkBytes, end = ImMin(begin + ChunkBytes, file_.Size());
+        const char delimiter = format_ == Format_Csv ? '\n' : (char)SLIP_END;
+        // the record owning `begin` starts after the delimiter before it
+        const ImU64 view_begin = begin == 0 ? 0 : begin - 1;
+        const char* base;
+        size_t length;
+        void* view = file_.Map(view_begin, end + MaxRecord, &base, &length);
+        data->Columns.assign(names_.size(), std::vector<float>());
+        if (!view)
+            return;
+        const char* p = base;
+        const char* view_end = base + (ImMin(end + MaxRecord, file_.Size()) - view_begin);
+        const char* owned_end = base + (end - view_begin);
+        if (begin != 0) {
+            p = (const char*)memchr(p, delimiter, owned_end - p);
+            p = p ? p + 1 : owned_end;
+        } else if (format_ == Format_Csv) {
+            p += ImMin(header_end_, end);
+        }
+        const size_t reserve = (owned_end - p) / (format_ == Format_Csv ? 8 * (names_.size() + 1) : 16);
+        data->Time.reserve(reserve);
+        for (std::vector<float>& column : data->Columns)
+            column.reserve(reserve);
+        while (p < owned_end) {
+            const char* record_end = (const char*)memchr(p, delimiter, view_end - p);
+            record_end = record_end ? record_end : view_end;
+            if (format_ == Format_Csv)
+                ParseLine(p, record_end > p && record_end[-1] == '\r' ? record_end - 1 : record_end, data);
+            else
+                ParseFrame((const unsigned char*)p, (const unsigned char*)record_end, data);
+            p = record_end + 1;
+        }
+        file_.Unmap(view, length);
+    }
+
+    void ParseLine(const char* p, const char* end, Data* data) const {
+        if (p == end)
+            return;
+        const int columns = (int)names_.size() + 1;
+        double time = NAN;
+        for (int c = 0, column = 0; c < columns; c++) {
+            if (c == time_column_) {
+                p = Field(p, end, separator_, &time);
+                continue;
+            }
+            float v = NAN;
+            p = Field(p, end, separator_, &v);
+            data->Columns[column++].push_back(v);
+        }
+        data->Time.push_back(time);
+    }
+
+    void ParseFrame(const unsigned char* p, const unsigned char* end, Data* data) const {
+        if (p == end)
+            return;
+        unsigned char head[4];
+        size_t size = 0;
+        for (; p < end; p++, size++) {
+            unsigned char c = *p;
+            if (c == SLIP_ESC && p + 1 < end)
+                c = *++p == SLIP_ESC_END ? (unsigned char)SLIP_END : *p == SLIP_ESC_ESC ? (unsigned char)SLIP_ESC : *p;
+            if (size < 4)
+                head[size] = c;
+        }
+        double time = (double)data->Time.size();
+        if (timestamps_) {
+            if (size < 4)
+                return;
+            const ImU32 us = head[0] | (head[1] << 8) | (head[2] << 16) | ((ImU32)head[3] << 24);
+            // chunk-local unwrapping: the high part counts wraps since the first frame of the chunk
+            const ImU64 last = data->Time.empty() ? us : (ImU64)data->Time.back();
+            ImU64 unwrapped = (last & ~0xFFFFFFFFull) | us;
+            if (unwrapped < last)
+                unwrapped += 1ull << 32;
+            time = (double)unwrapped;
+        }
+        data->Time.push_back(time);
+        data->Columns[0].push_back((float)size);
+    }
+
+    // Chunk-local time to file time: seconds of the unwrapped device counter, or the global frame index
+    void Finish(int chunk, Data* data) const {
+        if (format_ != Format_SlipDump)
+            return;
+        const Chunk& info = chunks_[chunk];
+        const double wraps_before = (double)(info.Wraps - (data->Time.empty() ? 0 : (ImU64)data->Time.back() >> 32));
+        for (double& t : data->Time)
+            t = timestamps_ ? (t + wraps_before * 4294967296.0) * 1e-6 : t + (double)info.Info.FirstRow;
+    }
+
+    void Cache(int chunk, const std::shared_ptr<const Data>& data) {
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        if ((int)cache_.size() < CacheChunks) {
+            cache_.push_back(CacheEntry{ chunk, ++use_clock_, data });
+            return;
+        }
+        CacheEntry* oldest = &cache_[0];
+        for (CacheEntry& entry : cache_)
+            oldest = entry.Used < oldest->Used ? &entry : oldest;
+        *oldest = CacheEntry{ chunk, ++use_clock_, data };
+    }
+
+    static void ParseJob(int idx, void* data) {
+        const Batch& batch = *static_cast<const Batch*>(data);
+        batch.Import->Parse(batch.First + idx, (*batch.Out)[idx].get());
+    }
+
+    // Background thread: parses batches of chunks in parallel, indexes them in order
+    void IndexAll() {
+        WorkerPool pool(threads_);
+        std::vector<std::shared_ptr<Data>> out(pool.threads());
+        const int count = (int)chunks_.size();
+        for (int first = 0; first < count && !quit_; first += (int)out.size()) {
+            const int n = ImMin((int)out.size(), count - first);
+            for (int i = 0; i < n; i++)
+                out[i] = std::make_shared<Data>();
+            Batch batch{ this, first, &out };
+            pool.ParallelFor(ParseJob, &batch, n);
+            for (int i = 0; i < n; i++) {
+                const int c = first + i;
+                Data& data = *out[i];
+                Chunk& chunk = chunks_[c];
+                const Chunk* prev = c > 0 ? &chunks_[c - 1] : nullptr;
+                chunk.Info.Rows = (int)data.Time.size();
+                chunk.Info.FirstRow = prev ? prev->Info.FirstRow + prev->Info.Rows : 0;
+                if (format_ == Format_SlipDump && timestamps_ && !data.Time.empty()) {
+                    // wraps before the chunk: the earlier ones and one between the chunks, then its own
+                    const ImU32 first_us = (ImU32)(ImU64)data.Time.front();
+                    const ImU32 before = chunk.Info.FirstRow == 0 ? 0 : prev->Wraps + (first_us < prev->LastUs ? 1 : 0);
+                    chunk.LastUs = (ImU32)(ImU64)data.Time.back();
+                    chunk.Wraps = before + (ImU32)((ImU64)data.Time.back() >> 32);
+                } else if (prev) {
+                    chunk.LastUs = prev->LastUs;
+                    chunk.Wraps = prev->Wraps;
+                }
+                Finish(c, &data);
+                if (!data.Time.empty()) {
+                    chunk.Info.FirstTime = data.Time.front();
+                    chunk.Info.LastTime = data.Time.back();
+                }
+                if (c < CacheChunks)
+                    Cache(c, out[i]);
+                out[i].reset();
+                indexed_ = c + 1;
+            }
+        }
+    }
+
+    unsigned           threads_;
+    MappedFile         file_;
+    Format             format_;
+    bool               timestamps_;
+    char               separator_;
+    ImU64              header_end_;  // first byte after the CSV header line
+    int                time_column_;
+    std::string        time_name_;
+    std::vector<std::string> names_; // without the time column
+    std::vector<Chunk> chunks_;      // entries below indexed_ belong to the UI thread
+    std::thread        thread_;
+    std::atomic<bool>  quit_;
+    std::atomic<int>   indexed_;
+    std::mutex         cache_mutex_; // guards cache_ and use_clock_
+    std::vector<CacheEntry> cache_;
+    ImU64              use_clock_;
+};
@@ -0,0 +1,270 @@
+#pragma once
+
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+// Filter stage between ingestion and the channel store: per channel a cascade of biquads in
+// transposed direct form II, then for all channels together an optional FIR decimator that only
+// computes the outputs it keeps (the polyphase form of decimation). Channels are processed in
+// groups of Lanes: the coefficients and state of a section are laid out across the lanes, so a
+// step of a section is one fixed-width loop over four channels that the compiler turns into
+// SIMD operations. Process() takes rows of all channels at once, as they are appended, and
+// works through a block of rows group by group.
+//
+// Coefficients are designed in place: Butterworth and Chebyshev type I low- and high-pass by
+// the bilinear transform with prewarping (each pole pair becomes one biquad), a notch after the
+// RBJ audio EQ cookbook and a Blackman windowed-sinc low-pass for decimation.
+class FilterStage {
+public:
+    enum {
+        Lanes       = 4,
+        MaxSections = 8,    // orders up to 16
+        MaxOrder    = 2 * MaxSections
+    };
+
+    enum Type {
+        Type_None,
+        Type_ButterworthLowPass,
+        Type_ButterworthHighPass,
+        Type_ChebyshevLowPass,
+        Type_ChebyshevHighPass,
+        Type_Notch,
+        Type_COUNT
+    };
+
+    struct Design {
+        Type   Kind     = Type_None;
+        int    Order    = 2;
+        double Cutoff   = 5.0;  // Hz; centre frequency of the notch
+        double RippleDb = 1.0;  // Chebyshev pass band ripple
+        double Q        = 10.0; // notch
+    };
+
+    // Normalised so that a0 = 1
+    struct Biquad {
+        double B0, B1, B2, A1, A2;
+    };
+
+    static const char* TypeName(Type type) {
+        static const char* names[Type_COUNT] = { "None", "Butterworth low-pass", "Butterworth high-pass",
+                                                 "Chebyshev low-pass", "Chebyshev high-pass", "Notch" };
+        return names[type];
+    }
+
+    // Writes up to MaxSections sections, returns how many
+    static int DesignBiquads(const Design& design, double sample_rate, Biquad* out) {
+        const double nyquist = sample_rate * 0.5;
+        const double fc = ImClamp(design.Cutoff, nyquist * 1e-6, nyquist * 0.999);
+        if (design.Kind == Type_None)
+            return 0;
+        if (design.Kind == Type_Notch) {
+            const double w = 2.0 * IM_PI * fc / sample_rate, alpha = sin(w) / (2.0 * design.Q);
+            out[0] = Normalize(1.0, -2.0 * cos(w), 1.0, 1.0 + alpha, -2.0 * cos(w), 1.0 - alpha);
+            return 1;
+        }
+        const int order = ImClamp(design.Order, 1, (int)MaxOrder);
+        const bool high = design.Kind == Type_ButterworthHighPass || design.Kind == Type_ChebyshevHighPass;
+        const bool chebyshev = design.Kind == Type_ChebyshevLowPass || design.Kind == Type_ChebyshevHighPass;
+        // analog prototype poles with cutoff 1: -sigma +- j omega, radius r
+        const double eps = sqrt(pow(10.0, ImMax(design.RippleDb, 0.01) / 10.0) - 1.0);
+        const double v = chebyshev ? asinh(1.0 / eps) / order : 0.0;
+        const double warped = tan(IM_PI * fc / sample_rate); // prewarped cutoff, in units of 2 fs
+        int count = 0;
+        for (int k = 0; k < order / 2; k++) {
+            const double theta = IM_PI * (2 * k + 1) / (2.0 * order);
+            const double sigma = chebyshev ? sinh(v) * sin(theta) : sin(theta);
+            const double omega = chebyshev ? cosh(v) * cos(theta) : cos(theta);
+            const double r = sqrt(sigma * sigma + omega * omega), q = r / (2.0 * sigma);
+            // low-pass to high-pass maps the pole radius r to 1/r and keeps Q
+            const double w = 2.0 * atan(high ? warped / r : warped * r);
+            const double alpha = sin(w) / (2.0 * q), c = cos(w);
+            if (high)
+                out[count++] = Normalize((1.0 + c) / 2.0, -(1.0 + c), (1.0 + c) / 2.0, 1.0 + alpha, -2.0 * c, 1.0 - alpha);
+            else
+                out[count++] = Normalize((1.0 - c) / 2.0, 1.0 - c, (1.0 - c) / 2.0, 1.0 + alpha, -2.0 * c, 1.0 - alpha);
+        }
+        if (order % 2 == 1) {
+            // real pole: first order section through the bilinear transform
+            const double p = chebyshev ? sinh(v) : 1.0;
+            const double a = high ? warped / p : warped * p;
+            if (high)
+                out[count++] = Biquad{ 1.0 / (1.0 + a), -1.0 / (1.0 + a), 0.0, (a - 1.0) / (a + 1.0), 0.0 };
+            else
+                out[count++] = Biquad{ a / (1.0 + a), a / (1.0 + a), 0.0, (a - 1.0) / (a + 1.0), 0.0 };
+        }
+        if (chebyshev && order % 2 == 0) {
+            // even orders start the ripple at its bottom: the pass band peaks at 0 dB
+            const double g = 1.0 / sqrt(1.0 + eps * eps);
+            out[0].B0 *= g, out[0].B1 *= g, out[0].B2 *= g;
+        }
+        return count;
+    }
+
+    // Magnitude response of a cascade at `f` Hz
+    static double Response(const Biquad* sections, int count, double f, double sample_rate) {
+        const double w = 2.0 * IM_PI * f / sample_rate;
+        double gain = 1.0;
+        for (int i = 0; i < count; i++) {
+            const Biquad& s = sections[i];
+            // H(z) at z = e^jw, numerator and denominator as complex numbers
+            const double nr = s.B0 + s.B1 * cos(w) + s.B2 * cos(2 * w), ni = -s.B1 * sin(w) - s.B2 * sin(2 * w);
+            const double dr = 1.0 + s.A1 * cos(w) + s.A2 * cos(2 * w), di = -s.A1 * sin(w) - s.A2 * sin(2 * w);
+            gain *= sqrt((nr * nr + ni * ni) / (dr * dr + di * di));
+        }
+        return gain;
+    }
+
+    // Low-pass at 0.8 of the output Nyquist frequency, unity gain at DC
+    static void DesignDecimator(int factor, int taps, std::vector<float>* h) {
+        h->resize(taps);
+        const double cutoff = 0.4 / factor; // of the input sample rate
+        double sum = 0.0;
+        for (int i = 0; i < taps; i++) {
+            const double n = i - (taps - 1) * 0.5;
+            const double sinc = n == 0.0 ? 2.0 * cutoff : sin(2.0 * IM_PI * cutoff * n) / (IM_PI * n);
+            const double window = taps == 1 ? 1.0 : 0.42 - 0.5 * cos(2.0 * IM_PI * i / (taps - 1)) + 0.08 * cos(4.0 * IM_PI * i / (taps - 1));
+            (*h)[i] = (float)(sinc * window);
+            sum += (*h)[i];
+        }
+        for (float& tap : *h)
+            tap = (float)(tap / sum);
+    }
+
+    FilterStage() : channels_(0), decimation_(1), phase_(0), pos_(0) {}
+
+    // `designs` has one entry per channel. Decimation by `decimation` (1 for none) uses a FIR of
+    // 8 taps per output phase. Resets the state.
+    void Configure(int channels, const Design* designs, double sample_rate, int decimation) {
+        channels_ = channels;
+        const int groups = (channels + Lanes - 1) / Lanes;
+        groups_.assign(groups, Group());
+        for (int c = 0; c < channels; c++) {
+            Biquad sections[MaxSections];
+            const int count = DesignBiquads(designs[c], sample_rate, sections);
+            Group& group = groups_[c / Lanes];
+            group.Sections = ImMax(group.Sections, count);
+            for (int s = 0; s < count; s++) {
+                Section& section = group.Coefs[s];
+                const int lane = c % Lanes;
+                section.B0[lane] = (float)sections[s].B0;
+                section.B1[lane] = (float)sections[s].B1;
+                section.B2[lane] = (float)sections[s].B2;
+                section.A1[lane] = (float)sections[s].A1;
+                section.A2[lane] = (float)sections[s].A2;
+            }
+        }
+        decimation_ = ImMax(decimation, 1);
+        fir_.clear();
+        if (decimation_ > 1)
+            DesignDecimator(decimation_, 8 * decimation_ + 1, &fir_);
+        for (Group& group : groups_)
+            group.History.assign(2 * fir_.size() * Lanes, 0.0f);
+        Reset();
+    }
+
+    void Reset() {
+        for (Group& group : groups_) {
+            memset(group.S1, 0, sizeof(group.S1));
+            memset(group.S2, 0, sizeof(group.S2));
+            std::fill(group.History.begin(), group.History.end(), 0.0f);
+        }
+        phase_ = 0;
+        pos_ = 0;
+    }
+
+    int Channels() const { return channels_; }
+    int Decimation() const { return decimation_; }
+    int Delay() const { return fir_.empty() ? 0 : (int)(fir_.size() - 1) / 2; } // of the FIR, in input rows
+
+    // `rows` rows of Channels() values in, at most rows / Decimation() + 1 rows out (same layout).
+    // Returns the number of rows written. `out` may be `in`.
+    int Process(const float* in, int rows, float* out) {
+        const int taps = (int)fir_.size();
+        int written = 0;
+        for (size_t g = 0; g < groups_.size(); g++) {
+            Group& group = groups_[g];
+            const int first = (int)g * Lanes, lanes = ImMin((int)Lanes, channels_ - first);
+            int phase = phase_, pos = pos_;
+            written = 0;
+            for (int row = 0; row < rows; row++) {
+                float x[Lanes] = {};
+                for (int l = 0; l < lanes; l++)
+                    x[l] = in[row * channels_ + first + l];
+                for (int s = 0; s < group.Sections; s++) {
+                    const Section& c = group.Coefs[s];
+                    float* s1 = group.S1[s];
+                    float* s2 = group.S2[s];
+                    float y[Lanes];
+                    for (int l = 0; l < Lanes; l++)
+                        y[l] = c.B0[l] * x[l] + s1[l];
+                    for (int l = 0; l < Lanes; l++)
+                        s1[l] = c.B1[l] * x[l] - c.A1[l] * y[l] + s2[l];
+                    for (int l = 0; l < Lanes; l++)
+                        s2[l] = c.B2[l] * x[l] - c.A2[l] * y[l];
+                    for (int l = 0; l < Lanes; l++)
+                        x[l] = y[l];
+                }
+                if (taps == 0) {
+                    for (int l = 0; l < lanes; l++)
+                        out[written * channels_ + first + l] = x[l];
+                    written++;
+                    continue;
+                }
+                // history twice over, so that the last `taps` rows are always contiguous
+                float* history = group.History.data();
+                memcpy(history + pos * Lanes, x, sizeof(x));
+                memcpy(history + (pos + taps) * Lanes, x, sizeof(x));
+                pos = pos + 1 == taps ? 0 : pos + 1;
+                if (++phase < decimation_)
+                    continue;
+                phase = 0;
+                const float* window = history + pos * Lanes; // oldest first
+                float acc[Lanes] = {};
+                for (int k = 0; k < taps; k++) {
+                    const float h = fir_[taps - 1 - k];
+                    for (int l = 0; l < Lanes; l++)
+                        acc[l] += h * window[k * Lanes + l];
+                }
+                for (int l = 0; l < lanes; l++)
+                    out[written * channels_ + first + l] = acc[l];
+                written++;
+            }
+            if (g + 1 == groups_.size())
+                phase_ = phase, pos_ = pos;
+        }
+        return written;
+    }
+
+private:
+    // Identity until designed: B0 = 1 passes the lane through
+    struct Section {
+        float B0[Lanes], B1[Lanes], B2[Lanes], A1[Lanes], A2[Lanes];
+
+        Section() {
+            for (int l = 0; l < Lanes; l++)
+                B0[l] = 1.0f, B1[l] = B2[l] = A1[l] = A2[l] = 0.0f;
+        }
+    };
+
+    struct Group {
+        int     Sections = 0;
+        Section Coefs[MaxSections];
+        float   S1[MaxSections][Lanes], S2[MaxSections][Lanes];
+        std::vector<float> History; // FIR input, 2 * taps rows of Lanes
+    };
+
+    static Biquad Normalize(double b0, double b1, double b2, double a0, double a1, double a2) {
+        return Biquad{ b0 / a0, b1 / a0, b2 / a0, a1 / a0, a2 / a0 };
+    }
+
+    int channels_;
+    int decimation_;
+    int phase_;                  // input rows since the last output
+    int pos_;                    // next history row
+    std::vector<float> fir_;
+    std::vector<Group> groups_;
+};
@@ -0,0 +1,244 @@
+#pragma once
+
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <mutex>
+#include <vector>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// Allocator for ImGui/ImPlot (ImGui::SetAllocatorFunctions) plus a per-frame bump arena.
+// Blocks up to MaxPooledSize are taken from power-of-two size classes and recycled, so the
+// ImVector growth pattern (capacity * 1.5, rounded by the class) reaches a steady state
+// without going to malloc. Small classes are carved out of slabs. Pooled memory is only
+// given back to the system in the destructor, which must run after ImGui::DestroyContext().
+// Alloc()/Free() are thread-safe (ImPlot worker threads grow their own draw lists), the
+// arena and NewFrame() belong to the UI thread.
+class FrameAllocator {
+public:
+    struct Stats {
+        int    Allocs;       // allocations during the frame
+        int    Frees;        // frees during the frame
+        int    SystemAllocs; // of which had to go to malloc (slab refills and large blocks)
+        size_t Bytes;        // bytes requested during the frame
+        size_t LiveBytes;    // bytes held by ImGui at the end of the frame
+        size_t PeakBytes;    // highest LiveBytes during the frame
+        size_t ArenaBytes;   // bytes taken from the frame arena
+    };
+
+    explicit FrameAllocator(size_t arena_size = 64 * 1024)
+        : live_(0), arena_pos_(0), arena_used_(0), arena_peak_(0) {
+        memset(free_, 0, sizeof(free_));
+        memset(&frame_, 0, sizeof(frame_));
+        memset(&last_, 0, sizeof(last_));
+        arena_.push_back(Block{ (char*)malloc(arena_size), arena_size });
+    }
+
+    ~FrameAllocator() {
+        for (void* slab : slabs_) {
+            free(slab);
+        }
+        for (int c = SlabClasses; c < Classes; c++) {
+            for (Header* h = free_[c]; h != nullptr; ) {
+                Header* next = h->Next;
+                free(h);
+                h = next;
+            }
+        }
+        for (Block& block : arena_) {
+            free(block.Data);
+        }
+    }
+
+    FrameAllocator(const FrameAllocator&) = delete;
+    FrameAllocator& operator=(const FrameAllocator&) = delete;
+
+    // Call before ImGui::CreateContext()
+    void Install() {
+        ImGui::SetAllocatorFunctions(&FrameAllocator::AllocFunc, &FrameAllocator::FreeFunc, this);
+    }
+
+    // Closes the frame statistics and releases the arena, call once before ImGui::NewFrame()
+    void NewFrame() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            frame_.LiveBytes = live_;
+            frame_.ArenaBytes = arena_used_;
+            last_ = frame_;
+            memset(&frame_, 0, sizeof(frame_));
+            frame_.PeakBytes = live_;
+        }
+        // an overflowing frame leaves several blocks, replace them with one that fits the peak
+        if (arena_.size() > 1) {
+            size_t size = 0;
+            for (Block& block : arena_) {
+                size += block.Size;
+                free(block.Data);
+            }
+            arena_.clear();
+            size = ImMax(size, arena_peak_);
+            arena_.push_back(Block{ (char*)malloc(size), size });
+        }
+        arena_used_ = 0;
+        arena_pos_ = 0;
+    }
+
+    // Statistics of the last finished frame
+    const Stats& LastFrame() const {
+        return last_;
+    }
+
+    // Transient memory valid until the next NewFrame(), e.g. sample slices for plotting
+    void* FrameAlloc(size_t size, size_t align = 16) {
+        Block* block = &arena_.back();
+        size_t pos = (arena_pos_ + align - 1) & ~(align - 1);
+        if (pos + size > block->Size) {
+            const size_t grow = ImMax(size + align, block->Size * 2);
+            arena_.push_back(Block{ (char*)malloc(grow), grow });
+            block = &arena_.back();
+            pos = 0;
+        }
+        arena_pos_ = pos + size;
+        arena_used_ += size;
+        arena_peak_ = ImMax(arena_peak_, arena_used_);
+        return block->Data + pos;
+    }
+
+    template <typename T>
+    T* FrameAlloc(int count) {
+        return (T*)FrameAlloc(sizeof(T) * count, alignof(T));
+    }
+
+    // printf into the frame arena, the string is valid until the next NewFrame()
+    const char* Format(const char* fmt, ...) IM_FMTARGS(2) {
+        va_list args;
+        va_start(args, fmt);
+        va_list args2;
+        va_copy(args2, args);
+        char* buf = (char*)FrameAlloc(256, 1);
+        int len = vsnprintf(buf, 256, fmt, args);
+        if (len >= 256) {
+            // the arena does not shrink mid-frame, so just take a second, large enough piece
+            buf = (char*)FrameAlloc(len + 1, 1);
+            vsnprintf(buf, len + 1, fmt, args2);
+        }
+        va_end(args2);
+        va_end(args);
+        return buf;
+    }
+
+private:
+    enum {
+        MinShift      = 4,               // 16 byte class, also the header size
+        Classes       = 17,              // 16 B .. 1 MB
+        SlabClasses   = 9,               // 16 B .. 4 KB are carved out of slabs
+        SlabSize      = 64 * 1024
+    };
+    static const size_t MaxPooledSize = (size_t)1 << (MinShift + Classes - 1);
+
+    // Precedes every block, keeps the user pointer 16-byte aligned
+    struct alignas(16) Header {
+        union {
+            size_t  Size;  // requested size
+            Header* Next;  // while on a free list
+        };
+        int Class;         // size class, or -1 for blocks from malloc
+    };
+
+    struct Block {
+        char*  Data;
+        size_t Size;
+    };
+
+    static int SizeClass(size_t size) {
+        int c = 0;
+        while (((size_t)1 << (MinShift + c)) < size) {
+            c++;
+        }
+        return c;
+    }
+
+    void* Alloc(size_t size) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        frame_.Allocs++;
+        frame_.Bytes += size;
+        live_ += size;
+        if (live_ > frame_.PeakBytes) {
+            frame_.PeakBytes = live_;
+        }
+        Header* h;
+        if (size > MaxPooledSize) {
+            frame_.SystemAllocs++;
+            h = (Header*)malloc(sizeof(Header) + size);
+            h->Class = -1;
+        } else {
+            const int c = SizeClass(size);
+            if (free_[c] == nullptr) {
+                Refill(c);
+            }
+            h = free_[c];
+            free_[c] = h->Next;
+            h->Class = c;
+        }
+        h->Size = size;
+        return h + 1;
+    }
+
+    void Free(void* ptr) {
+        if (ptr == nullptr) {
+            return;
+        }
+        Header* h = (Header*)ptr - 1;
+        std::lock_guard<std::mutex> lock(mutex_);
+        frame_.Frees++;
+        live_ -= h->Size;
+        const int c = h->Class;
+        if (c < 0) {
+            free(h);
+            return;
+        }
+        h->Next = free_[c];
+        free_[c] = h;
+    }
+
+    // Puts at least one block of class `c` on its free list. Caller holds mutex_.
+    void Refill(int c) {
+        frame_.SystemAllocs++;
+        const size_t block = sizeof(Header) + ((size_t)1 << (MinShift + c));
+        if (c >= SlabClasses) {
+            Header* h = (Header*)malloc(block);
+            h->Next = nullptr;
+            free_[c] = h;
+            return;
+        }
+        char* slab = (char*)malloc(SlabSize);
+        slabs_.push_back(slab);
+        for (size_t pos = 0; pos + block <= SlabSize; pos += block) {
+            Header* h = (Header*)(slab + pos);
+            h->Next = free_[c];
+            free_[c] = h;
+        }
+    }
+
+    static void* AllocFunc(size_t size, void* user_data) {
+        return static_cast<FrameAllocator*>(user_data)->Alloc(size);
+    }
+
+    static void FreeFunc(void* ptr, void* user_data) {
+        static_cast<FrameAllocator*>(user_data)->Free(ptr);
+    }
+
+    std::mutex mutex_;            // guards the pools and frame_
+    Header* free_[Classes];
+    std::vector<void*> slabs_;
+    size_t live_;
+    Stats frame_;
+    Stats last_;
+
+    std::vector<Block> arena_;    // the last block is the one being filled
+    size_t arena_pos_;
+    size_t arena_used_;
+    size_t arena_peak_;
+};
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <cstring>
+
+#ifdef IMGUI_USE_LEGACY_CRC32_ADLER
+#error "FrameCheck::Crc32c() relies on ImHashData() computing CRC-32C"
+#endif
+
+// Optional integrity trailer of a frame: CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF, no
+// reflection, check value 0x29B1) or CRC-32C (Castagnoli, check value 0xE3069283), computed over
+// the payload and appended little-endian before SLIP escaping. CRC-32C is ImHashData() with
+// seed 0, which uses the crc32 instruction (SSE 4.2, runtime dispatch) or slice-by-8 tables.
+// CRC-16 uses its own slice-by-8 tables.
+class FrameCheck {
+public:
+    enum Type {
+        Type_None,
+        Type_Crc16,
+        Type_Crc32c,
+        Type_COUNT
+    };
+
+    static const char* Name(Type type) {
+        static const char* names[Type_COUNT] = { "None", "CRC-16/CCITT", "CRC-32C" };
+        return names[type];
+    }
+
+    static size_t TrailerSize(Type type) {
+        return type == Type_Crc16 ? 2 : type == Type_Crc32c ? 4 : 0;
+    }
+
+    static ImU16 Crc16Ccitt(const void* data, size_t size, ImU16 crc = 0xFFFF) {
+        const ImU16 (*t)[256] = Crc16Tables().Slice;
+        const unsigned char* p = (const unsigned char*)data;
+        for (; size >= 8; p += 8, size -= 8) {
+            crc = t[7][(crc >> 8) ^ p[0]] ^ t[6][(crc & 0xFF) ^ p[1]] ^ t[5][p[2]] ^ t[4][p[3]] ^
+                  t[3][p[4]] ^ t[2][p[5]] ^ t[1][p[6]] ^ t[0][p[7]];
+        }
+        while (size-- != 0)
+            crc = (ImU16)(crc << 8) ^ t[0][(crc >> 8) ^ *p++];
+        return crc;
+    }
+
+    static ImU32 Crc32c(const void* data, size_t size) {
+        return ImHashData(data, size, 0);
+    }
+
+    // Checks and strips the trailer, `size` becomes the payload size
+    static bool Verify(Type type, const unsigned char* frame, size_t* size) {
+        const size_t trailer = TrailerSize(type);
+        if (trailer == 0)
+            return true;
+        if (*size < trailer)
+            return false;
+        *size -= trailer;
+        const unsigned char* t = frame + *size;
+        if (type == Type_Crc16)
+            return Crc16Ccitt(frame, *size) == (ImU16)(t[0] | (t[1] << 8));
+        return Crc32c(frame, *size) == ((ImU32)t[0] | ((ImU32)t[1] << 8) | ((ImU32)t[2] << 16) | ((ImU32)t[3] << 24));
+    }
+
+    // Writes the trailer of `frame` to `out` (TrailerSize() bytes)
+    static void Trailer(Type type, const void* frame, size_t size, unsigned char* out) {
+        if (type == Type_Crc16) {
+            const ImU16 crc = Crc16Ccitt(frame, size);
+            out[0] = (unsigned char)crc;
+            out[1] = (unsigned char)(crc >> 8);
+        } else if (type == Type_Crc32c) {
+            const ImU32 crc = Crc32c(frame, size);
+            for (int i = 0; i < 4; i++)
+                out[i] = (unsigned char)(crc >> (8 * i));
+        }
+    }
+
+private:
+    // Slice[k][b]: CRC contribution of byte b followed by k zero bytes
+    struct Tables {
+        ImU16 Slice[8][256];
+
+        Tables() {
+            for (int i = 0; i < 256; i++) {
+                ImU16 crc = (ImU16)(i << 8);
+                for (int bit = 0; bit < 8; bit++)
+                    crc = (crc & 0x8000) ? (ImU16)((crc << 1) ^ 0x1021) : (ImU16)(crc << 1);
+                Slice[0][i] = crc;
+            }
+            for (int k = 1; k < 8; k++)
+                for (int i = 0; i < 256; i++)
+                    Slice[k][i] = (ImU16)(Slice[k - 1][i] << 8) ^ Slice[0][Slice[k - 1][i] >> 8];
+        }
+    };
+
+    static const Tables& Crc16Tables() {
+        static const Tables tables;
+        return tables;
+    }
+};
@@ -0,0 +1,226 @@
+#pragma once
+
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <implot.h>
+#include <ProfileZone.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Window for the zones of ProfileZone.h: a timeline of the last finished frame (one lane per
+// nesting level, threads stacked) and the inclusive time per zone name. The frame is the last
+// top-level zone named "Frame". Capture() writes the last N seconds as Chrome trace JSON for
+// chrome://tracing / Perfetto, CheckCaptureKey() does that on F9 while the window is closed too.
+class FrameProfiler {
+public:
+    FrameProfiler() : paused_(false), capture_seconds_(5.0f), captures_(0), frame_begin_(0), frame_end_(0) {}
+
+    FrameProfiler(const FrameProfiler&) = delete;
+    FrameProfiler& operator=(const FrameProfiler&) = delete;
+
+    // Call once per frame after ImGui::NewFrame()
+    void CheckCaptureKey(ImGuiKey key = ImGuiKey_F9) {
+        if (ImGui::IsKeyPressed(key, false))
+            CaptureToFile();
+    }
+
+    // Writes the zones that ended during the last `seconds`
+    bool Capture(const char* filename, double seconds) {
+        std::vector<ProfileZones::Zone> zones;
+        const uint64_t now = ProfileZones::Now();
+        const uint64_t span = (uint64_t)(seconds * 1e9);
+        ProfileZones::Get().Collect(now > span ? now - span : 0, zones);
+        const std::vector<std::string> threads = ProfileZones::Get().Threads();
+        FILE* f = fopen(filename, "wb");
+        if (f == nullptr)
+            return false;
+        uint64_t origin = now;
+        for (const ProfileZones::Zone& zone : zones)
+            origin = ImMin(origin, zone.Begin);
+        fprintf(f, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+        for (size_t t = 0; t < threads.size(); t++) {
+            fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                    t == 0 ? "" : ",\n", (int)t + 1, threads[t].c_str());
+        }
+        for (const ProfileZones::Zone& zone : zones) {
+            fprintf(f, ",\n{\"name\":\"%s\",\"cat\":\"zone\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d}",
+                    zone.Name, (zone.Begin - origin) * 1e-3, (zone.End - zone.Begin) * 1e-3, zone.Thread + 1);
+        }
+        fprintf(f, "\n]}\n");
+        return fclose(f) == 0;
+    }
+
+    void Draw(const char* title, bool* p_open = nullptr) {
+        if (!ImGui::Begin(title, p_open)) {
+            ImGui::End();
+            return;
+        }
+        bool enabled = ProfileZones::Get().Enabled();
+        if (ImGui::Checkbox("Enabled", &enabled))
+            ProfileZones::Get().SetEnabled(enabled);
+        ImGui::SameLine();
+        ImGui::Checkbox("Pause", &paused_);
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(ImGui::GetFontSize() * 8);
+        ImGui::SliderFloat("##seconds", &capture_seconds_, 1.0f, 20.0f, "%.0f s");
+        ImGui::SameLine();
+        if (ImGui::Button("Capture (F9)"))
+            CaptureToFile();
+        if (!capture_status_.empty()) {
+            ImGui::SameLine();
+            ImGui::TextUnformatted(capture_status_.c_str());
+        }
+
+        if (!paused_)
+            Refresh();
+        if (frame_end_ == 0) {
+            ImGui::TextDisabled("No \"Frame\" zone recorded");
+            ImGui::End();
+            return;
+        }
+        const double frame_ms = (frame_end_ - frame_begin_) * 1e-6;
+        ImGui::Text("Frame %.3f ms, %d zones", frame_ms, (int)zones_.size());
+
+        // one lane per nesting level, threads one below the other
+        std::vector<int> lane_base(thread_names_.size() + 1, 0);
+        for (const ProfileZones::Zone& zone : zones_)
+            lane_base[zone.Thread + 1] = ImMax(lane_base[zone.Thread + 1], zone.Depth + 1);
+        for (size_t t = 1; t < lane_base.size(); t++)
+            lane_base[t] += lane_base[t - 1];
+        const int lanes = ImMax(lane_base.back(), 1);
+        tick_pos_.clear();
+        tick_labels_.clear();
+        for (size_t t = 0; t + 1 < lane_base.size(); t++) {
+            if (lane_base[t + 1] > lane_base[t]) {
+                tick_pos_.push_back(lane_base[t] + 0.5);
+                tick_labels_.push_back(thread_names_[t].c_str());
+            }
+        }
+
+        const float lane_height = ImGui::GetFrameHeight();
+        const float plot_height = lane_height * lanes + ImGui::GetTextLineHeightWithSpacing() * 2 + ImGui::GetStyle().WindowPadding.y * 2;
+        if (ImPlot::BeginPlot("##timeline", ImVec2(-1, plot_height), ImPlotFlags_NoLegend | ImPlotFlags_NoMenus)) {
+            ImPlot::SetupAxes("ms", nullptr, ImPlotAxisFlags_None, ImPlotAxisFlags_Invert | ImPlotAxisFlags_NoGridLines | ImPlotAxisFlags_Lock);
+            ImPlot::SetupAxisLimits(ImAxis_X1, 0, frame_ms, paused_ ? ImPlotCond_Once : ImPlotCond_Always);
+            ImPlot::SetupAxisLimits(ImAxis_Y1, 0, lanes, ImPlotCond_Always);
+            if (!tick_pos_.empty())
+                ImPlot::SetupAxisTicks(ImAxis_Y1, tick_pos_.data(), (int)tick_pos_.size(), tick_labels_.data());
+            ImPlot::PushPlotClipRect();
+            ImDrawList* draw_list = ImPlot::GetPlotDrawList();
+            const ImVec2 mouse = ImGui::GetMousePos();
+            const ProfileZones::Zone* hovered = nullptr;
+            // zones of one lane come in time order: runs of sub-pixel zones collapse into one pixel
+            std::vector<float> lane_end(lanes, -FLT_MAX);
+            for (const ProfileZones::Zone& zone : zones_) {
+                const double x0 = ((double)zone.Begin - (double)frame_begin_) * 1e-6;
+                const double x1 = ((double)zone.End - (double)frame_begin_) * 1e-6;
+                const int lane = lane_base[zone.Thread] + zone.Depth;
+                const ImVec2 a = ImPlot::PlotToPixels(x0, lane);
+                const ImVec2 b = ImPlot::PlotToPixels(x1, lane + 0.9);
+                const ImVec2 min(a.x, ImMin(a.y, b.y)), max(ImMax(b.x, a.x + 1.0f), ImMax(a.y, b.y));
+                if (max.x <= lane_end[lane] + 1.0f)
+                    continue;
+                lane_end[lane] = max.x;
+                const ImU32 hash = ImHashStr(zone.Name);
+                draw_list->AddRectFilled(min, max, ImColor::HSV((hash & 255) / 255.0f, 0.55f, 0.75f));
+                const float name_width = ImGui::CalcTextSize(zone.Name).x;
+                if (max.x - min.x > name_width + 4.0f)
+                    draw_list->AddText(ImVec2(min.x + 2.0f, min.y + (max.y - min.y - ImGui::GetFontSize()) * 0.5f), IM_COL32_BLACK, zone.Name);
+                if (ImPlot::IsPlotHovered() && mouse.x >= min.x && mouse.x < max.x && mouse.y >= min.y && mouse.y < max.y)
+                    hovered = &zone;
+            }
+            ImPlot::PopPlotClipRect();
+            if (hovered != nullptr) {
+                ImGui::BeginTooltip();
+                ImGui::Text("%s\n%.3f ms", hovered->Name, (hovered->End - hovered->Begin) * 1e-6);
+                ImGui::EndTooltip();
+            }
+            ImPlot::EndPlot();
+        }
+
+        if (ImGui::BeginTable("zones", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY)) {
+            ImGui::TableSetupScrollFreeze(0, 1);
+            ImGui::TableSetupColumn("Zone");
+            ImGui::TableSetupColumn("Calls");
+            ImGui::TableSetupColumn("Inclusive, ms");
+            ImGui::TableHeadersRow();
+            for (const Total& total : totals_) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(total.Name);
+                ImGui::TableNextColumn();
+                ImGui::Text("%d", total.Calls);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", total.Time * 1e-6);
+            }
+            ImGui::EndTable();
+        }
+        ImGui::End();
+    }
+
+private:
+    struct Total {
+        const char* Name;
+        int         Calls;
+        uint64_t    Time; // ns, nested calls of the same zone are counted twice
+    };
+
+    void CaptureToFile() {
+        char filename[64];
+        ImFormatString(filename, IM_ARRAYSIZE(filename), "profile_capture_%d.json", ++captures_);
+        if (Capture(filename, capture_seconds_))
+            capture_status_ = std::string("Saved ") + filename;
+        else
+            capture_status_ = std::string("Failed to write ") + filename;
+    }
+
+    // Picks the last finished frame and keeps the zones that overlap it
+    void Refresh() {
+        collected_.clear();
+        ProfileZones::Get().Collect(ProfileZones::Now() - 250000000ull, collected_);
+        thread_names_ = ProfileZones::Get().Threads();
+        frame_begin_ = frame_end_ = 0;
+        for (const ProfileZones::Zone& zone : collected_) {
+            if (zone.Depth == 0 && zone.End > frame_end_ && strcmp(zone.Name, "Frame") == 0) {
+                frame_begin_ = zone.Begin;
+                frame_end_ = zone.End;
+            }
+        }
+        zones_.clear();
+        totals_.clear();
+        for (const ProfileZones::Zone& zone : collected_) {
+            if (zone.End <= frame_begin_ || zone.Begin >= frame_end_)
+                continue;
+            zones_.push_back(zone);
+            Total* total = nullptr;
+            for (Total& t : totals_) {
+                if (t.Name == zone.Name || strcmp(t.Name, zone.Name) == 0) {
+                    total = &t;
+                    break;
+                }
+            }
+            if (total == nullptr) {
+                totals_.push_back(Total{ zone.Name, 0, 0 });
+                total = &totals_.back();
+            }
+            total->Calls++;
+            total->Time += zone.End - zone.Begin;
+        }
+        std::sort(totals_.begin(), totals_.end(), [](const Total& a, const Total& b) { return a.Time > b.Time; });
+    }
+
+    bool paused_;
+    float capture_seconds_;
+    int captures_;
+    std::string capture_status_;
+    uint64_t frame_begin_, frame_end_;
+    std::vector<ProfileZones::Zone> collected_; // scratch, keeps its capacity between frames
+    std::vector<ProfileZones::Zone> zones_;     // of the shown frame
+    std::vector<Total> totals_;
+    std::vector<std::string> thread_names_;
+    std::vector<double> tick_pos_;
+    std::vector<const char*> tick_labels_;
+};
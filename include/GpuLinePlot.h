@@ -0,0 +1,298 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <imgui.h>
+#include <implot.h>
+#include <implot_internal.h>
+#include <iostream>
+
+// Line series drawn on the GPU: raw (x,y) samples live in a GL buffer mirroring the
+// ring buffer they come from, only newly appended samples are uploaded each frame and
+// segments are expanded to quads by an instanced shader run from an ImDrawCallback.
+class GpuLinePlot {
+public:
+    GpuLinePlot(void)
+        : program_(0), vao_(0), vbo_(0), capacity_(0), uploaded_(0), version_(0), initialized_(false), failed_(false) {
+    }
+
+    // GL objects must be released while the context is still current.
+    void Destroy() {
+        if (program_) glDeleteProgram(program_);
+        if (vbo_) glDeleteBuffers(1, &vbo_);
+        if (vao_) glDeleteVertexArrays(1, &vao_);
+        program_ = vao_ = vbo_ = 0;
+        capacity_ = uploaded_ = 0;
+        version_ = 0;
+        initialized_ = false;
+    }
+
+    // Plots a ring buffer of `size` points (`capacity` slots, oldest point at `offset` once full).
+    // `version` must grow by one per appended point. Returns false if the GPU path can't be used
+    // (no GL 3.3 instancing, non-linear axes), in which case the caller should use ImPlot::PlotLine.
+    bool PlotLine(const char* label_id, const ImVec2* data, int size, int capacity, int offset, ImU64 version) {
+        IMGUI_PROFILE_ZONE("GpuLinePlot::PlotLine");
+        if (!Init())
+            return false;
+
+        ImPlotContext& gp = *GImPlot;
+        IM_ASSERT_USER_ERROR(gp.CurrentPlot != nullptr, "PlotLine() needs to be called between BeginPlot() and EndPlot()!");
+        ImPlot::SetupLock();
+        ImPlotPlot& plot = *gp.CurrentPlot;
+        const ImPlotAxis& x_axis = plot.Axes[plot.CurrentX];
+        const ImPlotAxis& y_axis = plot.Axes[plot.CurrentY];
+        if (x_axis.TransformForward != nullptr || y_axis.TransformForward != nullptr)
+            return false;
+
+        Upload(data, size, capacity, offset, version);
+
+        if (ImPlot::BeginItem(label_id, 0, ImPlotCol_Line)) {
+            if (plot.FitThisFrame) {
+                for (int i = 0; i < size; ++i) {
+                    plot.Axes[plot.CurrentX].ExtendFitWith(plot.Axes[plot.CurrentY], data[i].x, data[i].y);
+                    plot.Axes[plot.CurrentY].ExtendFitWith(plot.Axes[plot.CurrentX], data[i].y, data[i].x);
+                }
+            }
+            const ImPlotNextItemData& s = ImPlot::GetItemData();
+            if (s.RenderLine && size > 1) {
+                DrawData dd;
+                dd.Self       = this;
+                dd.Origin     = ImVec2((float)x_axis.Range.Min, (float)y_axis.Range.Min);
+                dd.Scale      = ImVec2((float)x_axis.ScaleToPixel, (float)y_axis.ScaleToPixel);
+                dd.PixelMin   = ImVec2(x_axis.PixelMin, y_axis.PixelMin);
+                dd.Color      = s.Colors[ImPlotCol_Line];
+                dd.Color.w   *= ImGui::GetStyle().Alpha;
+                dd.HalfWeight = ImMax(1.0f, s.LineWeight) * 0.5f;
+                dd.Size       = size;
+                dd.Offset     = size < capacity ? 0 : offset;
+                ImDrawList* draw_list = ImPlot::GetPlotDrawList();
+                draw_list->AddCallback(RenderCallback, &dd, sizeof(dd));
+                draw_list->AddCallback(ImDrawCallback_ResetRenderState, nullptr);
+            }
+            ImPlot::EndItem();
+        }
+        return true;
+    }
+
+private:
+    // Copied into the draw list by AddCallback, so it must stay trivially copyable
+    struct DrawData {
+        GpuLinePlot* Self;
+        ImVec2       Origin;   // plot coordinates at PixelMin
+        ImVec2       Scale;    // pixels per plot unit
+        ImVec2       PixelMin;
+        ImVec4       Color;
+        float        HalfWeight;
+        int          Size;
+        int          Offset;
+    };
+
+    bool Init() {
+        if (initialized_)
+            return true;
+        if (failed_)
+            return false;
+        failed_ = true;
+
+        // glVertexAttribDivisor is core since GL 3.3, glad leaves it null on older contexts
+        if (glVertexAttribDivisor == nullptr || glDrawArraysInstanced == nullptr) {
+            std::cerr << "GL 3.3 instancing is not available, GPU lines disabled" << std::endl;
+            return false;
+        }
+
+        const GLchar* vertex_shader =
+            "#version 130\n"
+            "in vec2 P0;\n"
+            "in vec2 P1;\n"
+            "uniform vec2 Origin;\n"
+            "uniform vec2 Scale;\n"
+            "uniform vec2 PixelMin;\n"
+            "uniform vec4 Display;\n"
+            "uniform float HalfWeight;\n"
+            "out float Dist;\n"
+            "void main()\n"
+            "{\n"
+            "    vec2 a = PixelMin + (P0 - Origin) * Scale;\n"
+            "    vec2 b = PixelMin + (P1 - Origin) * Scale;\n"
+            "    vec2 dir = b - a;\n"
+            "    float len = length(dir);\n"
+            "    dir = len > 0.0 ? dir / len : vec2(1.0, 0.0);\n"
+            "    float side = (gl_VertexID & 1) == 0 ? -1.0 : 1.0;\n"
+            "    float extent = (HalfWeight + 1.0) * side;\n"
+            "    vec2 p = (gl_VertexID < 2 ? a : b) + vec2(-dir.y, dir.x) * extent;\n"
+            "    if (any(isnan(P0)) || any(isnan(P1)))\n"
+            "        p = vec2(-1e9);\n"
+            "    Dist = extent;\n"
+            "    gl_Position = vec4((p - Display.xy) / Display.zw * vec2(2.0, -2.0) + vec2(-1.0, 1.0), 0.0, 1.0);\n"
+            "}\n";
+
+        const GLchar* fragment_shader =
+            "#version 130\n"
+            "uniform vec4 Color;\n"
+            "uniform float HalfWeight;\n"
+            "in float Dist;\n"
+            "out vec4 Out_Color;\n"
+            "void main()\n"
+            "{\n"
+            "    float alpha = clamp(HalfWeight + 0.5 - abs(Dist), 0.0, 1.0);\n"
+            "    Out_Color = vec4(Color.rgb, Color.a * alpha);\n"
+            "}\n";
+
+        GLuint vs = CompileShader(GL_VERTEX_SHADER, vertex_shader);
+        GLuint fs = CompileShader(GL_FRAGMENT_SHADER, fragment_shader);
+        if (!vs || !fs) {
+            if (vs) glDeleteShader(vs);
+            if (fs) glDeleteShader(fs);
+            return false;
+        }
+
+        program_ = glCreateProgram();
+        glAttachShader(program_, vs);
+        glAttachShader(program_, fs);
+        glBindAttribLocation(program_, 0, "P0");
+        glBindAttribLocation(program_, 1, "P1");
+        glLinkProgram(program_);
+        glDetachShader(program_, vs);
+        glDetachShader(program_, fs);
+        glDeleteShader(vs);
+        glDeleteShader(fs);
+
+        GLint status = 0;
+        glGetProgramiv(program_, GL_LINK_STATUS, &status);
+        if (status != GL_TRUE) {
+            std::cerr << "Failed to link GPU line program" << std::endl;
+            glDeleteProgram(program_);
+            program_ = 0;
+            return false;
+        }
+
+        locOrigin_     = glGetUniformLocation(program_, "Origin");
+        locScale_      = glGetUniformLocation(program_, "Scale");
+        locPixelMin_   = glGetUniformLocation(program_, "PixelMin");
+        locDisplay_    = glGetUniformLocation(program_, "Display");
+        locHalfWeight_ = glGetUniformLocation(program_, "HalfWeight");
+        locColor_      = glGetUniformLocation(program_, "Color");
+
+        glGenVertexArrays(1, &vao_);
+        glGenBuffers(1, &vbo_);
+
+        failed_ = false;
+        initialized_ = true;
+        return true;
+    }
+
+    static GLuint CompileShader(GLenum type, const GLchar* source) {
+        GLuint shader = glCreateShader(type);
+        glShaderSource(shader, 1, &source, nullptr);
+        glCompileShader(shader);
+        GLint status = 0;
+        glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+        if (status != GL_TRUE) {
+            char log[512];
+            glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+            std::cerr << "Failed to compile GPU line shader: " << log << std::endl;
+            glDeleteShader(shader);
+            return 0;
+        }
+        return shader;
+    }
+
+    // The GL buffer mirrors the ring slot by slot, plus one extra slot duplicating slot 0
+    // so the segment crossing the wraparound seam can be drawn from contiguous memory.
+    void Upload(const ImVec2* data, int size, int capacity, int offset, ImU64 version) {
+        glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+        if (capacity != capacity_) {
+            glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)(capacity + 1) * sizeof(ImVec2), nullptr, GL_DYNAMIC_DRAW);
+            capacity_ = capacity;
+            version_ = 0;
+            uploaded_ = 0;
+        }
+
+        ImU64 appended = version - version_;
+        if (version < version_ || size < uploaded_ || appended > (ImU64)size) {
+            // buffer was erased or we fell behind by more than the ring holds
+            UploadRange(data, 0, size);
+        }
+        else if (appended > 0) {
+            // newest points end right before the write position
+            int end = size < capacity ? size : offset;
+            int first = end - (int)appended;
+            if (first < 0) {
+                UploadRange(data, first + capacity, capacity);
+                UploadRange(data, 0, end);
+            }
+            else {
+                UploadRange(data, first, end);
+            }
+        }
+        version_ = version;
+        uploaded_ = size;
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    void UploadRange(const ImVec2* data, int begin, int end) {
+        if (end <= begin)
+            return;
+        glBufferSubData(GL_ARRAY_BUFFER, (GLintptr)begin * sizeof(ImVec2), (GLsizeiptr)(end - begin) * sizeof(ImVec2), data + begin);
+        if (begin == 0)
+            glBufferSubData(GL_ARRAY_BUFFER, (GLintptr)capacity_ * sizeof(ImVec2), sizeof(ImVec2), data);
+    }
+
+    // Draws `count` segments starting at slot `first`
+    void DrawSegments(int first, int count) {
+        if (count <= 0)
+            return;
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(ImVec2), (const void*)((size_t)first * sizeof(ImVec2)));
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(ImVec2), (const void*)((size_t)(first + 1) * sizeof(ImVec2)));
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, count);
+    }
+
+    static void RenderCallback(const ImDrawList*, const ImDrawCmd* cmd) {
+        const DrawData& dd = *(const DrawData*)cmd->UserCallbackData;
+        GpuLinePlot& self = *dd.Self;
+        ImDrawData* draw_data = ImGui::GetDrawData();
+
+        // The backend only applies scissor rects to regular draw commands
+        ImVec2 clip_off = draw_data->DisplayPos;
+        ImVec2 clip_scale = draw_data->FramebufferScale;
+        int fb_height = (int)(draw_data->DisplaySize.y * clip_scale.y);
+        ImVec2 clip_min((cmd->ClipRect.x - clip_off.x) * clip_scale.x, (cmd->ClipRect.y - clip_off.y) * clip_scale.y);
+        ImVec2 clip_max((cmd->ClipRect.z - clip_off.x) * clip_scale.x, (cmd->ClipRect.w - clip_off.y) * clip_scale.y);
+        if (clip_max.x <= clip_min.x || clip_max.y <= clip_min.y)
+            return;
+        glScissor((int)clip_min.x, (int)((float)fb_height - clip_max.y), (int)(clip_max.x - clip_min.x), (int)(clip_max.y - clip_min.y));
+
+        glUseProgram(self.program_);
+        glUniform2f(self.locOrigin_, dd.Origin.x, dd.Origin.y);
+        glUniform2f(self.locScale_, dd.Scale.x, dd.Scale.y);
+        glUniform2f(self.locPixelMin_, dd.PixelMin.x, dd.PixelMin.y);
+        glUniform4f(self.locDisplay_, draw_data->DisplayPos.x, draw_data->DisplayPos.y, draw_data->DisplaySize.x, draw_data->DisplaySize.y);
+        glUniform1f(self.locHalfWeight_, dd.HalfWeight);
+        glUniform4f(self.locColor_, dd.Color.x, dd.Color.y, dd.Color.z, dd.Color.w);
+
+        glBindVertexArray(self.vao_);
+        glBindBuffer(GL_ARRAY_BUFFER, self.vbo_);
+        glEnableVertexAttribArray(0);
+        glEnableVertexAttribArray(1);
+        glVertexAttribDivisor(0, 1);
+        glVertexAttribDivisor(1, 1);
+
+        if (dd.Offset == 0) {
+            self.DrawSegments(0, dd.Size - 1);
+        }
+        else {
+            // oldest part up to the seam (its last segment ends on the duplicated slot 0), then the rest
+            self.DrawSegments(dd.Offset, dd.Size - dd.Offset);
+            self.DrawSegments(0, dd.Offset - 1);
+        }
+    }
+
+    GLuint program_;
+    GLuint vao_;
+    GLuint vbo_;
+    GLint locOrigin_, locScale_, locPixelMin_, locDisplay_, locHalfWeight_, locColor_;
+    int capacity_;
+    int uploaded_;
+    ImU64 version_;
+    bool initialized_;
+    bool failed_;
+};
@@ -0,0 +1,327 @@
+#pragma once
+
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <implot.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+
+// Latency of a received frame at each stage of its way to the screen, measured from the read
+// that returned its last byte. Every thread records into its own buffers: a log-linear (HDR)
+// histogram per stage and a ring of recent events, both written with relaxed atomics only, so
+// Record() never locks or waits after the first call on a thread. Draw() merges the buffers
+// and shows the percentiles, ExportChromeTrace() writes the retained events for
+// chrome://tracing / Perfetto. Buffers live as long as the trace, which must outlive the
+// recording threads. Time is steady_clock (QueryPerformanceCounter on Windows,
+// CLOCK_MONOTONIC on Linux) in nanoseconds.
+class LatencyTrace {
+public:
+    enum Stage {
+        Stage_Decode,   // SLIP frame complete
+        Stage_Enqueue,  // frame in the packet log
+        Stage_Submit,   // ImGui::Render() of the first UI frame that sees it
+        Stage_Present,  // glfwSwapBuffers() of that frame returned
+        Stage_COUNT
+    };
+
+    LatencyTrace() : pending_(0), origin_(Now()), show_plot_(true) {
+        memset(reset_, 0, sizeof(reset_));
+    }
+
+    LatencyTrace(const LatencyTrace&) = delete;
+    LatencyTrace& operator=(const LatencyTrace&) = delete;
+
+    static ImU64 Now() {
+        return (ImU64)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    static const char* StageName(int stage) {
+        static const char* names[Stage_COUNT] = { "Decode", "Enqueue", "Submit", "Present" };
+        return names[stage];
+    }
+
+    // Names the calling thread in the exported trace
+    void SetThreadName(const char* name) {
+        ThreadBuffer* buf = Local();
+        std::lock_guard<std::mutex> lock(mutex_);
+        buf->Name = name;
+    }
+
+    // Any thread. `begin` is the read timestamp of the frame, `end` the time the stage finished.
+    void Record(Stage stage, ImU64 begin, ImU64 end) {
+        ThreadBuffer* buf = Local();
+        const ImU64 value = end > begin ? end - begin : 0;
+        std::atomic<ImU32>& count = buf->Counts[stage][Bucket(value)];
+        count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        if (value > buf->Max[stage].load(std::memory_order_relaxed))
+            buf->Max[stage].store(value, std::memory_order_relaxed);
+
+        const ImU64 head = buf->Head.load(std::memory_order_relaxed);
+        Event& ev = buf->Events[head % RingSize];
+        ev.Begin.store(begin, std::memory_order_relaxed);
+        ev.End.store(end, std::memory_order_relaxed);
+        ev.Stage.store(stage, std::memory_order_relaxed);
+        buf->Head.store(head + 1, std::memory_order_release);
+    }
+
+    // Receiving thread: a frame is waiting for the UI. Only the oldest unseen frame is kept,
+    // the UI stages measure the worst case of what the next frame shows.
+    void MarkPending(ImU64 begin) {
+        ImU64 expected = 0;
+        pending_.compare_exchange_strong(expected, begin, std::memory_order_relaxed);
+    }
+
+    // UI thread: read timestamp of the oldest frame since the last call, or 0
+    ImU64 TakePending() {
+        return pending_.exchange(0, std::memory_order_relaxed);
+    }
+
+    // Starts the percentiles over, the event ring is kept for the trace export
+    void Reset() {
+        Merge(reset_);
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (std::unique_ptr<ThreadBuffer>& buf : threads_)
+            for (int s = 0; s < Stage_COUNT; s++)
+                buf->Max[s].store(0, std::memory_order_relaxed);
+    }
+
+    void Draw(const char* title, bool* p_open = nullptr) {
+        if (!ImGui::Begin(title, p_open)) {
+            ImGui::End();
+            return;
+        }
+        if (ImGui::Button("Reset"))
+            Reset();
+        ImGui::SameLine();
+        if (ImGui::Button("Export Chrome trace")) {
+            if (ExportChromeTrace("latency_trace.json"))
+                export_status_ = "Saved latency_trace.json";
+            else
+                export_status_ = "Failed to write latency_trace.json";
+        }
+        ImGui::SameLine();
+        ImGui::Checkbox("Histogram", &show_plot_);
+        if (!export_status_.empty()) {
+            ImGui::SameLine();
+            ImGui::TextUnformatted(export_status_.c_str());
+        }
+
+        ImU32 (&counts)[Stage_COUNT][Buckets] = view_;
+        ImU64 max[Stage_COUNT];
+        Merge(counts, max);
+        for (int s = 0; s < Stage_COUNT; s++)
+            for (int b = 0; b < Buckets; b++)
+                counts[s][b] -= reset_[s][b];
+
+        if (ImGui::BeginTable("stages", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchSame)) {
+            ImGui::TableSetupColumn("Stage");
+            ImGui::TableSetupColumn("Frames");
+            ImGui::TableSetupColumn("p50, us");
+            ImGui::TableSetupColumn("p99, us");
+            ImGui::TableSetupColumn("p99.9, us");
+            ImGui::TableSetupColumn("max, us");
+            ImGui::TableHeadersRow();
+            for (int s = 0; s < Stage_COUNT; s++) {
+                ImU64 total = 0;
+                for (int b = 0; b < Buckets; b++)
+                    total += counts[s][b];
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(StageName(s));
+                ImGui::TableNextColumn();
+                ImGui::Text("%llu", (unsigned long long)total);
+                const double q[3] = { 0.5, 0.99, 0.999 };
+                for (double p : q) {
+                    ImGui::TableNextColumn();
+                    if (total > 0)
+                        ImGui::Text("%.1f", Percentile(counts[s], total, p) * 1e-3);
+                }
+                ImGui::TableNextColumn();
+                if (total > 0)
+                    ImGui::Text("%.1f", max[s] * 1e-3);
+            }
+            ImGui::EndTable();
+        }
+
+        if (show_plot_ && ImPlot::BeginPlot("##latency", ImVec2(-1, -1))) {
+            ImPlot::SetupAxes("latency, us", "frames", ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_AutoFit);
+            ImPlot::SetupAxisScale(ImAxis_X1, ImPlotScale_Log10);
+            for (int s = 0; s < Stage_COUNT; s++) {
+                int first = Buckets, last = -1;
+                for (int b = 0; b < Buckets; b++) {
+                    if (counts[s][b] != 0) {
+                        first = ImMin(first, b);
+                        last = b;
+                    }
+                }
+                int n = 0;
+                for (int b = first; b <= last; b++, n++) {
+                    xs_[n] = ImMax(BucketLow(b), (ImU64)1) * 1e-3;
+                    ys_[n] = counts[s][b];
+                }
+                ImPlot::PlotStairs(StageName(s), xs_, ys_, n);
+            }
+            ImPlot::EndPlot();
+        }
+        ImGui::End();
+    }
+
+    // Writes the retained events as complete ("X") events, one track per recording thread
+    bool ExportChromeTrace(const char* filename) {
+        FILE* f = fopen(filename, "wb");
+        if (f == nullptr)
+            return false;
+        fprintf(f, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+        bool first = true;
+        std::vector<Event::Copy> events;
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t tid = 0; tid < threads_.size(); tid++) {
+            Snapshot(*threads_[tid], events);
+            fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                    first ? "" : ",\n", (int)tid + 1, threads_[tid]->Name.c_str());
+            first = false;
+            for (const Event::Copy& ev : events) {
+                const double ts = ev.Begin >= origin_ ? (ev.Begin - origin_) * 1e-3 : 0.0;
+                fprintf(f, ",\n{\"name\":\"%s\",\"cat\":\"latency\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d}",
+                        StageName(ev.Stage), ts, (ev.End - ev.Begin) * 1e-3, (int)tid + 1);
+            }
+        }
+        fprintf(f, "\n]}\n");
+        return fclose(f) == 0;
+    }
+
+private:
+    enum {
+        SubBits  = 4,                                  // 16 buckets per power of two, ~6% resolution
+        MaxBits  = 36,                                 // values are clamped to ~68 s
+        Buckets  = (MaxBits - SubBits + 1) << SubBits,
+        RingSize = 16384                               // events kept per thread
+    };
+
+    struct Event {
+        std::atomic<ImU64> Begin, End;
+        std::atomic<int>   Stage;
+
+        struct Copy {
+            ImU64 Begin, End;
+            int   Stage;
+        };
+    };
+
+    struct ThreadBuffer {
+        std::atomic<ImU32> Counts[Stage_COUNT][Buckets];
+        std::atomic<ImU64> Max[Stage_COUNT];
+        std::atomic<ImU64> Head;                       // events ever recorded
+        Event Events[RingSize];
+        std::string Name;
+
+        ThreadBuffer() : Head(0), Name("receive") {
+            for (int s = 0; s < Stage_COUNT; s++) {
+                for (int b = 0; b < Buckets; b++)
+                    Counts[s][b].store(0, std::memory_order_relaxed);
+                Max[s].store(0, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    // Log-linear bucket: values below 2^SubBits map to themselves, larger ones keep the
+    // leading SubBits+1 bits
+    static int Bucket(ImU64 value) {
+        if (value >= ((ImU64)1 << MaxBits))
+            value = ((ImU64)1 << MaxBits) - 1;
+        if (value < (1 << SubBits))
+            return (int)value;
+        int e = 0;
+        for (int shift = 32; shift > 0; shift >>= 1) {
+            if (value >> (e + shift))
+                e += shift;
+        }
+        return ((e - SubBits + 1) << SubBits) + (int)((value >> (e - SubBits)) & ((1 << SubBits) - 1));
+    }
+
+    static ImU64 BucketLow(int bucket) {
+        if (bucket < (1 << SubBits))
+            return (ImU64)bucket;
+        const int e = (bucket >> SubBits) + SubBits - 1;
+        return ((ImU64)((1 << SubBits) + (bucket & ((1 << SubBits) - 1)))) << (e - SubBits);
+    }
+
+    // Upper edge of the bucket holding the p-th value, errs on the slow side
+    static double Percentile(const ImU32* counts, ImU64 total, double p) {
+        const ImU64 rank = (ImU64)(p * (double)total + 0.5);
+        ImU64 seen = 0;
+        for (int b = 0; b < Buckets; b++) {
+            seen += counts[b];
+            if (seen >= ImMax(rank, (ImU64)1))
+                return b + 1 < Buckets ? (double)BucketLow(b + 1) : (double)BucketLow(b);
+        }
+        return (double)BucketLow(Buckets - 1);
+    }
+
+    ThreadBuffer* Local() {
+        struct Cache {
+            LatencyTrace* Owner;
+            ThreadBuffer* Buffer;
+        };
+        static thread_local Cache cache = { nullptr, nullptr };
+        if (cache.Owner != this) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            threads_.emplace_back(new ThreadBuffer());
+            cache.Owner = this;
+            cache.Buffer = threads_.back().get();
+        }
+        return cache.Buffer;
+    }
+
+    void Merge(ImU32 (*counts)[Buckets], ImU64* max = nullptr) {
+        memset(counts, 0, sizeof(ImU32) * Stage_COUNT * Buckets);
+        if (max != nullptr)
+            memset(max, 0, sizeof(ImU64) * Stage_COUNT);
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (std::unique_ptr<ThreadBuffer>& buf : threads_) {
+            for (int s = 0; s < Stage_COUNT; s++) {
+                for (int b = 0; b < Buckets; b++)
+                    counts[s][b] += buf->Counts[s][b].load(std::memory_order_relaxed);
+                if (max != nullptr)
+                    max[s] = ImMax(max[s], buf->Max[s].load(std::memory_order_relaxed));
+            }
+        }
+    }
+
+    // Copies the retained events of one thread. Slots the writer may have reused while
+    // copying are dropped.
+    static void Snapshot(const ThreadBuffer& buf, std::vector<Event::Copy>& out) {
+        out.clear();
+        const ImU64 head = buf.Head.load(std::memory_order_acquire);
+        const ImU64 from = head > RingSize ? head - RingSize : 0;
+        for (ImU64 i = from; i < head; i++) {
+            const Event& ev = buf.Events[i % RingSize];
+            Event::Copy copy = { ev.Begin.load(std::memory_order_relaxed), ev.End.load(std::memory_order_relaxed),
+                                 ev.Stage.load(std::memory_order_relaxed) };
+            out.push_back(copy);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const ImU64 now = buf.Head.load(std::memory_order_relaxed);
+        if (now >= RingSize && now - RingSize + 1 > from) {
+            const size_t torn = (size_t)ImMin(now - RingSize + 1 - from, (ImU64)out.size());
+            out.erase(out.begin(), out.begin() + torn);
+        }
+    }
+
+    std::mutex mutex_;                                 // guards threads_ (the list, not the counters)
+    std::vector<std::unique_ptr<ThreadBuffer>> threads_;
+    std::atomic<ImU64> pending_;
+    ImU32 reset_[Stage_COUNT][Buckets];                // counts at the last Reset()
+    ImU32 view_[Stage_COUNT][Buckets];                 // Draw() scratch
+    double xs_[Buckets], ys_[Buckets];
+    const ImU64 origin_;
+    bool show_plot_;
+    std::string export_status_;
+};
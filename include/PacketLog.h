@@ -0,0 +1,279 @@
+#pragma once
+
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <climits>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Bounded log of received frames. Frames are stored raw in fixed-size chunks and only
+// formatted when a row becomes visible (ImGuiListClipper) or the filter thread scans it.
+// Add() may be called from any thread, Draw() and Clear() from the UI thread only.
+class PacketLog {
+public:
+    explicit PacketLog(size_t max_frames = 10000000)
+        : max_chunks_(max_frames / ChunkFrames + 1), first_(0), total_(0),
+          filter_gen_(0), matches_popped_(0), scanned_(0), quit_(false), auto_scroll_(true),
+          start_(std::chrono::steady_clock::now()) {
+        filter_buf_[0] = '\0';
+        filter_thread_ = std::thread(&PacketLog::FilterWorker, this);
+    }
+
+    ~PacketLog() {
+        {
+            std::lock_guard<std::mutex> lock(filter_mutex_);
+            quit_ = true;
+        }
+        filter_wake_.notify_one();
+        filter_thread_.join();
+    }
+
+    PacketLog(const PacketLog&) = delete;
+    PacketLog& operator=(const PacketLog&) = delete;
+
+    void Add(const void* data, size_t len) {
+        Add(data, len, std::chrono::steady_clock::now());
+    }
+
+    // `time_point` is when the frame was sampled or received, shown relative to the creation of the log
+    void Add(const void* data, size_t len, std::chrono::steady_clock::time_point time_point) {
+        const double time = std::chrono::duration<double>(time_point - start_).count();
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (chunks_.empty() || chunks_.back()->Frames.size() == ChunkFrames) {
+            if (chunks_.size() == max_chunks_) {
+                // the oldest chunk is always full, so indices stay a multiple of ChunkFrames from first_
+                std::unique_ptr<Chunk> chunk = std::move(chunks_.front());
+                chunks_.pop_front();
+                first_ += ChunkFrames;
+                chunk->Frames.clear();
+                chunk->Bytes.clear();
+                chunks_.push_back(std::move(chunk));
+            } else {
+                chunks_.emplace_back(new Chunk());
+                chunks_.back()->Frames.reserve(ChunkFrames);
+            }
+        }
+        Chunk& chunk = *chunks_.back();
+        Frame frame = { time, (ImU32)chunk.Bytes.size(), (ImU32)len };
+        chunk.Frames.push_back(frame);
+        chunk.Bytes.insert(chunk.Bytes.end(), (const unsigned char*)data, (const unsigned char*)data + len);
+        total_++;
+    }
+
+    void Clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        chunks_.clear();
+        first_ = total_.load();
+    }
+
+    void Draw(const char* title, bool* p_open = nullptr) {
+        if (!ImGui::Begin(title, p_open)) {
+            ImGui::End();
+            return;
+        }
+        if (ImGui::Button("Clear"))
+            Clear();
+        ImGui::SameLine();
+        ImGui::Checkbox("Auto-scroll", &auto_scroll_);
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(ImGui::GetFontSize() * 16);
+        if (ImGui::InputText("Filter", filter_buf_, IM_ARRAYSIZE(filter_buf_)))
+            SetFilter(filter_buf_);
+        const ImU64 first = first_, total = total_;
+        const bool filtering = filter_buf_[0] != '\0';
+        ImU64 rows = total - first;
+        ImU64 popped = 0;
+        if (filtering) {
+            std::lock_guard<std::mutex> lock(filter_mutex_);
+            TrimMatches();
+            rows = matches_.size();
+            popped = matches_popped_;
+            ImGui::SameLine();
+            ImGui::Text("%llu of %llu frames (%.0f%% scanned)", (unsigned long long)rows, (unsigned long long)(total - first),
+                        total > first ? 100.0 * (double)(ImMax(scanned_, first) - first) / (double)(total - first) : 100.0);
+        } else {
+            ImGui::SameLine();
+            ImGui::Text("%llu frames", (unsigned long long)rows);
+        }
+
+        ImGui::Separator();
+        if (ImGui::BeginChild("scrolling", ImVec2(0, 0), ImGuiChildFlags_None, ImGuiWindowFlags_HorizontalScrollbar)) {
+            std::vector<ImU64> index;
+            char line[LineSize];
+            ImGuiListClipper clipper;
+            clipper.Begin((int)ImMin(rows, (ImU64)INT_MAX));
+            while (clipper.Step()) {
+                index.resize(clipper.DisplayEnd - clipper.DisplayStart);
+                if (filtering) {
+                    // the filter thread may have trimmed matches since the rows were counted
+                    std::lock_guard<std::mutex> lock(filter_mutex_);
+                    const ImU64 shift = matches_popped_ - popped;
+                    for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+                        const ImU64 pos = (ImU64)row - shift;
+                        index[row - clipper.DisplayStart] = (ImU64)row >= shift && pos < matches_.size() ? matches_[(size_t)pos] : Trimmed;
+                    }
+                } else {
+                    for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+                        index[row - clipper.DisplayStart] = first + row;
+                }
+                for (ImU64 idx : index) {
+                    int len;
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        len = FormatFrame(idx, line, sizeof(line));
+                    }
+                    if (len > 0)
+                        ImGui::TextUnformatted(line, line + len);
+                    else if (idx == Trimmed)
+                        ImGui::TextDisabled("dropped");
+                    else
+                        ImGui::TextDisabled("%llu: dropped", (unsigned long long)idx);
+                }
+            }
+            clipper.End();
+            if (auto_scroll_ && ImGui::GetScrollY() >= ImGui::GetScrollMaxY())
+                ImGui::SetScrollHereY(1.0f);
+        }
+        ImGui::EndChild();
+        ImGui::End();
+    }
+
+private:
+    enum { ChunkFrames = 4096, LineSize = 256, HexBytes = 32 };
+    static const ImU64 Trimmed = ~(ImU64)0; // row of a match trimmed while drawing
+
+    struct Frame {
+        double Time;
+        ImU32  Offset; // into Chunk::Bytes
+        ImU32  Size;
+    };
+
+    struct Chunk {
+        std::vector<Frame> Frames;
+        std::vector<unsigned char> Bytes;
+    };
+
+    // Formats frame `idx` as "index time size | hex | ascii", returns the length or 0 if the
+    // frame was dropped. Caller holds mutex_.
+    int FormatFrame(ImU64 idx, char* buf, int size) const {
+        if (idx < first_ || idx >= total_)
+            return 0;
+        const ImU64 local = idx - first_;
+        const Chunk& chunk = *chunks_[(size_t)(local / ChunkFrames)];
+        const Frame& frame = chunk.Frames[(size_t)(local % ChunkFrames)];
+        return FormatLine(idx, frame, chunk.Bytes.data() + frame.Offset, buf, size);
+    }
+
+    static int FormatLine(ImU64 idx, const Frame& frame, const unsigned char* data, char* buf, int size) {
+        const int shown = (int)ImMin(frame.Size, (ImU32)HexBytes);
+        int len = ImFormatString(buf, size, "%8llu %12.6f %5u |", (unsigned long long)idx, frame.Time, frame.Size);
+        static const char digits[] = "0123456789ABCDEF";
+        for (int i = 0; i < shown && len + 4 < size; i++) {
+            buf[len++] = ' ';
+            buf[len++] = digits[data[i] >> 4];
+            buf[len++] = digits[data[i] & 15];
+        }
+        if (len + 5 < size)
+            len += ImFormatString(buf + len, size - len, frame.Size > HexBytes ? " ~ |" : " |");
+        for (int i = 0; i < shown && len + 1 < size; i++)
+            buf[len++] = data[i] >= 32 && data[i] < 127 ? (char)data[i] : '.';
+        buf[len] = '\0';
+        return len;
+    }
+
+    void SetFilter(const char* text) {
+        {
+            std::lock_guard<std::mutex> lock(filter_mutex_);
+            filter_text_ = text;
+            filter_gen_++;
+            matches_.clear();
+            scanned_ = 0;
+        }
+        filter_wake_.notify_one();
+    }
+
+    // Drops matches of frames that are no longer retained. Caller holds filter_mutex_.
+    void TrimMatches() {
+        const ImU64 first = first_;
+        while (!matches_.empty() && matches_.front() < first) {
+            matches_.pop_front();
+            matches_popped_++;
+        }
+    }
+
+    // Scans frames in batches of up to one chunk and appends the indices that pass the filter.
+    // The raw frames of a batch are copied under mutex_ and formatted outside it, so Add() (on
+    // the decode sink) waits for a memcpy at most. New frames are picked up by polling, so Add()
+    // never has to wake this thread.
+    void FilterWorker() {
+        std::vector<ImU64> found;
+        std::vector<Frame> frames;
+        std::vector<unsigned char> bytes;
+        char line[LineSize];
+        std::unique_lock<std::mutex> lock(filter_mutex_);
+        while (!quit_) {
+            if (filter_text_.empty() || scanned_ >= total_) {
+                filter_wake_.wait_for(lock, std::chrono::milliseconds(50));
+                continue;
+            }
+            const unsigned gen = filter_gen_;
+            const ImGuiTextFilter filter(filter_text_.c_str());
+            ImU64 from = scanned_, to;
+            lock.unlock();
+            found.clear();
+            {
+                std::lock_guard<std::mutex> log(mutex_);
+                from = ImMax(from, first_.load());
+                const ImU64 local = from - first_;
+                to = ImMin(total_.load(), from + (ChunkFrames - local % ChunkFrames)); // within one chunk
+                frames.clear();
+                if (from < to) { // nothing left if the log was cleared meanwhile
+                    const Chunk& chunk = *chunks_[(size_t)(local / ChunkFrames)];
+                    const Frame* begin = chunk.Frames.data() + local % ChunkFrames;
+                    frames.assign(begin, begin + (to - from));
+                    bytes.assign(chunk.Bytes.begin() + frames.front().Offset, chunk.Bytes.begin() + frames.back().Offset + frames.back().Size);
+                }
+            }
+            const ImU32 base = frames.empty() ? 0 : frames.front().Offset;
+            for (ImU64 idx = from; idx < from + frames.size(); idx++) {
+                const Frame& frame = frames[(size_t)(idx - from)];
+                FormatLine(idx, frame, bytes.data() + (frame.Offset - base), line, sizeof(line));
+                if (filter.PassFilter(line))
+                    found.push_back(idx);
+            }
+            lock.lock();
+            if (gen != filter_gen_)
+                continue; // the filter changed while scanning
+            matches_.insert(matches_.end(), found.begin(), found.end());
+            TrimMatches(); // also while the window is closed
+            scanned_ = to;
+        }
+    }
+
+    std::mutex mutex_;                           // guards chunks_
+    std::deque<std::unique_ptr<Chunk>> chunks_;
+    const size_t max_chunks_;
+    std::atomic<ImU64> first_;                   // index of the oldest retained frame
+    std::atomic<ImU64> total_;                   // frames ever added, index of the next one
+
+    std::mutex filter_mutex_;                    // guards the fields below
+    std::condition_variable filter_wake_;
+    std::thread filter_thread_;
+    std::string filter_text_;
+    unsigned filter_gen_;
+    std::deque<ImU64> matches_;
+    ImU64 matches_popped_;                       // trimmed from the front so far
+    ImU64 scanned_;
+    bool quit_;
+
+    bool auto_scroll_;
+    char filter_buf_[256];
+    const std::chrono::steady_clock::time_point start_;
+};
@@ -0,0 +1,372 @@
+#pragma once
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <limits.h>
+#include <stdlib.h>
+#endif
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+
+// Serial port found by PortScanner
+struct SerialPortInfo {
+    std::string Name;        // COM3, ttyUSB0
+    std::string Path;        // what ComPort::open() takes: \\.\COM3, /dev/ttyUSB0
+    std::string Description; // USB manufacturer and product, otherwise the driver
+    std::string Serial;      // USB serial number, empty if the device has none
+    std::string ById;        // stable /dev/serial/by-id/... link (Linux)
+    unsigned short Vid;      // USB vendor and product id, 0 for other ports
+    unsigned short Pid;
+
+    bool operator==(const SerialPortInfo& o) const {
+        return Name == o.Name && Path == o.Path && Description == o.Description && Serial == o.Serial &&
+               ById == o.ById && Vid == o.Vid && Pid == o.Pid;
+    }
+};
+
+// Keeps the list of serial ports up to date on a background thread: scans once on start, then
+// whenever ports come and go (inotify on /dev on Linux, change notification of
+// HKLM\HARDWARE\DEVICEMAP\SERIALCOMM on Windows) or Rescan() is called. Every change publishes a
+// new immutable snapshot, Ports() hands out the latest one without waiting for a scan.
+class PortScanner {
+public:
+    typedef std::vector<SerialPortInfo> Snapshot;
+
+    PortScanner()
+        : snapshot_(std::make_shared<Snapshot>()), generation_(0), quit_(false) {
+#ifdef _WIN32
+        wake_ = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+#else
+        fd_ = -1;
+        if (pipe(wake_) != 0) {
+            wake_[0] = wake_[1] = -1;
+        } else {
+            fcntl(wake_[0], F_SETFL, O_NONBLOCK);
+        }
+#endif
+        thread_ = std::thread(&PortScanner::Watch, this);
+    }
+
+    ~PortScanner() {
+        quit_ = true;
+        Wake();
+        thread_.join();
+#ifdef _WIN32
+        CloseHandle(wake_);
+#else
+        close(wake_[0]);
+        close(wake_[1]);
+#endif
+    }
+
+    PortScanner(const PortScanner&) = delete;
+    PortScanner& operator=(const PortScanner&) = delete;
+
+    // Latest list of ports, sorted by name. Safe to call from any thread.
+    std::shared_ptr<const Snapshot> Ports() const {
+        return std::atomic_load(&snapshot_);
+    }
+
+    // Changes whenever a scan finds a different list
+    unsigned Generation() const {
+        return generation_;
+    }
+
+    // Asks for a scan now (the result arrives with a new generation if something changed)
+    void Rescan() {
+        Wake();
+    }
+
+    static const SerialPortInfo* FindBySerial(const Snapshot& ports, const std::string& serial) {
+        for (const SerialPortInfo& port : ports) {
+            if (!serial.empty() && port.Serial == serial)
+                return &port;
+        }
+        return nullptr;
+    }
+
+    static const SerialPortInfo* FindByPath(const Snapshot& ports, const std::string& path) {
+        for (const SerialPortInfo& port : ports) {
+            if (port.Path == path)
+                return &port;
+        }
+        return nullptr;
+    }
+
+    // One synchronous scan, called by the background thread
+    static Snapshot Scan() {
+        Snapshot ports;
+#ifdef _WIN32
+        HKEY key;
+        if (RegOpenKeyExA(HKEY_LOCAL_MACHINE, "HARDWARE\\DEVICEMAP\\SERIALCOMM", 0, KEY_READ, &key) == ERROR_SUCCESS) {
+            char value_name[256];
+            char value_data[256];
+            DWORD value_name_len = sizeof(value_name);
+            DWORD value_data_len = sizeof(value_data) - 1;
+            DWORD type;
+            for (DWORD index = 0; RegEnumValueA(key, index, value_name, &value_name_len, nullptr, &type, (LPBYTE)value_data, &value_data_len) == ERROR_SUCCESS; index++) {
+                value_data[value_data_len] = '\0';
+                if (type == REG_SZ) {
+                    SerialPortInfo port = SerialPortInfo();
+                    port.Name = value_data;
+                    port.Path = "\\\\.\\" + port.Name;
+                    port.Description = value_name; // \Device\Serial0, \Device\USBSER000, replaced below for USB devices
+                    ports.push_back(port);
+                }
+                value_name_len = sizeof(value_name);
+                value_data_len = sizeof(value_data) - 1;
+            }
+            RegCloseKey(key);
+        }
+        ReadUsbDevices(ports, "SYSTEM\\CurrentControlSet\\Enum\\USB", '&');
+        ReadUsbDevices(ports, "SYSTEM\\CurrentControlSet\\Enum\\FTDIBUS", '+');
+#else
+        if (DIR* dir = opendir("/sys/class/tty")) {
+            while (dirent* entry = readdir(dir)) {
+                if (entry->d_name[0] == '.')
+                    continue;
+                std::string device = RealPath(std::string("/sys/class/tty/") + entry->d_name + "/device");
+                if (device.empty())
+                    continue; // virtual consoles, ptys
+                std::string subsystem = BaseName(RealPath(device + "/subsystem"));
+                if (subsystem == "serial-base") {
+                    // Linux 6.5+: serial core controller and port devices sit between the tty and the hardware
+                    device = DirName(DirName(device));
+                    subsystem = BaseName(RealPath(device + "/subsystem"));
+                }
+                if (subsystem == "platform")
+                    continue; // ttyS placeholders of the 8250 driver without hardware behind them
+                SerialPortInfo port = SerialPortInfo();
+                port.Name = entry->d_name;
+                port.Path = "/dev/" + port.Name;
+                // ttyUSB: .../usb_device/interface/ttyUSB0, ttyACM: .../usb_device/interface
+                std::string usb_interface;
+                if (subsystem == "usb-serial")
+                    usb_interface = DirName(device);
+                else if (subsystem == "usb")
+                    usb_interface = device;
+                if (!usb_interface.empty()) {
+                    const std::string usb_device = DirName(usb_interface);
+                    port.Vid = (unsigned short)strtoul(ReadLine(usb_device + "/idVendor").c_str(), nullptr, 16);
+                    port.Pid = (unsigned short)strtoul(ReadLine(usb_device + "/idProduct").c_str(), nullptr, 16);
+                    port.Serial = ReadLine(usb_device + "/serial");
+                    port.Description = ReadLine(usb_device + "/manufacturer");
+                    const std::string product = ReadLine(usb_device + "/product");
+                    if (!product.empty())
+                        port.Description += (port.Description.empty() ? "" : " ") + product;
+                } else {
+                    port.Description = BaseName(RealPath(device + "/driver"));
+                }
+                ports.push_back(port);
+            }
+            closedir(dir);
+        }
+        if (DIR* dir = opendir("/dev/serial/by-id")) {
+            while (dirent* entry = readdir(dir)) {
+                if (entry->d_name[0] == '.')
+                    continue;
+                const std::string link = std::string("/dev/serial/by-id/") + entry->d_name;
+                const std::string target = RealPath(link);
+                for (SerialPortInfo& port : ports) {
+                    if (port.Path == target)
+                        port.ById = link;
+                }
+            }
+            closedir(dir);
+        }
+#endif
+        std::sort(ports.begin(), ports.end(), [](const SerialPortInfo& a, const SerialPortInfo& b) { return a.Name < b.Name; });
+        return ports;
+    }
+
+private:
+    enum {
+        PollMs     = 2000, // rescan interval when change notifications are unavailable
+        SettleMs   = 200   // wait for udev to finish the by-id links after a change
+    };
+
+    void Publish(Snapshot ports) {
+        if (ports == *std::atomic_load(&snapshot_))
+            return;
+        std::atomic_store(&snapshot_, std::shared_ptr<const Snapshot>(std::make_shared<Snapshot>(std::move(ports))));
+        generation_++;
+    }
+
+#ifdef _WIN32
+    void Wake() {
+        SetEvent(wake_);
+    }
+
+    void Watch() {
+        HANDLE changed = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+        HKEY key = nullptr;
+        while (!quit_) {
+            // the key only exists while some serial port is present
+            if (key == nullptr && RegOpenKeyExA(HKEY_LOCAL_MACHINE, "HARDWARE\\DEVICEMAP\\SERIALCOMM", 0, KEY_NOTIFY, &key) != ERROR_SUCCESS)
+                key = nullptr;
+            // arm the notification before scanning so a change during the scan is not missed
+            if (key != nullptr && RegNotifyChangeKeyValue(key, FALSE, REG_NOTIFY_CHANGE_LAST_SET, changed, TRUE) != ERROR_SUCCESS) {
+                RegCloseKey(key);
+                key = nullptr;
+            }
+            Publish(Scan());
+            HANDLE handles[2] = { wake_, changed };
+            WaitForMultipleObjects(key != nullptr ? 2 : 1, handles, FALSE, key != nullptr ? INFINITE : (DWORD)PollMs);
+        }
+        if (key != nullptr)
+            RegCloseKey(key);
+        CloseHandle(changed);
+    }
+
+    // Fills in VID/PID, serial number and name of the ports created by USB devices, from
+    // Enum\<bus>\VID_xxxx<sep>PID_xxxx...\<instance>\Device Parameters\PortName. USB devices with a
+    // serial number use it as the instance name, generated instance names contain '&'.
+    // FTDI devices put the serial number after the second '+' of the device key instead.
+    static void ReadUsbDevices(Snapshot& ports, const char* bus, char sep) {
+        HKEY bus_key;
+        if (RegOpenKeyExA(HKEY_LOCAL_MACHINE, bus, 0, KEY_READ, &bus_key) != ERROR_SUCCESS)
+            return;
+        char device_name[256];
+        DWORD device_name_len = sizeof(device_name);
+        for (DWORD i = 0; RegEnumKeyExA(bus_key, i, device_name, &device_name_len, nullptr, nullptr, nullptr, nullptr) == ERROR_SUCCESS; i++) {
+            device_name_len = sizeof(device_name);
+            const char* vid = strstr(device_name, "VID_");
+            const char* pid = strstr(device_name, "PID_");
+            if (vid == nullptr || pid == nullptr)
+                continue;
+            HKEY device_key;
+            if (RegOpenKeyExA(bus_key, device_name, 0, KEY_READ, &device_key) != ERROR_SUCCESS)
+                continue;
+            char instance_name[256];
+            DWORD instance_name_len = sizeof(instance_name);
+            for (DWORD j = 0; RegEnumKeyExA(device_key, j, instance_name, &instance_name_len, nullptr, nullptr, nullptr, nullptr) == ERROR_SUCCESS; j++) {
+                instance_name_len = sizeof(instance_name);
+                HKEY instance_key;
+                if (RegOpenKeyExA(device_key, instance_name, 0, KEY_READ, &instance_key) != ERROR_SUCCESS)
+                    continue;
+                const std::string port_name = ReadString(instance_key, "Device Parameters", "PortName");
+                for (SerialPortInfo& port : ports) {
+                    if (port_name.empty() || port.Name != port_name || port.Vid != 0)
+                        continue;
+                    port.Vid = (unsigned short)strtoul(vid + 4, nullptr, 16);
+                    port.Pid = (unsigned short)strtoul(pid + 4, nullptr, 16);
+                    if (sep == '+') {
+                        const char* serial = strchr(pid, '+');
+                        port.Serial = serial != nullptr ? serial + 1 : "";
+                    } else if (strchr(instance_name, '&') == nullptr) {
+                        port.Serial = instance_name;
+                    }
+                    const std::string friendly_name = ReadString(instance_key, nullptr, "FriendlyName");
+                    if (!friendly_name.empty())
+                        port.Description = friendly_name;
+                }
+                RegCloseKey(instance_key);
+            }
+            RegCloseKey(device_key);
+        }
+        RegCloseKey(bus_key);
+    }
+
+    static std::string ReadString(HKEY key, const char* sub_key, const char* value) {
+        char data[256];
+        DWORD data_len = sizeof(data) - 1;
+        if (RegGetValueA(key, sub_key, value, RRF_RT_REG_SZ, nullptr, data, &data_len) != ERROR_SUCCESS)
+            return std::string();
+        data[sizeof(data) - 1] = '\0';
+        return data;
+    }
+
+    HANDLE wake_;
+#else
+    void Wake() {
+        const char c = 0;
+        if (write(wake_[1], &c, 1) < 0) {
+            // the pipe is full, a wake-up is pending anyway
+        }
+    }
+
+    void Watch() {
+        // tty nodes and the /dev/serial directory are created directly in /dev
+        const int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (fd >= 0 && inotify_add_watch(fd, "/dev", IN_CREATE | IN_DELETE | IN_ATTRIB) < 0) {
+            close(fd);
+            fd_ = -1;
+        } else {
+            fd_ = fd;
+        }
+        while (!quit_) {
+            if (fd_ >= 0)
+                inotify_add_watch(fd_, "/dev/serial/by-id", IN_CREATE | IN_DELETE); // udev adds the links after the node
+            Publish(Scan());
+            pollfd fds[2] = { { wake_[0], POLLIN, 0 }, { fd_, POLLIN, 0 } };
+            if (poll(fds, fd_ >= 0 ? 2 : 1, fd_ >= 0 ? -1 : (int)PollMs) <= 0)
+                continue;
+            Drain(wake_[0]);
+            if (fds[1].revents & POLLIN) {
+                // one plug-in is a burst of events, scan once it has settled
+                do {
+                    Drain(fd_);
+                } while (!quit_ && poll(&fds[1], 1, SettleMs) > 0);
+            }
+        }
+        if (fd_ >= 0)
+            close(fd_);
+    }
+
+    static void Drain(int fd) {
+        char buf[4096];
+        while (read(fd, buf, sizeof(buf)) > 0) {
+        }
+    }
+
+    static std::string RealPath(const std::string& path) {
+        char buf[PATH_MAX];
+        return realpath(path.c_str(), buf) != nullptr ? std::string(buf) : std::string();
+    }
+
+    static std::string BaseName(const std::string& path) {
+        const size_t slash = path.rfind('/');
+        return slash == std::string::npos ? path : path.substr(slash + 1);
+    }
+
+    static std::string DirName(const std::string& path) {
+        const size_t slash = path.rfind('/');
+        return slash == std::string::npos ? std::string() : path.substr(0, slash);
+    }
+
+    // First line of a sysfs attribute, empty if it doesn't exist
+    static std::string ReadLine(const std::string& path) {
+        std::string line;
+        if (FILE* f = fopen(path.c_str(), "r")) {
+            char buf[256];
+            if (fgets(buf, sizeof(buf), f) != nullptr) {
+                line = buf;
+                while (!line.empty() && (line.back() == '\n' || line.back() == ' '))
+                    line.pop_back();
+            }
+            fclose(f);
+        }
+        return line;
+    }
+
+    int wake_[2]; // self-pipe, wakes poll() for Rescan() and shutdown
+    int fd_;      // inotify
+#endif
+
+    std::shared_ptr<const Snapshot> snapshot_; // only accessed through std::atomic_load/atomic_store
+    std::atomic<unsigned> generation_;
+    std::atomic<bool> quit_;
+    std::thread thread_;
+};
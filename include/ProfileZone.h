@@ -0,0 +1,165 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Scoped CPU zones for the frame profiler. PROFILE_ZONE("name") times the rest of the enclosing
+// scope; the name must be a string literal, only the pointer is kept. Each thread writes its
+// finished zones into its own ring with relaxed atomics. The ring is allocated by the first zone
+// on a thread, nothing is allocated or locked after that. Free of ImGui so that imconfig.h can
+// include it (IMGUI_PROFILE_ZONE), the window is FrameProfiler.h.
+class ProfileZones {
+public:
+    struct Zone {
+        const char* Name;
+        uint64_t    Begin, End; // ns, steady_clock
+        int         Depth;      // nesting level on its thread
+        int         Thread;     // index into Threads()
+    };
+
+    enum { RingSize = 1 << 16 }; // zones kept per thread, ~20 s of frames at 60 FPS
+
+    // Never destroyed: zones may still close on other threads during static destruction
+    static ProfileZones& Get() {
+        static ProfileZones* instance = new ProfileZones();
+        return *instance;
+    }
+
+    static uint64_t Now() {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    bool Enabled() const {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    void SetEnabled(bool enabled) {
+        enabled_.store(enabled, std::memory_order_relaxed);
+    }
+
+    // Names the calling thread in the timeline and in captures
+    void SetThreadName(const char* name) {
+        Ring* ring = Local();
+        std::lock_guard<std::mutex> lock(mutex_);
+        ring->Name = name;
+    }
+
+    std::vector<std::string> Threads() {
+        std::vector<std::string> names;
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (std::unique_ptr<Ring>& ring : rings_)
+            names.push_back(ring->Name);
+        return names;
+    }
+
+    // Appends the retained zones of every thread that ended at or after `since`. Per thread the
+    // zones are in the order they closed (children before their parent), so the ring is walked
+    // back from the newest zone and the copy stops at `since`.
+    void Collect(uint64_t since, std::vector<Zone>& out) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t t = 0; t < rings_.size(); t++) {
+            const Ring& ring = *rings_[t];
+            const size_t start = out.size();
+            const uint64_t head = ring.Head.load(std::memory_order_acquire);
+            const uint64_t from = head > RingSize ? head - RingSize : 0;
+            uint64_t i = head;
+            while (i > from) {
+                const Slot& slot = ring.Slots[(i - 1) % RingSize];
+                Zone zone = { slot.Name.load(std::memory_order_relaxed), slot.Begin.load(std::memory_order_relaxed),
+                              slot.End.load(std::memory_order_relaxed), slot.Depth.load(std::memory_order_relaxed), (int)t };
+                if (zone.End < since)
+                    break;
+                out.push_back(zone);
+                i--;
+            }
+            // slots the writer may have reused while copying are dropped, they are the oldest ones
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const uint64_t now = ring.Head.load(std::memory_order_relaxed);
+            if (now >= RingSize && now - RingSize + 1 > i) {
+                const size_t torn = (size_t)(now - RingSize + 1 - i);
+                out.resize(torn < out.size() - start ? out.size() - torn : start);
+            }
+            std::reverse(out.begin() + start, out.end());
+        }
+    }
+
+private:
+    friend class ProfileZone;
+
+    struct Slot {
+        std::atomic<const char*> Name;
+        std::atomic<uint64_t>    Begin, End;
+        std::atomic<int>         Depth;
+    };
+
+    struct Ring {
+        Slot Slots[RingSize];
+        std::atomic<uint64_t> Head; // zones ever closed
+        int Depth;                  // open zones, owner thread only
+        std::string Name;
+
+        Ring() : Head(0), Depth(0), Name("thread") {}
+    };
+
+    ProfileZones() : enabled_(true) {}
+
+    Ring* Local() {
+        static thread_local Ring* ring = nullptr;
+        if (ring == nullptr) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            rings_.emplace_back(new Ring());
+            ring = rings_.back().get();
+        }
+        return ring;
+    }
+
+    std::mutex mutex_;                           // guards rings_ and the names
+    std::vector<std::unique_ptr<Ring>> rings_;
+    std::atomic<bool> enabled_;
+};
+
+class ProfileZone {
+public:
+    explicit ProfileZone(const char* name) : name_(name), ring_(nullptr), begin_(0), depth_(0) {
+        ProfileZones& zones = ProfileZones::Get();
+        if (zones.Enabled()) {
+            ring_ = zones.Local();
+            depth_ = ring_->Depth++;
+            begin_ = ProfileZones::Now();
+        }
+    }
+
+    ~ProfileZone() {
+        if (ring_ == nullptr)
+            return;
+        const uint64_t end = ProfileZones::Now();
+        ring_->Depth--;
+        const uint64_t head = ring_->Head.load(std::memory_order_relaxed);
+        ProfileZones::Slot& slot = ring_->Slots[head % ProfileZones::RingSize];
+        slot.Name.store(name_, std::memory_order_relaxed);
+        slot.Begin.store(begin_, std::memory_order_relaxed);
+        slot.End.store(end, std::memory_order_relaxed);
+        slot.Depth.store(depth_, std::memory_order_relaxed);
+        ring_->Head.store(head + 1, std::memory_order_release);
+    }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+private:
+    const char* name_;
+    ProfileZones::Ring* ring_;
+    uint64_t begin_;
+    int depth_;
+};
+
+#define PROFILE_ZONE_CONCAT2(a, b) a##b
+#define PROFILE_ZONE_CONCAT(a, b)  PROFILE_ZONE_CONCAT2(a, b)
+#define PROFILE_ZONE(name)         ProfileZone PROFILE_ZONE_CONCAT(profile_zone_, __LINE__)(name)
@@ -0,0 +1,215 @@
+#pragma once
+
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <vector>
+
+// Statistics over the samples of the last Window() seconds, kept up to date on every Push()
+// instead of being recomputed over the window: min and max from monotonic deques of sample
+// indices, mean, RMS and standard deviation from compensated (Neumaier) sums of the values
+// shifted by the first one, percentiles from a histogram over the float bit pattern (sign,
+// exponent and 5 mantissa bits, so within about 1.6%) that is counted up and down. Samples are
+// retained for MaxWindow seconds, so SetWindow() only moves over the samples between the old
+// and the new start: it evicts when shrinking and adds the retained older samples when growing.
+// Queries are O(1), percentiles scan a fixed number of bins. Time must not decrease.
+class WindowStats {
+public:
+    explicit WindowStats(double window = 10.0, double max_window = 30.0)
+        : max_window_(max_window), window_(window < max_window ? window : max_window) {
+        Reset();
+    }
+
+    void Reset() {
+        samples_.clear();
+        min_.clear();
+        max_.clear();
+        popped_ = start_ = 0;
+        now_ = 0.0;
+        count_ = 0;
+        shift_ = 0.0;
+        sum_ = Sum();
+        sum_sq_ = Sum();
+        fine_.assign(Bins, 0);
+        coarse_.assign(Bins / FineBins, 0);
+    }
+
+    void Push(double t, float v) {
+        samples_.push_back(Sample{ t, v });
+        const ImU64 index = popped_ + samples_.size() - 1;
+        now_ = t;
+        if (v == v) { // NaN is retained but not counted
+            while (!min_.empty() && At(min_.back()).Value >= v)
+                min_.pop_back();
+            min_.push_back(index);
+            while (!max_.empty() && At(max_.back()).Value <= v)
+                max_.pop_back();
+            max_.push_back(index);
+            Add(v);
+        }
+        Evict();
+    }
+
+    // Up to the maximum window given to the constructor
+    void SetWindow(double seconds) {
+        seconds = seconds < max_window_ ? seconds : max_window_;
+        const bool grow = seconds > window_;
+        window_ = seconds;
+        if (!grow) {
+            Evict();
+            return;
+        }
+        // an older sample enters the min deque only if it is below every later one (the front)
+        while (start_ > popped_ && At(start_ - 1).Time >= now_ - window_) {
+            start_--;
+            const float v = At(start_).Value;
+            if (v != v)
+                continue;
+            if (min_.empty() || v < At(min_.front()).Value)
+                min_.push_front(start_);
+            if (max_.empty() || v > At(max_.front()).Value)
+                max_.push_front(start_);
+            Add(v);
+        }
+    }
+
+    double Window() const { return window_; }
+    double MaxWindow() const { return max_window_; }
+    int Count() const { return count_; }
+    float Min() const { return min_.empty() ? NAN : At(min_.front()).Value; }
+    float Max() const { return max_.empty() ? NAN : At(max_.front()).Value; }
+
+    double Mean() const {
+        return count_ == 0 ? NAN : shift_ + sum_.Value() / count_;
+    }
+
+    double Rms() const {
+        if (count_ == 0)
+            return NAN;
+        const double s1 = sum_.Value() / count_, s2 = sum_sq_.Value() / count_;
+        return sqrt(ImMax(s2 + 2.0 * shift_ * s1 + shift_ * shift_, 0.0));
+    }
+
+    // Sample standard deviation
+    double StdDev() const {
+        if (count_ < 2)
+            return count_ == 0 ? NAN : 0.0;
+        const double s1 = sum_.Value();
+        return sqrt(ImMax((sum_sq_.Value() - s1 * s1 / count_) / (count_ - 1), 0.0));
+    }
+
+    // `p` in [0, 1], the centre of the bin holding that rank, clamped to [Min(), Max()]
+    float Percentile(double p) const {
+        if (count_ == 0)
+            return NAN;
+        ImU32 rank = (ImU32)(p * (count_ - 1) + 0.5);
+        int group = 0;
+        while (rank >= coarse_[group])
+            rank -= coarse_[group++];
+        int bin = group * FineBins;
+        while (rank >= fine_[bin])
+            rank -= fine_[bin++];
+        const float v = FromKey(((ImU32)bin << KeyShift) | (1u << (KeyShift - 1)));
+        return v < Min() ? Min() : v > Max() ? Max() : v;
+    }
+
+private:
+    enum {
+        KeyBits  = 14,             // sign, exponent and 5 mantissa bits
+        KeyShift = 32 - KeyBits,
+        Bins     = 1 << KeyBits,
+        FineBins = 32              // bins per coarse group
+    };
+
+    struct Sample {
+        double Time;
+        float  Value;
+    };
+
+    struct Sum {
+        double S = 0.0, C = 0.0;
+
+        void Add(double x) {
+            const double t = S + x;
+            C += fabs(S) >= fabs(x) ? (S - t) + x : (x - t) + S;
+            S = t;
+        }
+
+        double Value() const { return S + C; }
+    };
+
+    // Order-preserving map of floats to unsigned integers
+    static ImU32 Key(float v) {
+        ImU32 u;
+        memcpy(&u, &v, sizeof(u));
+        return u & 0x80000000u ? ~u : u | 0x80000000u;
+    }
+
+    static float FromKey(ImU32 u) {
+        u = u & 0x80000000u ? u & 0x7FFFFFFFu : ~u;
+        float v;
+        memcpy(&v, &u, sizeof(v));
+        return v;
+    }
+
+    const Sample& At(ImU64 index) const {
+        return samples_[(size_t)(index - popped_)];
+    }
+
+    void Add(float v) {
+        if (count_ == 0) {
+            shift_ = v; // restart the sums, rounding errors do not accumulate across empty windows
+            sum_ = Sum();
+            sum_sq_ = Sum();
+        }
+        count_++;
+        sum_.Add(v - shift_);
+        sum_sq_.Add((v - shift_) * (v - shift_));
+        const ImU32 bin = Key(v) >> KeyShift;
+        fine_[bin]++;
+        coarse_[bin / FineBins]++;
+    }
+
+    void Remove(float v) {
+        count_--;
+        sum_.Add(-(v - shift_));
+        sum_sq_.Add(-(v - shift_) * (v - shift_));
+        const ImU32 bin = Key(v) >> KeyShift;
+        fine_[bin]--;
+        coarse_[bin / FineBins]--;
+    }
+
+    // Moves the start past samples older than the window, drops samples older than the maximum
+    void Evict() {
+        const ImU64 end = popped_ + samples_.size();
+        while (start_ < end && At(start_).Time < now_ - window_) {
+            const float v = At(start_).Value;
+            if (v == v) {
+                if (min_.front() == start_)
+                    min_.pop_front();
+                if (max_.front() == start_)
+                    max_.pop_front();
+                Remove(v);
+            }
+            start_++;
+        }
+        while (popped_ < start_ && samples_.front().Time < now_ - max_window_) {
+            samples_.pop_front();
+            popped_++;
+        }
+    }
+
+    double max_window_;
+    double window_;
+    std::deque<Sample> samples_; // retained for max_window_, the first one has index popped_
+    std::deque<ImU64> min_, max_; // indices, values increasing (min_) or decreasing (max_) to the back
+    ImU64 popped_;
+    ImU64 start_;                // first sample in the window
+    double now_;
+    int count_;                  // samples in the window, NaN excluded
+    double shift_;
+    Sum sum_, sum_sq_;           // of value - shift_
+    std::vector<ImU32> fine_, coarse_;
+};
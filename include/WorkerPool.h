@@ -0,0 +1,113 @@
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <vector>
+
+// Small pool of worker threads for data-parallel loops. ParallelFor() hands out indices
+// to the workers and the calling thread alike and returns once every index is done.
+// One loop runs at a time; ParallelFor() must only be called from one thread.
+class WorkerPool {
+public:
+    typedef void (*Job)(int idx, void* data);
+
+    // threads = 0 picks one worker less than the number of hardware threads
+    explicit WorkerPool(unsigned threads = 0)
+        : job_(nullptr), data_(nullptr), count_(0), next_(0), busy_(0), generation_(0), quit_(false) {
+        if (threads == 0) {
+            unsigned hw = std::thread::hardware_concurrency();
+            threads = hw > 1 ? hw - 1 : 0;
+        }
+        for (unsigned i = 0; i < threads; i++) {
+            workers_.emplace_back(&WorkerPool::Work, this);
+        }
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            quit_ = true;
+        }
+        wake_.notify_all();
+        for (std::thread& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    int threads() const {
+        return (int)workers_.size() + 1;
+    }
+
+    void ParallelFor(Job job, void* data, int count) {
+        if (count <= 0)
+            return;
+        if (workers_.empty() || count == 1) {
+            for (int i = 0; i < count; i++) {
+                job(i, data);
+            }
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            job_ = job;
+            data_ = data;
+            count_ = count;
+            next_ = 0;
+            busy_ = (int)workers_.size();
+            generation_++;
+        }
+        wake_.notify_all();
+        Run();
+        // every worker must be out of Run() before the next loop may reset it
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this] { return busy_ == 0; });
+    }
+
+    // Matches ImPlotParallelFor, pass the pool as user_data to ImPlot::SetParallelForFunc
+    static void ParallelForImPlot(void (*job)(int, void*), void* job_data, int count, void* user_data) {
+        static_cast<WorkerPool*>(user_data)->ParallelFor(job, job_data, count);
+    }
+
+private:
+    // Takes indices until the current loop has none left
+    void Run() {
+        for (int i = next_++; i < count_; i = next_++) {
+            job_(i, data_);
+        }
+    }
+
+    void Work() {
+        unsigned seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [&] { return quit_ || generation_ != seen; });
+                if (quit_)
+                    return;
+                seen = generation_;
+            }
+            Run();
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--busy_ == 0) {
+                done_.notify_one();
+            }
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    Job job_;
+    void* data_;
+    int count_;
+    std::atomic<int> next_;
+    int busy_;
+    unsigned generation_;
+    bool quit_;
+};
@@ -50,6 +50,7 @@
 //#define IMGUI_DISABLE_DEFAULT_ALLOCATORS                  // Don't implement default allocators calling malloc()/free() to avoid linking with them. You will need to call ImGui::SetAllocatorFunctions().
 //#define IMGUI_DISABLE_DEFAULT_FONT                        // Disable default embedded font (ProggyClean.ttf), remove ~9.5 KB from output binary. AddFontDefault() will assert.
 //#define IMGUI_DISABLE_SSE                                 // Disable use of SSE intrinsics even if available
+//#define IMGUI_DISABLE_CRC32_DISPATCH                      // Don't detect the SSE 4.2 crc32 instruction at runtime for ImHashData()/ImHashStr(), always use lookup tables (no effect when compiled with SSE 4.2)
 
 //---- Enable Test Engine / Automation features.
 //#define IMGUI_ENABLE_TEST_ENGINE                          // Enable imgui_test_engine hooks. Generally set automatically by include "imgui_te_config.h", see Test Engine for details.
@@ -62,6 +63,21 @@
 //---- Pack vertex colors as BGRA8 instead of RGBA8 (to avoid converting from one to another). Need dedicated backend support.
 //#define IMGUI_USE_BGRA_PACKED_COLOR
 
+//---- Disable caching the size of recently measured strings in ImFont (e.g. if you call CalcTextSizeA() on the same font from multiple threads)
+//#define IMGUI_DISABLE_FONT_TEXT_RUN_CACHE
+
+//---- Disable reusing ImPlot axis ticks and tick labels across frames: run the locator and format every label each frame
+//#define IMPLOT_DISABLE_TICK_CACHE
+
+//---- Use an open-addressing hash map (ImGuiFlatStorage) for the ID->Index map of ImPool<> (windows' tables, tab bars, ImPlot plots/items...) instead of a sorted ImGuiStorage.
+// O(1) lookups/insertions. Pools are then iterated in insertion order instead of ID order.
+#define IMGUI_USE_FLAT_POOL_MAP
+
+//---- Time NewFrame()/Render(), ImPlot plots/items and the OpenGL3 backend with scoped zones. The macro has to declare an RAII object for the rest of the scope.
+// ProfileZone.h is the app's zone recorder (shown in its Profiler window). Comment out to compile the zones away.
+#include <ProfileZone.h>
+#define IMGUI_PROFILE_ZONE(_NAME)   PROFILE_ZONE(_NAME)
+
 //---- Use legacy CRC32-adler tables (used before 1.91.6), in order to preserve old .ini data that you cannot afford to invalidate.
 //#define IMGUI_USE_LEGACY_CRC32_ADLER
 
@@ -664,15 +664,54 @@ struct ImSpanAllocator
     inline void  GetSpan(int n, ImSpan<T>* span)    { span->set((T*)GetSpanPtrBegin(n), (T*)GetSpanPtrEnd(n)); }
 };
 
+// Helper: ImGuiFlatStorage
+// Same API as ImGuiStorage, but pairs are kept in insertion order and found through an open-addressing index
+// (linear probing over 8-byte slots, so a probe sequence usually stays within one cache line). Insertion is O(1) amortized
+// instead of a sorted insert, queries are O(1) instead of O(Log N). Like ImGuiStorage, pairs are never removed.
+// - Data may be iterated, but is NOT sorted by key. If you fill Data directly, call BuildSortByKey() to rebuild the index.
+// - References are only valid until a new value is added to the storage.
+struct IMGUI_API ImGuiFlatStorage
+{
+    struct Slot { ImGuiID Key; int Index; };    // Index is the position in Data + 1, 0 for an empty slot
+    ImVector<ImGuiStoragePair>  Data;           // Pairs in insertion order
+    ImVector<Slot>              Slots;          // Power of two size, at most half full
+
+    void                Clear()                                             { Data.clear(); Slots.clear(); }
+    int                 GetInt(ImGuiID key, int default_val = 0) const      { const ImGuiStoragePair* p = Find(key); return p ? p->val_i : default_val; }
+    void                SetInt(ImGuiID key, int val)                        { *GetIntRef(key) = val; }
+    bool                GetBool(ImGuiID key, bool default_val = false) const{ return GetInt(key, default_val ? 1 : 0) != 0; }
+    void                SetBool(ImGuiID key, bool val)                      { SetInt(key, val ? 1 : 0); }
+    float               GetFloat(ImGuiID key, float default_val = 0.0f) const { const ImGuiStoragePair* p = Find(key); return p ? p->val_f : default_val; }
+    void                SetFloat(ImGuiID key, float val)                    { *GetFloatRef(key) = val; }
+    void*               GetVoidPtr(ImGuiID key) const                       { const ImGuiStoragePair* p = Find(key); return p ? p->val_p : NULL; }
+    void                SetVoidPtr(ImGuiID key, void* val)                  { *GetVoidPtrRef(key) = val; }
+    int*                GetIntRef(ImGuiID key, int default_val = 0)         { ImGuiStoragePair* p = Find(key); return p ? &p->val_i : &Add(ImGuiStoragePair(key, default_val))->val_i; }
+    bool*               GetBoolRef(ImGuiID key, bool default_val = false)   { return (bool*)GetIntRef(key, default_val ? 1 : 0); }
+    float*              GetFloatRef(ImGuiID key, float default_val = 0.0f)  { ImGuiStoragePair* p = Find(key); return p ? &p->val_f : &Add(ImGuiStoragePair(key, default_val))->val_f; }
+    void**              GetVoidPtrRef(ImGuiID key, void* default_val = NULL){ ImGuiStoragePair* p = Find(key); return p ? &p->val_p : &Add(ImGuiStoragePair(key, default_val))->val_p; }
+    void                BuildSortByKey()                                    { Rehash(Slots.Size); } // Rebuild the index, name kept for API compatibility
+    void                SetAllInt(int val)                                  { for (int i = 0; i < Data.Size; i++) Data[i].val_i = val; }
+
+    ImGuiStoragePair*   Find(ImGuiID key) const;
+    ImGuiStoragePair*   Add(const ImGuiStoragePair& pair);                  // Key must not be present
+    void                Rehash(int slots_count);
+};
+
 // Helper: ImPool<>
 // Basic keyed storage for contiguous instances, slow/amortized insertion, O(1) indexable, O(Log N) queries by ID over a dense/hot buffer,
 // Honor constructor/destructor. Add/remove invalidate all pointers. Indexes have the same lifetime as the associated object.
+// With IMGUI_USE_FLAT_POOL_MAP the ID->Index map is an ImGuiFlatStorage: O(1) insertion and queries, map iteration in insertion order.
 typedef int ImPoolIdx;
+#ifdef IMGUI_USE_FLAT_POOL_MAP
+typedef ImGuiFlatStorage ImPoolMap;
+#else
+typedef ImGuiStorage ImPoolMap;
+#endif
 template<typename T>
 struct ImPool
 {
     ImVector<T>     Buf;        // Contiguous data
-    ImGuiStorage    Map;        // ID->Index
+    ImPoolMap       Map;        // ID->Index
     ImPoolIdx       FreeIdx;    // Next free idx to use
     ImPoolIdx       AliveCount; // Number of active/alive items (for display purpose)
 
@@ -3541,6 +3580,37 @@ namespace ImGui
 // [SECTION] ImFontAtlas internal API
 //-----------------------------------------------------------------------------
 
+// A string measured by CalcTextSizeA() without wrapping
+struct ImFontTextRun
+{
+    ImGuiID                     Hash;       // Hash of Size + Text
+    float                       Size;       // Font size
+    ImU32                       LastUse;    // 0 for an unused entry
+    ImVec2                      TextSize;   // CalcTextSizeA() result
+    ImVector<char>              Text;
+};
+
+// Small set-associative LRU cache of text runs, owned by an ImFont.
+// Entries keep their buffers when evicted so a steady state doesn't allocate.
+// Below MIN_LEN the glyph loop of CalcTextSizeA() is as fast as hashing + comparing the string.
+#ifndef IMGUI_FONT_TEXT_RUN_CACHE_MIN_LEN
+#define IMGUI_FONT_TEXT_RUN_CACHE_MIN_LEN   10      // Shorter strings are not cached
+#endif
+#ifndef IMGUI_FONT_TEXT_RUN_CACHE_MAX_LEN
+#define IMGUI_FONT_TEXT_RUN_CACHE_MAX_LEN   128     // Longer strings are not cached
+#endif
+struct ImFontTextRunCache
+{
+    enum { Sets = 512, Ways = 4 };
+    ImFontTextRun               Runs[Sets * Ways];
+    ImU32                       UseCounter;
+
+    ImFontTextRunCache()        { UseCounter = 0; }
+    void                        Clear() { for (ImFontTextRun& run : Runs) run.LastUse = 0; UseCounter = 0; }
+    ImFontTextRun*              Find(ImGuiID hash, float size, const char* text, const char* text_end);
+    ImFontTextRun*              Add(ImGuiID hash, float size, const char* text, const char* text_end); // Evicts the least recently used run of the set
+};
+
 // This structure is likely to evolve as we add support for incremental atlas updates.
 // Conceptually this could be in ImGuiPlatformIO, but we are far from ready to make this public.
 struct ImFontBuilderIO
@@ -3561,6 +3631,8 @@ IMGUI_API void      ImFontAtlasBuildRender8bppRectFromString(ImFontAtlas* atlas,
 IMGUI_API void      ImFontAtlasBuildRender32bppRectFromString(ImFontAtlas* atlas, int x, int y, int w, int h, const char* in_str, char in_marker_char, unsigned int in_marker_pixel_value);
 IMGUI_API void      ImFontAtlasBuildMultiplyCalcLookupTable(unsigned char out_table[256], float in_multiply_factor);
 IMGUI_API void      ImFontAtlasBuildMultiplyRectAlpha8(const unsigned char table[256], unsigned char* pixels, int x, int y, int w, int h, int stride);
+IMGUI_API bool      ImFontAtlasBuildSaveCache(ImFontAtlas* atlas, const char* filename);   // Save the built texture, glyphs and custom rectangle positions
+IMGUI_API bool      ImFontAtlasBuildLoadCache(ImFontAtlas* atlas, const char* filename);   // Load them instead of calling Build(), if the fonts, sizes, ranges and settings are unchanged
 
 //-----------------------------------------------------------------------------
 // [SECTION] Test Engine specific hooks (imgui_test_engine)
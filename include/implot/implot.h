@@ -505,6 +505,22 @@ struct ImPlotRect {
     ImPlotPoint Max() const                                                      { return ImPlotPoint(X.Max, Y.Max);          }
 };
 
+// Ring (circular) buffer data source. The #count points are stored oldest first starting at #offset and wrap
+// around at #count, i.e. they are the two contiguous spans [offset, count) and [0, offset). #stride is the
+// byte distance between two points, shared by X and Y. Set #sorted_x if X never decreases from the oldest to
+// the newest point (e.g. time), so that plots only process the points within the visible X range.
+template <typename T>
+struct ImPlotRing {
+    const T* Xs;
+    const T* Ys;
+    int      Count;
+    int      Offset;
+    int      Stride;
+    bool     SortedX;
+    ImPlotRing(const T* xs, const T* ys, int count, int offset = 0, bool sorted_x = false, int stride = sizeof(T))
+        : Xs(xs), Ys(ys), Count(count), Offset(offset), Stride(stride), SortedX(sorted_x) { }
+};
+
 // Plot style structure
 struct ImPlotStyle {
     // item styling variables
@@ -592,6 +608,12 @@ typedef ImPlotPoint (*ImPlotGetter)(int idx, void* user_data);
 // Callback signature for axis transform.
 typedef double (*ImPlotTransform)(double value, void* user_data);
 
+// Callback signature for one job of a parallel loop.
+typedef void (*ImPlotJob)(int idx, void* job_data);
+
+// Callback signature for running #count jobs in parallel (see SetParallelForFunc).
+typedef void (*ImPlotParallelFor)(ImPlotJob job, void* job_data, int count, void* user_data);
+
 namespace ImPlot {
 
 //-----------------------------------------------------------------------------
@@ -857,6 +879,7 @@ IMPLOT_API void SetNextAxesToFit();
 // Plots a standard 2D line plot.
 IMPLOT_TMP void PlotLine(const char* label_id, const T* values, int count, double xscale=1, double xstart=0, ImPlotLineFlags flags=0, int offset=0, int stride=sizeof(T));
 IMPLOT_TMP void PlotLine(const char* label_id, const T* xs, const T* ys, int count, ImPlotLineFlags flags=0, int offset=0, int stride=sizeof(T));
+IMPLOT_TMP void PlotLine(const char* label_id, const ImPlotRing<T>& ring, ImPlotLineFlags flags=0);
 IMPLOT_API void PlotLineG(const char* label_id, ImPlotGetter getter, void* data, int count, ImPlotLineFlags flags=0);
 
 // Plots a standard 2D scatter plot. Default marker is ImPlotMarker_Circle.
@@ -867,12 +890,14 @@ IMPLOT_API void PlotScatterG(const char* label_id, ImPlotGetter getter, void* da
 // Plots a a stairstep graph. The y value is continued constantly to the right from every x position, i.e. the interval [x[i], x[i+1]) has the value y[i]
 IMPLOT_TMP void PlotStairs(const char* label_id, const T* values, int count, double xscale=1, double xstart=0, ImPlotStairsFlags flags=0, int offset=0, int stride=sizeof(T));
 IMPLOT_TMP void PlotStairs(const char* label_id, const T* xs, const T* ys, int count, ImPlotStairsFlags flags=0, int offset=0, int stride=sizeof(T));
+IMPLOT_TMP void PlotStairs(const char* label_id, const ImPlotRing<T>& ring, ImPlotStairsFlags flags=0);
 IMPLOT_API void PlotStairsG(const char* label_id, ImPlotGetter getter, void* data, int count, ImPlotStairsFlags flags=0);
 
 // Plots a shaded (filled) region between two lines, or a line and a horizontal reference. Set yref to +/-INFINITY for infinite fill extents.
 IMPLOT_TMP void PlotShaded(const char* label_id, const T* values, int count, double yref=0, double xscale=1, double xstart=0, ImPlotShadedFlags flags=0, int offset=0, int stride=sizeof(T));
 IMPLOT_TMP void PlotShaded(const char* label_id, const T* xs, const T* ys, int count, double yref=0, ImPlotShadedFlags flags=0, int offset=0, int stride=sizeof(T));
 IMPLOT_TMP void PlotShaded(const char* label_id, const T* xs, const T* ys1, const T* ys2, int count, ImPlotShadedFlags flags=0, int offset=0, int stride=sizeof(T));
+IMPLOT_TMP void PlotShaded(const char* label_id, const ImPlotRing<T>& ring, double yref=0, ImPlotShadedFlags flags=0);
 IMPLOT_API void PlotShadedG(const char* label_id, ImPlotGetter getter1, void* data1, ImPlotGetter getter2, void* data2, int count, ImPlotShadedFlags flags=0);
 
 // Plots a bar graph. Vertical by default. #bar_size and #shift are in plot units.
@@ -911,6 +936,7 @@ IMPLOT_TMP double PlotHistogram2D(const char* label_id, const T* xs, const T* ys
 
 // Plots digital data. Digital plots do not respond to y drag or zoom, and are always referenced to the bottom of the plot.
 IMPLOT_TMP void PlotDigital(const char* label_id, const T* xs, const T* ys, int count, ImPlotDigitalFlags flags=0, int offset=0, int stride=sizeof(T));
+IMPLOT_TMP void PlotDigital(const char* label_id, const ImPlotRing<T>& ring, ImPlotDigitalFlags flags=0);
 IMPLOT_API void PlotDigitalG(const char* label_id, ImPlotGetter getter, void* data, int count, ImPlotDigitalFlags flags=0);
 
 // Plots an axis-aligned image. #bounds_min/bounds_max are in plot coordinates (y-up) and #uv0/uv1 are in texture coordinates (y-down).
@@ -1000,6 +1026,25 @@ IMPLOT_API void CancelPlotSelection();
 // Use ImPlotCond_Always if you need to forcefully set this every frame.
 IMPLOT_API void HideNextItem(bool hidden = true, ImPlotCond cond = ImPlotCond_Once);
 
+// Plots the next item in retained mode. The geometry generated for it is cached and reused on
+// later frames as long as #data_version, the item's style and the axes scales are unchanged.
+// Panning reuses it with a translation if none of it was culled. Bump #data_version whenever
+// the item's data changes. Supported by items that fit their data (i.e. not PlotDigital/PlotText).
+IMPLOT_API void SetNextItemRetained(ImU64 data_version);
+
+// Line, scatter and stairs items plotted between these calls don't generate their vertices immediately.
+// Each item's vertices are generated into a private draw list by a job, the jobs run in parallel on
+// EndParallelItems (see SetParallelForFunc) and are merged into the plot in submission order. Data and
+// getter callbacks passed to these items must stay valid (and be thread-safe) until EndParallelItems.
+// Other items plotted in between, items in retained mode and anything drawn through GetPlotDrawList
+// are drawn immediately, after the pending jobs of earlier items. Must be called between BeginPlot and EndPlot.
+IMPLOT_API void BeginParallelItems();
+IMPLOT_API void EndParallelItems();
+
+// Sets the function used by EndParallelItems to run its jobs. It must call job(i, job_data) once for
+// every i in [0, count) and return when all calls have finished. Without one, BeginParallelItems has no effect.
+IMPLOT_API void SetParallelForFunc(ImPlotParallelFor func, void* user_data = nullptr);
+
 // Use the following around calls to Begin/EndPlot to align l/r/t/b padding.
 // Consider using Begin/EndSubplots first. They are more feature rich and
 // accomplish the same behaviour by default. The functions below offer lower
@@ -1221,6 +1266,7 @@ IMPLOT_API void ItemIcon(ImU32 col);
 IMPLOT_API void ColormapIcon(ImPlotColormap cmap);
 
 // Get the plot draw list for custom rendering to the current plot area. Call between Begin/EndPlot.
+// Merges the pending geometry of parallel items first (see BeginParallelItems).
 IMPLOT_API ImDrawList* GetPlotDrawList();
 // Push clip rect for rendering to current plot area. The rect can be expanded or contracted by #expand pixels. Call between Begin/EndPlot.
 IMPLOT_API void PushPlotClipRect(float expand=0);
@@ -539,6 +539,7 @@ struct ImPlotTick
     bool   ShowLabel;
     int    Level;
     int    Idx;
+    ImGuiID LabelKey;
 
     ImPlotTick(double value, bool major, int level, bool show_label) {
         PixelPos     = 0;
@@ -547,6 +548,7 @@ struct ImPlotTick
         ShowLabel    = show_label;
         Level        = level;
         TextOffset   = -1;
+        LabelKey     = 0;
     }
 };
 
@@ -557,8 +559,17 @@ struct ImPlotTicker {
     ImVec2               MaxSize;
     ImVec2               LateSize;
     int                  Levels;
+    ImGuiID              LabelSeed;       // non-zero if labels produced by the axis formatter can be reused across frames (see SetupFinish)
+    ImGuiID              LocateKey;       // identifies the Locator call which produced Ticks this frame, or 0
+
+    // the ticks and labels of the previous frame
+    ImVector<ImPlotTick> CachedTicks;
+    ImGuiTextBuffer      CachedText;
+    ImGuiStorage         CachedLabels;    // ImPlotTick::LabelKey -> index into CachedTicks
+    ImGuiID              CachedLocateKey;
 
     ImPlotTicker() {
+        LabelSeed = LocateKey = CachedLocateKey = 0;
         Reset();
     }
 
@@ -573,13 +584,28 @@ struct ImPlotTicker {
     }
 
     ImPlotTick& AddTick(double value, bool major, int level, bool show_label, ImPlotFormatter formatter, void* data) {
+        return AddTick(value, major, level, show_label, formatter, data, LabelSeed);
+    }
+
+    // Same as above, but if label_seed is non-zero the label and its size are taken from the previous frame's tick
+    // of the same value, if any. label_seed must identify everything the label depends on other than the value.
+    ImPlotTick& AddTick(double value, bool major, int level, bool show_label, ImPlotFormatter formatter, void* data, ImGuiID label_seed) {
         ImPlotTick tick(value, major, level, show_label);
         if (show_label && formatter != nullptr) {
-            char buff[IMPLOT_LABEL_MAX_SIZE];
             tick.TextOffset = TextBuffer.size();
-            formatter(tick.PlotPos, buff, sizeof(buff), data);
-            TextBuffer.append(buff, buff + strlen(buff) + 1);
-            tick.LabelSize = ImGui::CalcTextSize(TextBuffer.Buf.Data + tick.TextOffset);
+            tick.LabelKey   = label_seed != 0 ? ImHashData(&tick.PlotPos, sizeof(double), label_seed) : 0;
+            const int cached = tick.LabelKey != 0 ? CachedLabels.GetInt(tick.LabelKey, -1) : -1;
+            if (cached >= 0) {
+                const char* label = CachedText.Buf.Data + CachedTicks[cached].TextOffset;
+                TextBuffer.append(label, label + strlen(label) + 1);
+                tick.LabelSize = CachedTicks[cached].LabelSize;
+            }
+            else {
+                char buff[IMPLOT_LABEL_MAX_SIZE];
+                formatter(tick.PlotPos, buff, sizeof(buff), data);
+                TextBuffer.append(buff, buff + strlen(buff) + 1);
+                tick.LabelSize = ImGui::CalcTextSize(TextBuffer.Buf.Data + tick.TextOffset);
+            }
         }
         return AddTick(tick);
     }
@@ -607,7 +633,37 @@ struct ImPlotTicker {
         LateSize.y = size.y > LateSize.y ? size.y : LateSize.y;
     }
 
+    // Takes back the previous frame's ticks if they were produced by a Locator call with the same key. Returns
+    // false if the Locator must be run. A key of 0 never matches.
+    bool RestoreLocated(ImGuiID key) {
+        LocateKey = Ticks.Size == 0 ? key : 0; // user custom ticks are not part of the key
+        if (LocateKey == 0 || LocateKey != CachedLocateKey)
+            return false;
+        Ticks.swap(CachedTicks);
+        TextBuffer.Buf.swap(CachedText.Buf);
+        CachedLabels.Clear();
+        for (int i = 0; i < Ticks.Size; ++i) {
+            if (Ticks[i].TextOffset >= 0) {
+                MaxSize.x = Ticks[i].LabelSize.x > MaxSize.x ? Ticks[i].LabelSize.x : MaxSize.x;
+                MaxSize.y = Ticks[i].LabelSize.y > MaxSize.y ? Ticks[i].LabelSize.y : MaxSize.y;
+            }
+        }
+        return true;
+    }
+
     void Reset() {
+        // this frame's ticks and labels become the cache for the next one
+        Ticks.swap(CachedTicks);
+        TextBuffer.Buf.swap(CachedText.Buf);
+        CachedLabels.Data.shrink(0);
+        for (int i = 0; i < CachedTicks.Size; ++i) {
+            if (CachedTicks[i].LabelKey != 0)
+                CachedLabels.Data.push_back(ImGuiStoragePair(CachedTicks[i].LabelKey, i));
+        }
+        CachedLabels.BuildSortByKey();
+        CachedLocateKey = LocateKey;
+        LocateKey = 0;
+        LabelSeed = 0;
         Ticks.shrink(0);
         TextBuffer.Buf.shrink(0);
         MaxSize = LateSize;
@@ -936,16 +992,61 @@ struct ImPlotAlignmentData {
     void Reset() { PadA = PadB = PadAMax = PadBMax = 0; }
 };
 
+// Geometry generated by an item plotted in retained mode (see SetNextItemRetained)
+struct ImPlotRetainedGeometry
+{
+    ImGuiID              Key;       // hash of data version, staged style, flags and non-linear axis state
+    ImPlotPoint          Scale;     // x/y axis ScaleToPixel when generated
+    ImPlotPoint          PixelMin;  // x/y axis PixelMin when generated
+    ImPlotPoint          PlotMin;   // x/y axis Range.Min when generated
+    ImRect               CullRect;  // plot rect when generated
+    bool                 Complete;  // no primitive was culled, so the geometry can be translated when panning
+    ImVector<ImDrawVert> VtxBuffer;
+    ImVector<ImDrawIdx>  IdxBuffer; // relative to the first vertex
+    ImU64                Version;   // data version of the last BeginRetainedItem, kept across Clear()
+    bool                 Changing;  // the data version changed on the last BeginRetainedItem
+
+    ImPlotRetainedGeometry() { Key = 0; Complete = false; Version = 0; Changing = false; }
+
+    void Clear() { Key = 0; Complete = false; VtxBuffer.shrink(0); IdxBuffer.shrink(0); }
+};
+
+// Destination in the plot draw list of one draw command of a job's private draw list
+struct ImPlotPrimitivesCopy
+{
+    int          SrcCmd;
+    int          VtxCount;
+    ImDrawVert*  VtxDst;
+    ImDrawIdx*   IdxDst;
+    unsigned int VtxBase;  // added to the source indices
+};
+
+// Deferred primitive generation of one plot item (see BeginParallelItems)
+struct ImPlotPrimitivesJob
+{
+    ImVec4      ClipRect;  // plot draw list clip rect when submitted
+    ImRect      CullRect;
+    int         VtxCount;  // upper bounds, reserved before the job runs so that workers don't allocate
+    int         IdxCount;
+    ImDrawList* DrawList;  // private draw list the job renders into
+    ImVector<ImPlotPrimitivesCopy> Copies;
+
+    ImPlotPrimitivesJob() { VtxCount = IdxCount = 0; DrawList = nullptr; }
+    virtual ~ImPlotPrimitivesJob() { }
+    virtual void Render() = 0;
+};
+
 // State information for Plot items
 struct ImPlotItem
 {
-    ImGuiID      ID;
-    ImU32        Color;
-    ImRect       LegendHoverRect;
-    int          NameOffset;
-    bool         Show;
-    bool         LegendHovered;
-    bool         SeenThisFrame;
+    ImGuiID                ID;
+    ImU32                  Color;
+    ImRect                 LegendHoverRect;
+    int                    NameOffset;
+    bool                   Show;
+    bool                   LegendHovered;
+    bool                   SeenThisFrame;
+    ImPlotRetainedGeometry Retained;
 
     ImPlotItem() {
         ID            = 0;
@@ -1190,6 +1291,9 @@ struct ImPlotNextItemData {
     bool            HasHidden;
     bool            Hidden;
     ImPlotCond      HiddenCond;
+    bool            HasRetained;
+    ImU64           RetainedVersion;
+    bool            InputClipped;   // the getter passes only part of the data (see GetRingWindow)
     ImPlotNextItemData() { Reset(); }
     void Reset() {
         for (int i = 0; i < 5; ++i)
@@ -1197,6 +1301,8 @@ struct ImPlotNextItemData {
         LineWeight    = MarkerSize = MarkerWeight = FillAlpha = ErrorBarSize = ErrorBarWeight = DigitalBitHeight = DigitalBitGap = IMPLOT_AUTO;
         Marker        = IMPLOT_AUTO;
         HasHidden     = Hidden = false;
+        HasRetained   = false;
+        InputClipped  = false;
     }
 };
 
@@ -1242,6 +1348,25 @@ struct ImPlotContext {
     ImGuiTextBuffer    MousePosStringBuilder;
     ImPlotItemGroup*   SortItems;
 
+    // Retained item capture
+    ImGuiID            RetainedKey;         // key of the item currently being captured, 0 if none
+    int                RetainedVtxStart;
+    int                RetainedIdxStart;
+    int                RetainedCmdCount;
+    unsigned int       RetainedVtxOffset;
+    unsigned int       RetainedBaseIdx;
+    int                RetainedVtxRendered; // vertices emitted by RenderPrimitives during capture
+    int                RetainedPrimsCulled; // primitives culled by RenderPrimitives during capture
+
+    // Parallel primitive generation
+    bool                           ParallelItems;       // between BeginParallelItems and EndParallelItems
+    bool                           ParallelNextItem;    // the next item's primitives may be deferred
+    bool                           ParallelCurrentItem; // the current item's primitives are being deferred
+    ImVector<ImPlotPrimitivesJob*> ParallelJobs;
+    ImVector<ImDrawList*>          ParallelDrawLists;   // one per job, kept across frames
+    ImPlotParallelFor              ParallelFor;
+    void*                          ParallelForUserData;
+
     // Align plots
     ImPool<ImPlotAlignmentData> AlignmentData;
     ImPlotAlignmentData*        CurrentAlignmentH;
@@ -1311,21 +1436,32 @@ IMPLOT_API void ShowSubplotsContextMenu(ImPlotSubplot& subplot);
 // Begins a new item. Returns false if the item should not be plotted. Pushes PlotClipRect.
 IMPLOT_API bool BeginItem(const char* label_id, ImPlotItemFlags flags=0, ImPlotCol recolor_from=IMPLOT_AUTO);
 
-// Same as above but with fitting functionality.
+// Splices the current item's retained geometry into the plot draw list and returns true if it is still valid.
+// Otherwise starts capturing the geometry generated until EndItem and returns false.
+IMPLOT_API bool BeginRetainedItem(ImPlotItemFlags flags);
+
+// Ends an item (call only if BeginItem returns true). Pops PlotClipRect.
+IMPLOT_API void EndItem();
+
+// Runs the pending jobs of items plotted since BeginParallelItems and merges their geometry into the plot draw list.
+IMPLOT_API void FlushParallelItems();
+
+// Same as BeginItem but with fitting functionality.
 template <typename _Fitter>
 bool BeginItemEx(const char* label_id, const _Fitter& fitter, ImPlotItemFlags flags=0, ImPlotCol recolor_from=IMPLOT_AUTO) {
     if (BeginItem(label_id, flags, recolor_from)) {
         ImPlotPlot& plot = *GetCurrentPlot();
         if (plot.FitThisFrame && !ImHasFlag(flags, ImPlotItemFlags_NoFit))
             fitter.Fit(plot.Axes[plot.CurrentX], plot.Axes[plot.CurrentY]);
+        if (GImPlot->NextItemData.HasRetained && BeginRetainedItem(flags)) {
+            EndItem();
+            return false;
+        }
         return true;
     }
     return false;
 }
 
-// Ends an item (call only if BeginItem returns true). Pops PlotClipRect.
-IMPLOT_API void EndItem();
-
 // Register or get an existing item from the current plot.
 IMPLOT_API ImPlotItem* RegisterOrGetItem(const char* label_id, ImPlotItemFlags flags, bool* just_created = nullptr);
 // Get a plot item from the current plot.
@@ -2205,28 +2205,198 @@ static const ImU32 GCrc32LookupTable[256] =
 };
 #endif
 
-// Known size hash
-// It is ok to call ImHashData on a string with known length but the ### operator won't be supported.
-// FIXME-OPT: Replace with e.g. FNV1a hash? CRC32 pretty much randomly access 1KB. Need to do proper measurements.
-ImGuiID ImHashData(const void* data_p, size_t data_size, ImGuiID seed)
+// Runtime dispatch to the SSE 4.2 crc32 instruction when the build does not target it (e.g. default MSVC/GCC x64 builds).
+// Both paths compute the same CRC32c, so IDs and .ini data don't depend on the CPU. Define IMGUI_DISABLE_CRC32_DISPATCH to always use tables.
+#if !defined(IMGUI_ENABLE_SSE4_2_CRC) && !defined(IMGUI_USE_LEGACY_CRC32_ADLER) && !defined(IMGUI_DISABLE_CRC32_DISPATCH) && !defined(IMGUI_DISABLE_SSE) && !defined(__EMSCRIPTEN__) && (defined(__x86_64__) || defined(_M_X64))
+#define IMGUI_ENABLE_CRC32_DISPATCH
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>         // __cpuid
+#define IM_TARGET_SSE4_2
+#else
+#include <cpuid.h>          // __get_cpuid
+#define IM_TARGET_SSE4_2 __attribute__((target("sse4.2")))
+#endif
+#endif
+
+// True if one of the 8 (or 4) bytes at 'data' is a '#', which may start a "###" and needs the byte-wise path in ImHashStr()
+static inline bool ImHashHas8Sharp(const unsigned char* data)
 {
-    ImU32 crc = ~seed;
-    const unsigned char* data = (const unsigned char*)data_p;
-    const unsigned char *data_end = (const unsigned char*)data_p + data_size;
+    ImU64 v;
+    memcpy(&v, data, 8); // byte order doesn't matter for the zero-byte test below
+    v ^= 0x2323232323232323ULL;
+    return ((v - 0x0101010101010101ULL) & ~v & 0x8080808080808080ULL) != 0;
+}
+
+static inline bool ImHashHas4Sharp(const unsigned char* data)
+{
+    ImU32 v;
+    memcpy(&v, data, 4);
+    v ^= 0x23232323;
+    return ((v - 0x01010101) & ~v & 0x80808080) != 0;
+}
+
 #ifndef IMGUI_ENABLE_SSE4_2_CRC
-    const ImU32* crc32_lut = GCrc32LookupTable;
-    while (data < data_end)
-        crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ *data++];
+// Slice-by-8 tables derived from GCrc32LookupTable, to process 8 bytes per step instead of doing 8 dependent lookups.
+// Built on first use (function-local static, so it is thread-safe and usable from static constructors).
+struct ImHashCrc32Tables
+{
+    ImU32   Slice[8][256];
+    bool    HasSse42Crc;
+
+    ImHashCrc32Tables()
+    {
+        for (int i = 0; i < 256; i++)
+            Slice[0][i] = GCrc32LookupTable[i];
+        for (int k = 1; k < 8; k++)
+            for (int i = 0; i < 256; i++)
+                Slice[k][i] = (Slice[k - 1][i] >> 8) ^ Slice[0][Slice[k - 1][i] & 0xFF];
+        HasSse42Crc = false;
+#ifdef IMGUI_ENABLE_CRC32_DISPATCH
+#if defined(_MSC_VER) && !defined(__clang__)
+        int info[4];
+        __cpuid(info, 1);
+        HasSse42Crc = (info[2] & (1 << 20)) != 0;
+#else
+        unsigned int eax, ebx, ecx, edx;
+        HasSse42Crc = __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & (1 << 20)) != 0;
+#endif
+#endif
+    }
+};
+
+static const ImHashCrc32Tables& ImHashGetCrc32Tables()
+{
+    static const ImHashCrc32Tables tables;
+    return tables;
+}
+
+static inline ImU32 ImCrc32Table8(const ImU32 (*t)[256], ImU32 crc, const unsigned char* d)
+{
+    const ImU32 lo = crc ^ ((ImU32)d[0] | ((ImU32)d[1] << 8) | ((ImU32)d[2] << 16) | ((ImU32)d[3] << 24));
+    return t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24] ^ t[3][d[4]] ^ t[2][d[5]] ^ t[1][d[6]] ^ t[0][d[7]];
+}
+
+static inline ImU32 ImCrc32Table4(const ImU32 (*t)[256], ImU32 crc, const unsigned char* d)
+{
+    const ImU32 lo = crc ^ ((ImU32)d[0] | ((ImU32)d[1] << 8) | ((ImU32)d[2] << 16) | ((ImU32)d[3] << 24));
+    return t[3][lo & 0xFF] ^ t[2][(lo >> 8) & 0xFF] ^ t[1][(lo >> 16) & 0xFF] ^ t[0][lo >> 24];
+}
+
+static ImGuiID ImHashDataTable(const ImU32 (*t)[256], const unsigned char* data, size_t data_size, ImU32 crc)
+{
+    for (; data_size >= 8; data += 8, data_size -= 8)
+        crc = ImCrc32Table8(t, crc, data);
+    if (data_size >= 4)
+    {
+        crc = ImCrc32Table4(t, crc, data);
+        data += 4;
+        data_size -= 4;
+    }
+    while (data_size-- != 0)
+        crc = (crc >> 8) ^ t[0][(crc & 0xFF) ^ *data++];
     return ~crc;
+}
+
+static ImGuiID ImHashStrTable(const ImU32 (*t)[256], const unsigned char* data, size_t data_size, ImU32 seed)
+{
+    ImU32 crc = seed;
+    for (;;)
+    {
+        if (data_size >= 8 && !ImHashHas8Sharp(data))
+        {
+            crc = ImCrc32Table8(t, crc, data);
+            data += 8;
+            data_size -= 8;
+            continue;
+        }
+        if (data_size >= 4 && !ImHashHas4Sharp(data))
+        {
+            crc = ImCrc32Table4(t, crc, data);
+            data += 4;
+            data_size -= 4;
+            continue;
+        }
+        if (data_size-- == 0)
+            break;
+        unsigned char c = *data++;
+        if (c == '#' && data_size >= 2 && data[0] == '#' && data[1] == '#')
+            crc = seed;
+        crc = (crc >> 8) ^ t[0][(crc & 0xFF) ^ c];
+    }
+    return ~crc;
+}
+#endif // #ifndef IMGUI_ENABLE_SSE4_2_CRC
+
+#if defined(IMGUI_ENABLE_SSE4_2_CRC) || defined(IMGUI_ENABLE_CRC32_DISPATCH)
+#ifndef IM_TARGET_SSE4_2
+#define IM_TARGET_SSE4_2
+#endif
+#if defined(__x86_64__) || defined(_M_X64)
+#define IM_CRC32_U64(CRC, DATA)    (ImU32)_mm_crc32_u64(CRC, *(const ImU64*)(const void*)(DATA))
 #else
-    while (data + 4 <= data_end)
+#define IM_CRC32_U64(CRC, DATA)    _mm_crc32_u32(_mm_crc32_u32(CRC, *(const ImU32*)(const void*)(DATA)), *(const ImU32*)(const void*)((DATA) + 4))
+#endif
+
+IM_TARGET_SSE4_2 static ImGuiID ImHashDataSse42(const unsigned char* data, size_t data_size, ImU32 crc)
+{
+    for (; data_size >= 8; data += 8, data_size -= 8)
+        crc = IM_CRC32_U64(crc, data);
+    if (data_size >= 4)
     {
-        crc = _mm_crc32_u32(crc, *(ImU32*)data);
+        crc = _mm_crc32_u32(crc, *(const ImU32*)(const void*)data);
         data += 4;
+        data_size -= 4;
     }
-    while (data < data_end)
+    while (data_size-- != 0)
         crc = _mm_crc32_u8(crc, *data++);
     return ~crc;
+}
+
+IM_TARGET_SSE4_2 static ImGuiID ImHashStrSse42(const unsigned char* data, size_t data_size, ImU32 seed)
+{
+    ImU32 crc = seed;
+    for (;;)
+    {
+        if (data_size >= 8 && !ImHashHas8Sharp(data))
+        {
+            crc = IM_CRC32_U64(crc, data);
+            data += 8;
+            data_size -= 8;
+            continue;
+        }
+        if (data_size >= 4 && !ImHashHas4Sharp(data))
+        {
+            crc = _mm_crc32_u32(crc, *(const ImU32*)(const void*)data);
+            data += 4;
+            data_size -= 4;
+            continue;
+        }
+        if (data_size-- == 0)
+            break;
+        unsigned char c = *data++;
+        if (c == '#' && data_size >= 2 && data[0] == '#' && data[1] == '#')
+            crc = seed;
+        crc = _mm_crc32_u8(crc, c);
+    }
+    return ~crc;
+}
+#endif
+
+// Known size hash
+// It is ok to call ImHashData on a string with known length but the ### operator won't be supported.
+// CRC32c over 8 bytes per step: crc32 instruction if available (at compile time or runtime), slice-by-8 tables otherwise.
+ImGuiID ImHashData(const void* data_p, size_t data_size, ImGuiID seed)
+{
+    const unsigned char* data = (const unsigned char*)data_p;
+#if defined(IMGUI_ENABLE_SSE4_2_CRC)
+    return ImHashDataSse42(data, data_size, ~seed);
+#else
+    const ImHashCrc32Tables& tables = ImHashGetCrc32Tables();
+#ifdef IMGUI_ENABLE_CRC32_DISPATCH
+    if (tables.HasSse42Crc)
+        return ImHashDataSse42(data, data_size, ~seed);
+#endif
+    return ImHashDataTable(tables.Slice, data, data_size, ~seed);
 #endif
 }
 
@@ -2234,44 +2404,22 @@ ImGuiID ImHashData(const void* data_p, size_t data_size, ImGuiID seed)
 // We support a syntax of "label###id" where only "###id" is included in the hash, and only "label" gets displayed.
 // Because this syntax is rarely used we are optimizing for the common case.
 // - If we reach ### in the string we discard the hash so far and reset to the seed.
-// - We don't do 'current += 2; continue;' after handling ### to keep the code smaller/faster (measured ~10% diff in Debug build)
-// FIXME-OPT: Replace with e.g. FNV1a hash? CRC32 pretty much randomly access 1KB. Need to do proper measurements.
+// - 8-byte blocks without any '#' are hashed at once, others go byte by byte so the ### check sees every position.
 ImGuiID ImHashStr(const char* data_p, size_t data_size, ImGuiID seed)
 {
-    seed = ~seed;
-    ImU32 crc = seed;
     const unsigned char* data = (const unsigned char*)data_p;
-#ifndef IMGUI_ENABLE_SSE4_2_CRC
-    const ImU32* crc32_lut = GCrc32LookupTable;
-#endif
-    if (data_size != 0)
-    {
-        while (data_size-- != 0)
-        {
-            unsigned char c = *data++;
-            if (c == '#' && data_size >= 2 && data[0] == '#' && data[1] == '#')
-                crc = seed;
-#ifndef IMGUI_ENABLE_SSE4_2_CRC
-            crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ c];
+    if (data_size == 0)
+        data_size = strlen(data_p);
+#if defined(IMGUI_ENABLE_SSE4_2_CRC)
+    return ImHashStrSse42(data, data_size, ~seed);
 #else
-            crc = _mm_crc32_u8(crc, c);
+    const ImHashCrc32Tables& tables = ImHashGetCrc32Tables();
+#ifdef IMGUI_ENABLE_CRC32_DISPATCH
+    if (tables.HasSse42Crc)
+        return ImHashStrSse42(data, data_size, ~seed);
 #endif
-        }
-    }
-    else
-    {
-        while (unsigned char c = *data++)
-        {
-            if (c == '#' && data[0] == '#' && data[1] == '#')
-                crc = seed;
-#ifndef IMGUI_ENABLE_SSE4_2_CRC
-            crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ c];
-#else
-            crc = _mm_crc32_u8(crc, c);
+    return ImHashStrTable(tables.Slice, data, data_size, ~seed);
 #endif
-        }
-    }
-    return ~crc;
 }
 
 //-----------------------------------------------------------------------------
@@ -2782,6 +2930,68 @@ void ImGuiStorage::SetAllInt(int v)
     for (int i = 0; i < Data.Size; i++)
         Data[i].val_i = v;
 }
+
+// IDs are already hashes, but ImHashData() of small integers/pointers is not guaranteed to spread over the low bits we mask with.
+static inline unsigned int ImGuiFlatStorageHash(ImGuiID key)
+{
+    key ^= key >> 16;
+    key *= 0x7FEB352D;
+    key ^= key >> 15;
+    return key;
+}
+
+ImGuiStoragePair* ImGuiFlatStorage::Find(ImGuiID key) const
+{
+    if (Slots.Size == 0)
+        return NULL;
+    const unsigned int mask = (unsigned int)Slots.Size - 1;
+    for (unsigned int n = ImGuiFlatStorageHash(key) & mask; ; n = (n + 1) & mask)
+    {
+        const Slot& slot = Slots.Data[n];
+        if (slot.Index == 0)
+            return NULL;
+        if (slot.Key == key)
+            return const_cast<ImGuiStoragePair*>(&Data.Data[slot.Index - 1]);
+    }
+}
+
+ImGuiStoragePair* ImGuiFlatStorage::Add(const ImGuiStoragePair& pair)
+{
+    IM_ASSERT(Find(pair.key) == NULL);
+    Data.push_back(pair);
+    if (Data.Size * 2 > Slots.Size)
+        Rehash(ImMax(16, Slots.Size * 2)); // Also inserts the new pair
+    else
+    {
+        const unsigned int mask = (unsigned int)Slots.Size - 1;
+        unsigned int n = ImGuiFlatStorageHash(pair.key) & mask;
+        while (Slots.Data[n].Index != 0)
+            n = (n + 1) & mask;
+        Slots.Data[n].Key = pair.key;
+        Slots.Data[n].Index = Data.Size;
+    }
+    return &Data.back();
+}
+
+void ImGuiFlatStorage::Rehash(int slots_count)
+{
+    while (slots_count < Data.Size * 2)
+        slots_count = slots_count ? slots_count * 2 : 16;
+    IM_ASSERT(ImIsPowerOfTwo(slots_count) || slots_count == 0);
+    Slots.resize(slots_count);
+    if (slots_count == 0)
+        return;
+    memset(Slots.Data, 0, (size_t)Slots.Size * sizeof(Slot));
+    const unsigned int mask = (unsigned int)Slots.Size - 1;
+    for (int i = 0; i < Data.Size; i++)
+    {
+        unsigned int n = ImGuiFlatStorageHash(Data[i].key) & mask;
+        while (Slots.Data[n].Index != 0)
+            n = (n + 1) & mask;
+        Slots.Data[n].Key = Data[i].key;
+        Slots.Data[n].Index = i + 1;
+    }
+}
 IM_MSVC_RUNTIME_CHECKS_RESTORE
 
 //-----------------------------------------------------------------------------
@@ -5108,6 +5318,7 @@ static void SetupDrawListSharedData()
 
 void ImGui::NewFrame()
 {
+    IMGUI_PROFILE_ZONE("ImGui::NewFrame");
     IM_ASSERT(GImGui != NULL && "No current context. Did you call ImGui::CreateContext() and ImGui::SetCurrentContext() ?");
     ImGuiContext& g = *GImGui;
 
@@ -5567,6 +5778,7 @@ static void ImGui::RenderDimmedBackgrounds()
 // This is normally called by Render(). You may want to call it directly if you want to avoid calling Render() but the gain will be very minimal.
 void ImGui::EndFrame()
 {
+    IMGUI_PROFILE_ZONE("ImGui::EndFrame");
     ImGuiContext& g = *GImGui;
     IM_ASSERT(g.Initialized);
 
@@ -5662,6 +5874,7 @@ void ImGui::EndFrame()
 // it is the role of the ImGui_ImplXXXX_RenderDrawData() function provided by the renderer backend)
 void ImGui::Render()
 {
+    IMGUI_PROFILE_ZONE("ImGui::Render");
     ImGuiContext& g = *GImGui;
     IM_ASSERT(g.Initialized);
 
@@ -2417,6 +2417,8 @@ ImFontConfig::ImFontConfig()
 // - ImFontAtlasBuildRenderLinesTexData()
 // - ImFontAtlasBuildInit()
 // - ImFontAtlasBuildFinish()
+// - ImFontAtlasBuildSaveCache()
+// - ImFontAtlasBuildLoadCache()
 //-----------------------------------------------------------------------------
 
 // A work of art lies ahead! (. = white layer, X = black layer, others are blank)
@@ -3356,6 +3358,220 @@ void ImFontAtlasBuildFinish(ImFontAtlas* atlas)
     atlas->TexReady = true;
 }
 
+// Build cache file layout (native endianness, only ever read back by the same build of the application):
+// - ImFontAtlasBuildCacheHeader
+// - Alpha8 texture pixels (TexWidth * TexHeight)
+// - X, Y of each custom rectangle (2 x unsigned short)
+// - For each font: ImFontAtlasBuildCacheFont followed by its glyphs (ImFontGlyph[GlyphsCount])
+// Pixels written by the application into custom rectangles after Build() are not part of the cache.
+static const ImU32 FONT_ATLAS_BUILD_CACHE_VERSION = 1;
+
+struct ImFontAtlasBuildCacheHeader
+{
+    char        Magic[4];       // "IFAC"
+    ImU32       Version;        // FONT_ATLAS_BUILD_CACHE_VERSION
+    ImGuiID     Key;            // ImFontAtlasBuildCalcCacheKey()
+    ImGuiID     Checksum;       // Hash of everything following the header
+    int         TexWidth, TexHeight;
+    int         FontsCount, CustomRectsCount;
+    ImVec2      TexUvWhitePixel;
+    ImVec4      TexUvLines[IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1];
+};
+
+struct ImFontAtlasBuildCacheFont
+{
+    float       FontSize, Ascent, Descent;
+    int         MetricsTotalSurface;
+    int         GlyphsCount;
+};
+
+// Hash everything the output of Build() depends on: atlas settings, font data, font configurations and custom rectangles.
+// Call after ImFontAtlasBuildInit() so the default custom rectangles are registered.
+static ImGuiID ImFontAtlasBuildCalcCacheKey(ImFontAtlas* atlas)
+{
+#ifdef IMGUI_ENABLE_FREETYPE
+    const int builder = 2;
+#else
+    const int builder = 1;
+#endif
+    const int atlas_params[] = { IMGUI_VERSION_NUM, (int)sizeof(ImWchar), (int)sizeof(ImFontGlyph), builder, atlas->FontBuilderIO != NULL, atlas->Flags, atlas->TexDesiredWidth, atlas->TexGlyphPadding, (int)atlas->FontBuilderFlags, atlas->Fonts.Size, atlas->ConfigData.Size, atlas->CustomRects.Size };
+    ImGuiID key = ImHashData(atlas_params, sizeof(atlas_params), 0);
+    for (const ImFontConfig& cfg : atlas->ConfigData)
+    {
+        const float cfg_fparams[] = { cfg.SizePixels, cfg.GlyphExtraSpacing.x, cfg.GlyphExtraSpacing.y, cfg.GlyphOffset.x, cfg.GlyphOffset.y, cfg.GlyphMinAdvanceX, cfg.GlyphMaxAdvanceX, cfg.RasterizerMultiply, cfg.RasterizerDensity };
+        const int cfg_iparams[] = { cfg.FontDataSize, cfg.FontNo, cfg.OversampleH, cfg.OversampleV, cfg.PixelSnapH, cfg.MergeMode, (int)cfg.FontBuilderFlags, (int)cfg.EllipsisChar, atlas->Fonts.find_index(cfg.DstFont) };
+        key = ImHashData(cfg_fparams, sizeof(cfg_fparams), key);
+        key = ImHashData(cfg_iparams, sizeof(cfg_iparams), key);
+        key = ImHashData(cfg.FontData, (size_t)cfg.FontDataSize, key);
+        const ImWchar* ranges = cfg.GlyphRanges ? cfg.GlyphRanges : atlas->GetGlyphRangesDefault();
+        int ranges_len = 0;
+        while (ranges[ranges_len] && ranges[ranges_len + 1])
+            ranges_len += 2;
+        key = ImHashData(ranges, sizeof(ImWchar) * ranges_len, key);
+    }
+    for (const ImFontAtlasCustomRect& r : atlas->CustomRects)
+    {
+        const float rect_fparams[] = { r.GlyphAdvanceX, r.GlyphOffset.x, r.GlyphOffset.y };
+        const int rect_iparams[] = { r.Width, r.Height, (int)r.GlyphID, (int)r.GlyphColored, r.Font ? atlas->Fonts.find_index(r.Font) : -1 };
+        key = ImHashData(rect_fparams, sizeof(rect_fparams), key);
+        key = ImHashData(rect_iparams, sizeof(rect_iparams), key);
+    }
+    return key;
+}
+
+// Write the output of Build() to a file. Return false if the atlas is not built as Alpha8 or the file can't be written.
+bool ImFontAtlasBuildSaveCache(ImFontAtlas* atlas, const char* filename)
+{
+    if (!atlas->IsBuilt() || atlas->TexPixelsAlpha8 == NULL)
+        return false;
+
+    const size_t pixels_size = (size_t)atlas->TexWidth * (size_t)atlas->TexHeight;
+    size_t data_size = sizeof(ImFontAtlasBuildCacheHeader) + pixels_size + sizeof(unsigned short) * 2 * atlas->CustomRects.Size;
+    for (ImFont* font : atlas->Fonts)
+        data_size += sizeof(ImFontAtlasBuildCacheFont) + sizeof(ImFontGlyph) * font->Glyphs.Size;
+    unsigned char* data = (unsigned char*)IM_ALLOC(data_size);
+    unsigned char* p = data + sizeof(ImFontAtlasBuildCacheHeader);
+
+    memcpy(p, atlas->TexPixelsAlpha8, pixels_size);
+    p += pixels_size;
+    for (const ImFontAtlasCustomRect& r : atlas->CustomRects)
+    {
+        const unsigned short pos[2] = { r.X, r.Y };
+        memcpy(p, pos, sizeof(pos));
+        p += sizeof(pos);
+    }
+    for (ImFont* font : atlas->Fonts)
+    {
+        ImFontAtlasBuildCacheFont font_data;
+        font_data.FontSize = font->FontSize;
+        font_data.Ascent = font->Ascent;
+        font_data.Descent = font->Descent;
+        font_data.MetricsTotalSurface = font->MetricsTotalSurface;
+        font_data.GlyphsCount = font->Glyphs.Size;
+        memcpy(p, &font_data, sizeof(font_data));
+        p += sizeof(font_data);
+        memcpy(p, font->Glyphs.Data, sizeof(ImFontGlyph) * font->Glyphs.Size);
+        p += sizeof(ImFontGlyph) * font->Glyphs.Size;
+    }
+    IM_ASSERT(p == data + data_size);
+
+    ImFontAtlasBuildCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.Magic, "IFAC", 4);
+    header.Version = FONT_ATLAS_BUILD_CACHE_VERSION;
+    header.Key = ImFontAtlasBuildCalcCacheKey(atlas);
+    header.Checksum = ImHashData(data + sizeof(header), data_size - sizeof(header), 0);
+    header.TexWidth = atlas->TexWidth;
+    header.TexHeight = atlas->TexHeight;
+    header.FontsCount = atlas->Fonts.Size;
+    header.CustomRectsCount = atlas->CustomRects.Size;
+    header.TexUvWhitePixel = atlas->TexUvWhitePixel;
+    memcpy(header.TexUvLines, atlas->TexUvLines, sizeof(header.TexUvLines));
+    memcpy(data, &header, sizeof(header));
+
+    bool ret = false;
+    if (ImFileHandle f = ImFileOpen(filename, "wb"))
+    {
+        ret = ImFileWrite(data, 1, data_size, f) == data_size;
+        ImFileClose(f);
+    }
+    IM_FREE(data);
+    return ret;
+}
+
+static bool ImFontAtlasBuildLoadCacheFromMemory(ImFontAtlas* atlas, const unsigned char* data, size_t data_size)
+{
+    // Validate everything before touching the atlas
+    ImFontAtlasBuildCacheHeader header;
+    if (data_size < sizeof(header))
+        return false;
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.Magic, "IFAC", 4) != 0 || header.Version != FONT_ATLAS_BUILD_CACHE_VERSION)
+        return false;
+    if (header.FontsCount != atlas->Fonts.Size || header.CustomRectsCount != atlas->CustomRects.Size || header.TexWidth <= 0 || header.TexHeight <= 0)
+        return false;
+    if (header.Key != ImFontAtlasBuildCalcCacheKey(atlas))
+        return false;
+    const unsigned char* p = data + sizeof(header);
+    const unsigned char* data_end = data + data_size;
+    if (header.Checksum != ImHashData(p, (size_t)(data_end - p), 0))
+        return false;
+
+    const size_t pixels_size = (size_t)header.TexWidth * (size_t)header.TexHeight;
+    const size_t rects_size = sizeof(unsigned short) * 2 * header.CustomRectsCount;
+    if ((size_t)(data_end - p) < pixels_size + rects_size)
+        return false;
+    const unsigned char* pixels = p;
+    const unsigned char* rects = p + pixels_size;
+    const unsigned char* fonts = rects + rects_size;
+    for (p = fonts; p != data_end; )
+    {
+        ImFontAtlasBuildCacheFont font_data;
+        if ((size_t)(data_end - p) < sizeof(font_data))
+            return false;
+        memcpy(&font_data, p, sizeof(font_data));
+        p += sizeof(font_data);
+        if (font_data.GlyphsCount <= 0 || (size_t)(data_end - p) / sizeof(ImFontGlyph) < (size_t)font_data.GlyphsCount)
+            return false;
+        p += sizeof(ImFontGlyph) * font_data.GlyphsCount;
+    }
+
+    // Restore what Build() would have produced
+    atlas->ClearTexData();
+    atlas->TexWidth = header.TexWidth;
+    atlas->TexHeight = header.TexHeight;
+    atlas->TexUvScale = ImVec2(1.0f / atlas->TexWidth, 1.0f / atlas->TexHeight);
+    atlas->TexUvWhitePixel = header.TexUvWhitePixel;
+    memcpy(atlas->TexUvLines, header.TexUvLines, sizeof(atlas->TexUvLines));
+    atlas->TexPixelsAlpha8 = (unsigned char*)IM_ALLOC(pixels_size);
+    memcpy(atlas->TexPixelsAlpha8, pixels, pixels_size);
+    for (ImFontAtlasCustomRect& r : atlas->CustomRects)
+    {
+        unsigned short pos[2];
+        memcpy(pos, rects, sizeof(pos));
+        rects += sizeof(pos);
+        r.X = pos[0];
+        r.Y = pos[1];
+    }
+    p = fonts;
+    for (ImFont* font : atlas->Fonts)
+    {
+        ImFontAtlasBuildCacheFont font_data;
+        memcpy(&font_data, p, sizeof(font_data));
+        p += sizeof(font_data);
+        font->ClearOutputData();
+        font->ContainerAtlas = atlas;
+        font->FontSize = font_data.FontSize;
+        font->Ascent = font_data.Ascent;
+        font->Descent = font_data.Descent;
+        font->Glyphs.resize(font_data.GlyphsCount);
+        memcpy(font->Glyphs.Data, p, sizeof(ImFontGlyph) * font_data.GlyphsCount);
+        p += sizeof(ImFontGlyph) * font_data.GlyphsCount;
+        font->BuildLookupTable();
+        font->MetricsTotalSurface = font_data.MetricsTotalSurface;
+    }
+    atlas->TexReady = true;
+    return true;
+}
+
+// Replace Build() with the output saved by ImFontAtlasBuildSaveCache() if it was built from the same inputs.
+// Add fonts and custom rectangles first. Return false (atlas left unbuilt) if the file is missing, stale or damaged.
+bool ImFontAtlasBuildLoadCache(ImFontAtlas* atlas, const char* filename)
+{
+    IM_ASSERT(!atlas->Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    if (atlas->ConfigData.Size == 0)
+        atlas->AddFontDefault();
+    ImFontAtlasBuildInit(atlas);
+
+    size_t data_size = 0;
+    unsigned char* data = (unsigned char*)ImFileLoadToMemory(filename, "rb", &data_size);
+    if (data == NULL)
+        return false;
+    const bool ret = ImFontAtlasBuildLoadCacheFromMemory(atlas, data, data_size);
+    IM_FREE(data);
+    return ret;
+}
+
 //-------------------------------------------------------------------------
 // [SECTION] ImFontAtlas: glyph ranges helpers
 //-------------------------------------------------------------------------
@@ -3690,11 +3906,14 @@ ImFont::ImFont()
     Ascent = Descent = 0.0f;
     MetricsTotalSurface = 0;
     memset(Used4kPagesMap, 0, sizeof(Used4kPagesMap));
+    TextRunCache = NULL;
 }
 
 ImFont::~ImFont()
 {
     ClearOutputData();
+    if (TextRunCache)
+        IM_DELETE(TextRunCache);
 }
 
 void    ImFont::ClearOutputData()
@@ -3710,6 +3929,63 @@ void    ImFont::ClearOutputData()
     Ascent = Descent = 0.0f;
     MetricsTotalSurface = 0;
     memset(Used4kPagesMap, 0, sizeof(Used4kPagesMap));
+    ClearTextRunCache();
+}
+
+// Cached sizes depend on glyph advances: call whenever glyphs or the lookup tables change.
+void ImFont::ClearTextRunCache()
+{
+    if (TextRunCache)
+        TextRunCache->Clear();
+}
+
+static ImGuiID ImFontTextRunHash(float size, const char* text, const char* text_end)
+{
+    ImU32 seed;
+    memcpy(&seed, &size, sizeof(seed));
+    return ImHashData(text, (size_t)(text_end - text), seed);
+}
+
+static inline ImU32 ImFontTextRunCacheNextUse(ImFontTextRunCache* cache)
+{
+    if (++cache->UseCounter == 0) // Wrapped around: 0 marks unused entries, start over
+    {
+        cache->Clear();
+        cache->UseCounter = 1;
+    }
+    return cache->UseCounter;
+}
+
+ImFontTextRun* ImFontTextRunCache::Find(ImGuiID hash, float size, const char* text, const char* text_end)
+{
+    const int text_len = (int)(text_end - text);
+    ImFontTextRun* set = &Runs[(hash & (Sets - 1)) * Ways];
+    for (int n = 0; n < Ways; n++)
+    {
+        ImFontTextRun* run = &set[n];
+        if (run->LastUse != 0 && run->Hash == hash && run->Size == size && run->Text.Size == text_len && memcmp(run->Text.Data, text, (size_t)text_len) == 0)
+        {
+            run->LastUse = ImFontTextRunCacheNextUse(this);
+            return run;
+        }
+    }
+    return NULL;
+}
+
+ImFontTextRun* ImFontTextRunCache::Add(ImGuiID hash, float size, const char* text, const char* text_end)
+{
+    ImFontTextRun* set = &Runs[(hash & (Sets - 1)) * Ways];
+    ImFontTextRun* run = &set[0];
+    for (int n = 1; n < Ways; n++)
+        if (set[n].LastUse < run->LastUse)
+            run = &set[n];
+    run->Hash = hash;
+    run->Size = size;
+    run->LastUse = ImFontTextRunCacheNextUse(this);
+    run->TextSize = ImVec2(0.0f, 0.0f);
+    run->Text.resize((int)(text_end - text));
+    memcpy(run->Text.Data, text, (size_t)(text_end - text));
+    return run;
 }
 
 static ImWchar FindFirstExistingGlyph(ImFont* font, const ImWchar* candidate_chars, int candidate_chars_count)
@@ -3733,6 +4009,7 @@ void ImFont::BuildLookupTable()
     IndexLookup.clear();
     DirtyLookupTables = false;
     memset(Used4kPagesMap, 0, sizeof(Used4kPagesMap));
+    ClearTextRunCache();
     GrowIndex(max_codepoint + 1);
     for (int i = 0; i < Glyphs.Size; i++)
     {
@@ -3821,6 +4098,7 @@ void ImFont::SetGlyphVisible(ImWchar c, bool visible)
 {
     if (ImFontGlyph* glyph = (ImFontGlyph*)(void*)FindGlyph((ImWchar)c))
         glyph->Visible = visible ? 1 : 0;
+    ClearTextRunCache();
 }
 
 void ImFont::GrowIndex(int new_size)
@@ -3893,6 +4171,7 @@ void ImFont::AddRemapChar(ImWchar dst, ImWchar src, bool overwrite_dst)
     GrowIndex(dst + 1);
     IndexLookup[dst] = (src < index_size) ? IndexLookup.Data[src] : (ImWchar)-1;
     IndexAdvanceX[dst] = (src < index_size) ? IndexAdvanceX.Data[src] : 1.0f;
+    ClearTextRunCache();
 }
 
 // Find glyph, return fallback if missing
@@ -4034,6 +4313,19 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
     if (!text_end)
         text_end = text_begin + strlen(text_begin); // FIXME-OPT: Need to avoid this.
 
+#ifndef IMGUI_DISABLE_FONT_TEXT_RUN_CACHE
+    // Unwrapped labels are typically measured again every frame
+    const bool use_run_cache = max_width >= FLT_MAX && wrap_width <= 0.0f && text_end - text_begin >= IMGUI_FONT_TEXT_RUN_CACHE_MIN_LEN && text_end - text_begin <= IMGUI_FONT_TEXT_RUN_CACHE_MAX_LEN;
+    const ImGuiID run_hash = use_run_cache ? ImFontTextRunHash(size, text_begin, text_end) : 0;
+    if (use_run_cache && TextRunCache)
+        if (ImFontTextRun* run = TextRunCache->Find(run_hash, size, text_begin, text_end))
+        {
+            if (remaining)
+                *remaining = text_end;
+            return run->TextSize;
+        }
+#endif
+
     const float line_height = size;
     const float scale = size / FontSize;
 
@@ -4104,6 +4396,15 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
     if (remaining)
         *remaining = s;
 
+#ifndef IMGUI_DISABLE_FONT_TEXT_RUN_CACHE
+    if (use_run_cache)
+    {
+        if (TextRunCache == NULL)
+            TextRunCache = IM_NEW(ImFontTextRunCache)();
+        TextRunCache->Add(run_hash, size, text_begin, text_end)->TextSize = text_size;
+    }
+#endif
+
     return text_size;
 }
 
@@ -441,6 +441,10 @@ void DestroyContext(ImPlotContext* ctx) {
         ctx = GImPlot;
     if (GImPlot == ctx)
         SetCurrentContext(nullptr);
+    for (int i = 0; i < ctx->ParallelJobs.Size; ++i)
+        IM_DELETE(ctx->ParallelJobs[i]);
+    for (int i = 0; i < ctx->ParallelDrawLists.Size; ++i)
+        IM_DELETE(ctx->ParallelDrawLists[i]);
     IM_DELETE(ctx);
 }
 
@@ -456,6 +460,8 @@ void SetCurrentContext(ImPlotContext* ctx) {
 #define IM_RGB(r,g,b) IM_COL32(r,g,b,255)
 
 void Initialize(ImPlotContext* ctx) {
+    ctx->ParallelFor         = nullptr;
+    ctx->ParallelForUserData = nullptr;
     ResetCtxForNextPlot(ctx);
     ResetCtxForNextAlignedPlots(ctx);
     ResetCtxForNextSubplot(ctx);
@@ -511,6 +517,10 @@ void ResetCtxForNextPlot(ImPlotContext* ctx) {
     ctx->CurrentPlot  = nullptr;
     ctx->CurrentItem  = nullptr;
     ctx->PreviousItem = nullptr;
+    // stop any retained item capture
+    ctx->RetainedKey  = 0;
+    // close any parallel items scope
+    ctx->ParallelItems = ctx->ParallelNextItem = ctx->ParallelCurrentItem = false;
 }
 
 void ResetCtxForNextAlignedPlots(ImPlotContext* ctx) {
@@ -1214,6 +1224,15 @@ inline ImPlotDateTimeSpec GetDateTimeFmt(const ImPlotDateTimeSpec* ctx, ImPlotTi
     return fmt;
 }
 
+// Combines a tick label cache seed with a date/time spec, or returns 0 if caching is disabled
+inline ImGuiID HashDateTimeSpec(const ImPlotDateTimeSpec& fmt, ImGuiID seed) {
+    if (seed == 0)
+        return 0;
+    // FormatDateTime also depends on the time zone through GetTime
+    const int fields[5] = { fmt.Date, fmt.Time, fmt.UseISO8601, fmt.Use24HourClock, GImPlot->Style.UseLocalTime };
+    return ImHashData(fields, sizeof(fields), seed);
+}
+
 void Locator_Time(ImPlotTicker& ticker, const ImPlotRange& range, float pixels, bool vertical, ImPlotFormatter formatter, void* formatter_data) {
     IM_ASSERT_USER_ERROR(vertical == false, "Cannot locate Time ticks on vertical axis!");
     (void)vertical;
@@ -1224,6 +1243,10 @@ void Locator_Time(ImPlotTicker& ticker, const ImPlotRange& range, float pixels,
     const ImPlotDateTimeSpec fmt0 = GetDateTimeFmt(TimeFormatLevel0, unit0);
     const ImPlotDateTimeSpec fmt1 = GetDateTimeFmt(TimeFormatLevel1, unit1);
     const ImPlotDateTimeSpec fmtf = GetDateTimeFmt(TimeFormatLevel1First, unit1);
+    // label cache seeds
+    const ImGuiID seed0 = HashDateTimeSpec(fmt0, ticker.LabelSeed);
+    const ImGuiID seed1 = HashDateTimeSpec(fmt1, ticker.LabelSeed);
+    const ImGuiID seedf = HashDateTimeSpec(fmtf, ticker.LabelSeed);
     // min max times
     const ImPlotTime t_min = ImPlotTime::FromDouble(range.Min);
     const ImPlotTime t_max = ImPlotTime::FromDouble(range.Max);
@@ -1255,10 +1278,10 @@ void Locator_Time(ImPlotTicker& ticker, const ImPlotRange& range, float pixels,
             if (t1 >= t_min && t1 <= t_max) {
                 // minor level 0 tick
                 ftd.Time = t1; ftd.Spec = fmt0;
-                ticker.AddTick(t1.ToDouble(), true, 0, true, Formatter_Time, &ftd);
+                ticker.AddTick(t1.ToDouble(), true, 0, true, Formatter_Time, &ftd, seed0);
                 // major level 1 tick
                 ftd.Time = t1; ftd.Spec = last_major_offset < 0 ? fmtf : fmt1;
-                ImPlotTick& tick_maj = ticker.AddTick(t1.ToDouble(), true, 1, true, Formatter_Time, &ftd);
+                ImPlotTick& tick_maj = ticker.AddTick(t1.ToDouble(), true, 1, true, Formatter_Time, &ftd, last_major_offset < 0 ? seedf : seed1);
                 const char* this_major = ticker.GetText(tick_maj);
                 if (last_major_offset >= 0 && TimeLabelSame(ticker.TextBuffer.Buf.Data + last_major_offset, this_major))
                     tick_maj.ShowLabel = false;
@@ -1271,10 +1294,10 @@ void Locator_Time(ImPlotTicker& ticker, const ImPlotRange& range, float pixels,
                     float px_to_t2 = (float)((t2 - t12).ToDouble()/range.Size()) * pixels;
                     if (t12 >= t_min && t12 <= t_max) {
                         ftd.Time = t12; ftd.Spec = fmt0;
-                        ticker.AddTick(t12.ToDouble(), false, 0, px_to_t2 >= fmt0_width, Formatter_Time, &ftd);
+                        ticker.AddTick(t12.ToDouble(), false, 0, px_to_t2 >= fmt0_width, Formatter_Time, &ftd, seed0);
                         if (last_major_offset < 0 && px_to_t2 >= fmt0_width && px_to_t2 >= (fmt1_width + fmtf_width) / 2) {
                             ftd.Time = t12; ftd.Spec = fmtf;
-                            ImPlotTick& tick_maj = ticker.AddTick(t12.ToDouble(), true, 1, true, Formatter_Time, &ftd);
+                            ImPlotTick& tick_maj = ticker.AddTick(t12.ToDouble(), true, 1, true, Formatter_Time, &ftd, seedf);
                             last_major_offset = tick_maj.TextOffset;
                         }
                     }
@@ -1286,6 +1309,7 @@ void Locator_Time(ImPlotTicker& ticker, const ImPlotRange& range, float pixels,
     }
     else {
         const ImPlotDateTimeSpec fmty = GetDateTimeFmt(TimeFormatLevel0, ImPlotTimeUnit_Yr);
+        const ImGuiID seedy = HashDateTimeSpec(fmty, ticker.LabelSeed);
         const float label_width = GetDateTimeWidth(fmty);
         const int   max_labels  = (int)(max_density * pixels / label_width);
         const int year_min      = GetYear(t_min);
@@ -1300,7 +1324,7 @@ void Locator_Time(ImPlotTicker& ticker, const ImPlotRange& range, float pixels,
             ImPlotTime t = MakeTime(y);
             if (t >= t_min && t <= t_max) {
                 ftd.Time = t; ftd.Spec = fmty;
-                ticker.AddTick(t.ToDouble(), true, 0, true, Formatter_Time, &ftd);
+                ticker.AddTick(t.ToDouble(), true, 0, true, Formatter_Time, &ftd, seedy);
             }
         }
     }
@@ -2365,6 +2389,7 @@ void SetNextAxesToFit() {
 //-----------------------------------------------------------------------------
 
 bool BeginPlot(const char* title_id, const ImVec2& size, ImPlotFlags flags) {
+    IMGUI_PROFILE_ZONE("ImPlot::BeginPlot");
     IM_ASSERT_USER_ERROR(GImPlot != nullptr, "No current context. Did you call ImPlot::CreateContext() or ImPlot::SetCurrentContext()?");
     ImPlotContext& gp = *GImPlot;
     IM_ASSERT_USER_ERROR(gp.CurrentPlot == nullptr, "Mismatched BeginPlot()/EndPlot()!");
@@ -2458,7 +2483,46 @@ bool BeginPlot(const char* title_id, const ImVec2& size, ImPlotFlags flags) {
 // SetupFinish
 //-----------------------------------------------------------------------------
 
+// Returns the label cache seed for an axis' ticker, or 0 if its labels can't be reused across frames. Only the
+// built-in formatters are known to depend on nothing but the tick value and their format spec.
+// IMPLOT_DISABLE_TICK_CACHE always returns 0: every frame runs the locator and formats every label (bench/tick_bench).
+static ImGuiID GetTickLabelSeed(const ImPlotAxis& axis) {
+#ifdef IMPLOT_DISABLE_TICK_CACHE
+    IM_UNUSED(axis);
+    return 0;
+#else
+    const ImFont* font      = ImGui::GetFont();
+    const float   font_size = ImGui::GetFontSize();
+    const ImGuiID seed      = ImHashData(&font, sizeof(font), ImHashData(&font_size, sizeof(font_size)));
+    if (axis.Locator == Locator_Time) // ignores the axis formatter
+        return seed;
+    if (axis.Formatter == Formatter_Default)
+        return ImHashStr((const char*)axis.FormatterData, 0, seed);
+    return 0;
+#endif
+}
+
+// Runs the axis Locator, or reuses the previous frame's ticks if range, pixel size and formatter are unchanged
+static void LocateTicks(ImPlotAxis& axis, float pixels, bool vertical) {
+    IMGUI_PROFILE_ZONE("ImPlot::LocateTicks");
+    ImPlotTicker& ticker = axis.Ticker;
+    const bool builtin = axis.Locator == Locator_Default || axis.Locator == Locator_Time || axis.Locator == Locator_Log10 || axis.Locator == Locator_SymLog;
+    ticker.LabelSeed = GetTickLabelSeed(axis);
+    ImGuiID key = 0;
+    if (builtin && ticker.LabelSeed != 0) {
+        const int style_bits = (GImPlot->Style.UseISO8601 ? 1 : 0) | (GImPlot->Style.Use24HourClock ? 2 : 0) | (GImPlot->Style.UseLocalTime ? 4 : 0);
+        key = ImHashData(&axis.Range, sizeof(ImPlotRange), ticker.LabelSeed);
+        key = ImHashData(&pixels, sizeof(pixels), key);
+        key = ImHashData(&vertical, sizeof(vertical), key);
+        key = ImHashData(&axis.Locator, sizeof(axis.Locator), key);
+        key = ImHashData(&style_bits, sizeof(style_bits), key);
+    }
+    if (!ticker.RestoreLocated(key))
+        axis.Locator(ticker, axis.Range, pixels, vertical, axis.Formatter, axis.FormatterData);
+}
+
 void SetupFinish() {
+    IMGUI_PROFILE_ZONE("ImPlot::SetupFinish");
     IM_ASSERT_USER_ERROR(GImPlot != nullptr, "No current context. Did you call ImPlot::CreateContext() or ImPlot::SetCurrentContext()?");
     ImPlotContext& gp = *GImPlot;
     IM_ASSERT_USER_ERROR(gp.CurrentPlot != nullptr, "SetupFinish needs to be called after BeginPlot!");
@@ -2566,7 +2630,7 @@ void SetupFinish() {
     for (int i = 0; i < IMPLOT_NUM_Y_AXES; i++) {
         ImPlotAxis& axis = plot.YAxis(i);
         if (axis.WillRender() && axis.ShowDefaultTicks && plot_height > 0) {
-            axis.Locator(axis.Ticker, axis.Range, plot_height, true, axis.Formatter, axis.FormatterData);
+            LocateTicks(axis, plot_height, true);
         }
     }
 
@@ -2579,7 +2643,7 @@ void SetupFinish() {
     for (int i = 0; i < IMPLOT_NUM_X_AXES; i++) {
         ImPlotAxis& axis = plot.XAxis(i);
         if (axis.WillRender() && axis.ShowDefaultTicks && plot_width > 0) {
-            axis.Locator(axis.Ticker, axis.Range, plot_width, false, axis.Formatter, axis.FormatterData);
+            LocateTicks(axis, plot_width, false);
         }
     }
 
@@ -2759,11 +2823,15 @@ void SetupFinish() {
 //-----------------------------------------------------------------------------
 
 void EndPlot() {
+    IMGUI_PROFILE_ZONE("ImPlot::EndPlot");
     IM_ASSERT_USER_ERROR(GImPlot != nullptr, "No current context. Did you call ImPlot::CreateContext() or ImPlot::SetCurrentContext()?");
     ImPlotContext& gp = *GImPlot;
     IM_ASSERT_USER_ERROR(gp.CurrentPlot != nullptr, "Mismatched BeginPlot()/EndPlot()!");
+    IM_ASSERT_USER_ERROR(!gp.ParallelItems, "Mismatched BeginParallelItems()/EndParallelItems()!");
 
     SetupLock();
+    if (gp.ParallelItems)
+        EndParallelItems();
 
     ImGuiContext &G       = *GImGui;
     ImPlotPlot &plot      = *gp.CurrentPlot;
@@ -3787,6 +3855,12 @@ void HideNextItem(bool hidden, ImPlotCond cond) {
     gp.NextItemData.HiddenCond = cond;
 }
 
+void SetNextItemRetained(ImU64 data_version) {
+    ImPlotContext& gp = *GImPlot;
+    gp.NextItemData.HasRetained     = true;
+    gp.NextItemData.RetainedVersion = data_version;
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] Plot Tools
 //-----------------------------------------------------------------------------
@@ -4840,6 +4914,9 @@ void ColormapIcon(ImPlotColormap cmap) {
 }
 
 ImDrawList* GetPlotDrawList() {
+    // whatever is drawn next must come after the deferred primitives of earlier items
+    if (GImPlot->ParallelJobs.Size > 0)
+        FlushParallelItems();
     return ImGui::GetWindowDrawList();
 }
 
@@ -399,6 +399,9 @@ bool BeginItem(const char* label_id, ImPlotItemFlags flags, ImPlotCol recolor_fr
     ImPlotContext& gp = *GImPlot;
     IM_ASSERT_USER_ERROR(gp.CurrentPlot != nullptr, "PlotX() needs to be called between BeginPlot() and EndPlot()!");
     SetupLock();
+    // defer primitives if allowed, anything else flushes pending jobs through GetPlotDrawList
+    gp.ParallelCurrentItem = gp.ParallelItems && gp.ParallelNextItem && gp.ParallelFor != nullptr && !gp.NextItemData.HasRetained;
+    gp.ParallelNextItem    = false;
     bool just_created;
     ImPlotItem* item = RegisterOrGetItem(label_id, flags, &just_created);
     // set current item
@@ -424,6 +427,7 @@ bool BeginItem(const char* label_id, ImPlotItemFlags flags, ImPlotCol recolor_fr
     if (!item->Show) {
         // reset next item data
         gp.NextItemData.Reset();
+        gp.ParallelCurrentItem = false;
         gp.PreviousItem = item;
         gp.CurrentItem  = nullptr;
         return false;
@@ -475,18 +479,147 @@ bool BeginItem(const char* label_id, ImPlotItemFlags flags, ImPlotCol recolor_fr
     }
 }
 
+// Copies the geometry generated since BeginRetainedItem into the current item's cache
+static void EndRetainedItem() {
+    ImPlotContext& gp = *GImPlot;
+    ImDrawList& draw_list = *GetPlotDrawList();
+    ImPlotRetainedGeometry& geom = gp.CurrentItem->Retained;
+    geom.Clear();
+    // only geometry that stayed in a single draw command can be spliced back
+    if (draw_list.CmdBuffer.Size == gp.RetainedCmdCount && draw_list._CmdHeader.VtxOffset == gp.RetainedVtxOffset) {
+        const int vtx_count = draw_list.VtxBuffer.Size - gp.RetainedVtxStart;
+        const int idx_count = draw_list.IdxBuffer.Size - gp.RetainedIdxStart;
+        geom.VtxBuffer.resize(vtx_count);
+        geom.IdxBuffer.resize(idx_count);
+        if (vtx_count > 0)
+            memcpy(geom.VtxBuffer.Data, draw_list.VtxBuffer.Data + gp.RetainedVtxStart, vtx_count * sizeof(ImDrawVert));
+        for (int i = 0; i < idx_count; ++i)
+            geom.IdxBuffer[i] = (ImDrawIdx)(draw_list.IdxBuffer[gp.RetainedIdxStart + i] - gp.RetainedBaseIdx);
+        geom.Key      = gp.RetainedKey;
+        // points the getter left out are missing just like culled ones once the view moves
+        geom.Complete = gp.RetainedPrimsCulled == 0 && gp.RetainedVtxRendered == vtx_count && !gp.NextItemData.InputClipped;
+    }
+    gp.RetainedKey = 0;
+}
+
 // Ends an item (call only if BeginItem returns true)
 void EndItem() {
     ImPlotContext& gp = *GImPlot;
+    // store retained geometry
+    if (gp.RetainedKey != 0)
+        EndRetainedItem();
     // pop rendering clip rect
     PopPlotClipRect();
     // reset next item data
     gp.NextItemData.Reset();
+    gp.ParallelCurrentItem = false;
     // set current item
     gp.PreviousItem = gp.CurrentItem;
     gp.CurrentItem  = nullptr;
 }
 
+template <typename T>
+static inline ImGuiID HashRetained(const T& data, ImGuiID seed) {
+    return ImHashData(&data, sizeof(T), seed);
+}
+
+bool BeginRetainedItem(ImPlotItemFlags flags) {
+    ImPlotContext& gp = *GImPlot;
+    ImPlotPlot& plot = *gp.CurrentPlot;
+    ImPlotItem& item = *gp.CurrentItem;
+    const ImPlotAxis& x_axis = plot.Axes[plot.CurrentX];
+    const ImPlotAxis& y_axis = plot.Axes[plot.CurrentY];
+    const ImPlotNextItemData& s = gp.NextItemData;
+    ImDrawList& draw_list = *GetPlotDrawList();
+    // hash everything that changes the generated geometry other than a linear axis pan
+    ImGuiID key = HashRetained(s.RetainedVersion, item.ID);
+    key = HashRetained(s.Colors, key);
+    key = HashRetained(s.LineWeight, key);
+    key = HashRetained(s.Marker, key);
+    key = HashRetained(s.MarkerSize, key);
+    key = HashRetained(s.MarkerWeight, key);
+    key = HashRetained(s.ErrorBarSize, key);
+    key = HashRetained(s.ErrorBarWeight, key);
+    key = HashRetained(s.DigitalBitHeight, key);
+    key = HashRetained(s.DigitalBitGap, key);
+    key = HashRetained(flags, key);
+    key = HashRetained(ImGui::GetStyle().Alpha, key);
+    key = HashRetained(draw_list.Flags, key);
+    key = HashRetained(draw_list._Data->TexUvWhitePixel, key);
+    const ImPlotAxis* axes[2] = { &x_axis, &y_axis };
+    for (int i = 0; i < 2; ++i) {
+        const ImPlotAxis& axis = *axes[i];
+        key = HashRetained(axis.TransformForward, key);
+        if (axis.TransformForward != nullptr) {
+            key = HashRetained(axis.TransformData, key);
+            key = HashRetained(axis.Range, key);
+            key = HashRetained(axis.PixelMin, key);
+            key = HashRetained(axis.ScaleToPixel, key);
+        }
+    }
+    if (key == 0)
+        key = 1;
+    ImPlotRetainedGeometry& geom = item.Retained;
+    if (geom.Key == key) {
+        const ImPlotPoint scale(x_axis.ScaleToPixel, y_axis.ScaleToPixel);
+        const ImPlotPoint pix_min(x_axis.PixelMin, y_axis.PixelMin);
+        const ImPlotPoint plt_min(x_axis.Range.Min, y_axis.Range.Min);
+        const bool same_scale = ImAbs(scale.x - geom.Scale.x) <= ImAbs(geom.Scale.x) * 1e-9 &&
+                                ImAbs(scale.y - geom.Scale.y) <= ImAbs(geom.Scale.y) * 1e-9;
+        const bool same_view  = pix_min.x == geom.PixelMin.x && pix_min.y == geom.PixelMin.y &&
+                                plt_min.x == geom.PlotMin.x  && plt_min.y == geom.PlotMin.y  &&
+                                plot.PlotRect.Min == geom.CullRect.Min && plot.PlotRect.Max == geom.CullRect.Max;
+        if (same_scale && (same_view || geom.Complete)) {
+            // pixel offset of the cached geometry, computed relative to the cached view to stay precise for large coordinates
+            const ImVec2 offset((float)((pix_min.x - geom.PixelMin.x) + scale.x * (geom.PlotMin.x - plt_min.x)),
+                                (float)((pix_min.y - geom.PixelMin.y) + scale.y * (geom.PlotMin.y - plt_min.y)));
+            const int vtx_count = geom.VtxBuffer.Size;
+            const int idx_count = geom.IdxBuffer.Size;
+            draw_list.PrimReserve(idx_count, vtx_count);
+            const unsigned int base_idx = draw_list._VtxCurrentIdx;
+            if (offset.x == 0 && offset.y == 0) {
+                if (vtx_count > 0)
+                    memcpy(draw_list._VtxWritePtr, geom.VtxBuffer.Data, vtx_count * sizeof(ImDrawVert));
+            }
+            else {
+                for (int i = 0; i < vtx_count; ++i) {
+                    draw_list._VtxWritePtr[i]      = geom.VtxBuffer[i];
+                    draw_list._VtxWritePtr[i].pos += offset;
+                }
+            }
+            for (int i = 0; i < idx_count; ++i)
+                draw_list._IdxWritePtr[i] = (ImDrawIdx)(geom.IdxBuffer[i] + base_idx);
+            draw_list._VtxWritePtr   += vtx_count;
+            draw_list._IdxWritePtr   += idx_count;
+            draw_list._VtxCurrentIdx += vtx_count;
+            return true;
+        }
+    }
+    // cache miss. Data that changes every frame (a live plot) would be copied into the cache every
+    // frame and never drawn from it: capture only once the version stayed the same for a frame.
+    const bool changed = s.RetainedVersion != geom.Version;
+    const bool changing = changed && geom.Changing;
+    geom.Version  = s.RetainedVersion;
+    geom.Changing = changed;
+    if (changing) {
+        geom.Key = 0;
+        return false;
+    }
+    geom.Scale    = ImPlotPoint(x_axis.ScaleToPixel, y_axis.ScaleToPixel);
+    geom.PixelMin = ImPlotPoint(x_axis.PixelMin, y_axis.PixelMin);
+    geom.PlotMin  = ImPlotPoint(x_axis.Range.Min, y_axis.Range.Min);
+    geom.CullRect = plot.PlotRect;
+    gp.RetainedKey         = key;
+    gp.RetainedVtxStart    = draw_list.VtxBuffer.Size;
+    gp.RetainedIdxStart    = draw_list.IdxBuffer.Size;
+    gp.RetainedCmdCount    = draw_list.CmdBuffer.Size;
+    gp.RetainedVtxOffset   = draw_list._CmdHeader.VtxOffset;
+    gp.RetainedBaseIdx     = draw_list._VtxCurrentIdx;
+    gp.RetainedVtxRendered = 0;
+    gp.RetainedPrimsCulled = 0;
+    return false;
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] Indexers
 //-----------------------------------------------------------------------------
@@ -610,6 +743,67 @@ struct GetterOverrideY {
     const int Count;
 };
 
+/// Reads an ImPlotRing window of #count logical points starting at #first. The ring is two
+/// contiguous spans, so the physical index needs one compare instead of a modulo per point.
+template <typename T>
+struct GetterRing {
+    GetterRing(const ImPlotRing<T>& ring, int first, int count) :
+        Xs((const unsigned char*)ring.Xs),
+        Ys((const unsigned char*)ring.Ys),
+        Stride(ring.Stride),
+        Offset(ring.Count ? ImPosMod(ring.Offset, ring.Count) : 0),
+        Split(ring.Count - Offset),
+        First(first),
+        Count(count)
+    { }
+    template <typename I> IMPLOT_INLINE ImPlotPoint operator()(I idx) const {
+        int i = First + (int)idx;
+        i = i < Split ? i + Offset : i - Split;
+        const size_t b = (size_t)i * Stride;
+        return ImPlotPoint((double)*(const T*)(const void*)(Xs + b), (double)*(const T*)(const void*)(Ys + b));
+    }
+    const unsigned char* const Xs;
+    const unsigned char* const Ys;
+    const int Stride;
+    const int Offset;
+    const int Split;
+    const int First;
+    const int Count;
+};
+
+/// Returns a GetterRing over the whole ring, or, if its X values are sorted, over the points inside
+/// the current X range plus one on each side. Nothing is culled while the plot fits its data.
+template <typename T>
+GetterRing<T> GetRingWindow(const ImPlotRing<T>& ring) {
+    GetterRing<T> all(ring, 0, ring.Count);
+    if (!ring.SortedX || ring.Count < 3)
+        return all;
+    SetupLock();
+    ImPlotPlot& plot = *GImPlot->CurrentPlot;
+    const ImPlotAxis& x_axis = plot.Axes[plot.CurrentX];
+    const ImPlotAxis& y_axis = plot.Axes[plot.CurrentY];
+    if (x_axis.FitThisFrame || (y_axis.FitThisFrame && !ImHasFlag(y_axis.Flags, ImPlotAxisFlags_RangeFit)))
+        return all;
+    // first point with x >= Min, first point with x > Max
+    int lo = 0, hi = ring.Count;
+    while (lo < hi) {
+        const int mid = (lo + hi) / 2;
+        if (all(mid).x < x_axis.Range.Min) lo = mid + 1; else hi = mid;
+    }
+    int first = lo;
+    hi = ring.Count;
+    while (lo < hi) {
+        const int mid = (lo + hi) / 2;
+        if (all(mid).x <= x_axis.Range.Max) lo = mid + 1; else hi = mid;
+    }
+    first = ImMax(first - 1, 0);
+    const int last = ImMin(lo + 1, ring.Count);
+    // retained geometry of a window cannot be translated into the part of the data it left out
+    if (first > 0 || last < ring.Count)
+        GImPlot->NextItemData.InputClipped = true;
+    return GetterRing<T>(ring, first, last - first);
+}
+
 template <typename _Getter>
 struct GetterLoop {
     GetterLoop(_Getter getter) : Getter(getter), Count(getter.Count + 1) { }
@@ -1365,6 +1559,8 @@ void RenderPrimitivesEx(const _Renderer& renderer, ImDrawList& draw_list, const
     unsigned int prims        = renderer.Prims;
     unsigned int prims_culled = 0;
     unsigned int idx          = 0;
+    unsigned int total_culled = 0;
+    const int    vtx_start    = draw_list.VtxBuffer.Size;
     renderer.Init(draw_list);
     while (prims) {
         // find how many can be reserved up to end of current draw command's limit
@@ -1391,16 +1587,80 @@ void RenderPrimitivesEx(const _Renderer& renderer, ImDrawList& draw_list, const
         }
         prims -= cnt;
         for (unsigned int ie = idx + cnt; idx != ie; ++idx) {
-            if (!renderer.Render(draw_list, cull_rect, idx))
+            if (!renderer.Render(draw_list, cull_rect, idx)) {
                 prims_culled++;
+                total_culled++;
+            }
         }
     }
     if (prims_culled > 0)
         draw_list.PrimUnreserve(prims_culled * renderer.IdxConsumed, prims_culled * renderer.VtxConsumed);
+    // report to retained item capture
+    ImPlotContext& gp = *GImPlot;
+    if (gp.RetainedKey != 0) {
+        gp.RetainedVtxRendered += draw_list.VtxBuffer.Size - vtx_start;
+        gp.RetainedPrimsCulled += (int)total_culled;
+    }
+}
+
+/// Renders primitives later, possibly on another thread. Keeps a copy of the getter since renderers only reference theirs.
+template <class _Renderer, class _Getter>
+struct PrimitivesJob1 : ImPlotPrimitivesJob {
+    template <typename ...Args>
+    PrimitivesJob1(const _Getter& getter, Args... args) :
+        Getter(getter),
+        Renderer(Getter,args...)
+    { }
+    void Render() override {
+        RenderPrimitivesEx(Renderer, *DrawList, CullRect);
+    }
+    const _Getter   Getter;
+    const _Renderer Renderer;
+};
+
+template <class _Renderer, class _Getter1, class _Getter2>
+struct PrimitivesJob2 : ImPlotPrimitivesJob {
+    template <typename ...Args>
+    PrimitivesJob2(const _Getter1& getter1, const _Getter2& getter2, Args... args) :
+        Getter1(getter1),
+        Getter2(getter2),
+        Renderer(Getter1,Getter2,args...)
+    { }
+    void Render() override {
+        RenderPrimitivesEx(Renderer, *DrawList, CullRect);
+    }
+    const _Getter1  Getter1;
+    const _Getter2  Getter2;
+    const _Renderer Renderer;
+};
+
+static void RunParallelJobs(ImPlotJob job, int count) {
+    ImPlotContext& gp = *GImPlot;
+    if (gp.ParallelFor != nullptr && count > 1)
+        gp.ParallelFor(job, &gp, count, gp.ParallelForUserData);
+    else {
+        for (int i = 0; i < count; ++i)
+            job(i, &gp);
+    }
+}
+
+template <class _Job>
+void PushPrimitivesJob(_Job* job) {
+    ImPlotContext& gp = *GImPlot;
+    job->ClipRect = ImGui::GetWindowDrawList()->_ClipRectStack.back();
+    job->CullRect = GetCurrentPlot()->PlotRect;
+    job->VtxCount = job->Renderer.Prims * job->Renderer.VtxConsumed;
+    job->IdxCount = job->Renderer.Prims * job->Renderer.IdxConsumed;
+    gp.ParallelJobs.push_back(job);
 }
 
 template <template <class> class _Renderer, class _Getter, typename ...Args>
 void RenderPrimitives1(const _Getter& getter, Args... args) {
+    if (GImPlot->ParallelCurrentItem) {
+        typedef PrimitivesJob1<_Renderer<_Getter>,_Getter> Job;
+        PushPrimitivesJob(IM_NEW(Job)(getter,args...));
+        return;
+    }
     ImDrawList& draw_list = *GetPlotDrawList();
     const ImRect& cull_rect = GetCurrentPlot()->PlotRect;
     RenderPrimitivesEx(_Renderer<_Getter>(getter,args...), draw_list, cull_rect);
@@ -1408,11 +1668,119 @@ void RenderPrimitives1(const _Getter& getter, Args... args) {
 
 template <template <class,class> class _Renderer, class _Getter1, class _Getter2, typename ...Args>
 void RenderPrimitives2(const _Getter1& getter1, const _Getter2& getter2, Args... args) {
+    if (GImPlot->ParallelCurrentItem) {
+        typedef PrimitivesJob2<_Renderer<_Getter1,_Getter2>,_Getter1,_Getter2> Job;
+        PushPrimitivesJob(IM_NEW(Job)(getter1,getter2,args...));
+        return;
+    }
     ImDrawList& draw_list = *GetPlotDrawList();
     const ImRect& cull_rect = GetCurrentPlot()->PlotRect;
     RenderPrimitivesEx(_Renderer<_Getter1,_Getter2>(getter1,getter2,args...), draw_list, cull_rect);
 }
 
+static void RenderPrimitivesJob(int idx, void* job_data) {
+    IMGUI_PROFILE_ZONE("ImPlot::RenderPrimitivesJob");
+    ImPlotContext& gp = *(ImPlotContext*)job_data;
+    gp.ParallelJobs[idx]->Render();
+}
+
+static void CopyPrimitivesJob(int idx, void* job_data) {
+    ImPlotContext& gp = *(ImPlotContext*)job_data;
+    const ImPlotPrimitivesJob& job = *gp.ParallelJobs[idx];
+    const ImDrawList& src = *job.DrawList;
+    for (int i = 0; i < job.Copies.Size; ++i) {
+        const ImPlotPrimitivesCopy& copy = job.Copies[i];
+        const ImDrawCmd& cmd = src.CmdBuffer[copy.SrcCmd];
+        memcpy(copy.VtxDst, src.VtxBuffer.Data + cmd.VtxOffset, copy.VtxCount * sizeof(ImDrawVert));
+        const ImDrawIdx* idx_src = src.IdxBuffer.Data + cmd.IdxOffset;
+        for (unsigned int e = 0; e < cmd.ElemCount; ++e)
+            copy.IdxDst[e] = (ImDrawIdx)(copy.VtxBase + idx_src[e]);
+    }
+}
+
+// Reserves room in the plot draw list for the commands of a job's draw list and records where each goes
+static void LayoutPrimitivesJob(ImDrawList& draw_list, ImPlotPrimitivesJob& job) {
+    const ImDrawList& src = *job.DrawList;
+    job.Copies.shrink(0);
+    draw_list.PushClipRect(ImVec2(job.ClipRect.x, job.ClipRect.y), ImVec2(job.ClipRect.z, job.ClipRect.w));
+    for (int c = 0; c < src.CmdBuffer.Size; ++c) {
+        const ImDrawCmd& cmd = src.CmdBuffer[c];
+        if (cmd.ElemCount == 0)
+            continue;
+        // a job's draw list only starts new commands when its vertex offset changes
+        const int vtx_end = c + 1 < src.CmdBuffer.Size ? (int)src.CmdBuffer[c+1].VtxOffset : src.VtxBuffer.Size;
+        ImPlotPrimitivesCopy copy;
+        copy.SrcCmd   = c;
+        copy.VtxCount = vtx_end - (int)cmd.VtxOffset;
+        draw_list.PrimReserve((int)cmd.ElemCount, copy.VtxCount);
+        copy.VtxDst   = draw_list._VtxWritePtr;
+        copy.IdxDst   = draw_list._IdxWritePtr;
+        copy.VtxBase  = draw_list._VtxCurrentIdx;
+        job.Copies.push_back(copy);
+        draw_list._VtxWritePtr   += copy.VtxCount;
+        draw_list._IdxWritePtr   += cmd.ElemCount;
+        draw_list._VtxCurrentIdx += copy.VtxCount;
+    }
+    draw_list.PopClipRect();
+}
+
+void FlushParallelItems() {
+    ImPlotContext& gp = *GImPlot;
+    const int count = gp.ParallelJobs.Size;
+    if (count == 0)
+        return;
+    IMGUI_PROFILE_ZONE("ImPlot::FlushParallelItems");
+    ImDrawList& draw_list = *ImGui::GetWindowDrawList(); // not GetPlotDrawList, which flushes
+    while (gp.ParallelDrawLists.Size < count)
+        gp.ParallelDrawLists.push_back(IM_NEW(ImDrawList)(draw_list._Data));
+    for (int i = 0; i < count; ++i) {
+        ImPlotPrimitivesJob& job = *gp.ParallelJobs[i];
+        job.DrawList = gp.ParallelDrawLists[i];
+        job.DrawList->_ResetForNewFrame();
+        job.DrawList->Flags = draw_list.Flags;
+        job.DrawList->VtxBuffer.reserve(job.VtxCount);
+        job.DrawList->IdxBuffer.reserve(job.IdxCount);
+        job.DrawList->CmdBuffer.reserve(2 + job.VtxCount / (MaxIdx<ImDrawIdx>::Value / 2));
+    }
+    // generate
+    RunParallelJobs(RenderPrimitivesJob, count);
+    // lay the jobs out in submission order, then copy their geometry in parallel
+    int vtx_total = 0, idx_total = 0;
+    for (int i = 0; i < count; ++i) {
+        vtx_total += gp.ParallelJobs[i]->DrawList->VtxBuffer.Size;
+        idx_total += gp.ParallelJobs[i]->DrawList->IdxBuffer.Size;
+    }
+    draw_list.VtxBuffer.reserve(draw_list.VtxBuffer.Size + vtx_total); // write pointers must stay valid
+    draw_list.IdxBuffer.reserve(draw_list.IdxBuffer.Size + idx_total);
+    for (int i = 0; i < count; ++i)
+        LayoutPrimitivesJob(draw_list, *gp.ParallelJobs[i]);
+    RunParallelJobs(CopyPrimitivesJob, count);
+    for (int i = 0; i < count; ++i)
+        IM_DELETE(gp.ParallelJobs[i]);
+    gp.ParallelJobs.shrink(0);
+}
+
+void BeginParallelItems() {
+    ImPlotContext& gp = *GImPlot;
+    IM_ASSERT_USER_ERROR(gp.CurrentPlot != nullptr, "BeginParallelItems() needs to be called between BeginPlot() and EndPlot()!");
+    IM_ASSERT_USER_ERROR(!gp.ParallelItems, "Mismatched BeginParallelItems()/EndParallelItems()!");
+    SetupLock();
+    gp.ParallelItems = true;
+}
+
+void EndParallelItems() {
+    ImPlotContext& gp = *GImPlot;
+    IM_ASSERT_USER_ERROR(gp.ParallelItems, "Mismatched BeginParallelItems()/EndParallelItems()!");
+    FlushParallelItems();
+    gp.ParallelItems = false;
+}
+
+void SetParallelForFunc(ImPlotParallelFor func, void* user_data) {
+    ImPlotContext& gp = *GImPlot;
+    gp.ParallelFor         = func;
+    gp.ParallelForUserData = user_data;
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] Markers
 //-----------------------------------------------------------------------------
@@ -1571,6 +1939,8 @@ void RenderMarkers(const _Getter& getter, ImPlotMarker marker, float size, bool
 
 template <typename _Getter>
 void PlotLineEx(const char* label_id, const _Getter& getter, ImPlotLineFlags flags) {
+    IMGUI_PROFILE_ZONE("ImPlot::PlotLine");
+    GImPlot->ParallelNextItem = true; // primitives may be deferred (see BeginParallelItems)
     if (BeginItemEx(label_id, Fitter1<_Getter>(getter), flags, ImPlotCol_Line)) {
         if (getter.Count <= 0) {
             EndItem();
@@ -1628,9 +1998,15 @@ void PlotLine(const char* label_id, const T* xs, const T* ys, int count, ImPlotL
     PlotLineEx(label_id, getter, flags);
 }
 
+template <typename T>
+void PlotLine(const char* label_id, const ImPlotRing<T>& ring, ImPlotLineFlags flags) {
+    PlotLineEx(label_id, GetRingWindow(ring), flags);
+}
+
 #define INSTANTIATE_MACRO(T) \
     template IMPLOT_API void PlotLine<T> (const char* label_id, const T* values, int count, double xscale, double x0, ImPlotLineFlags flags, int offset, int stride); \
-    template IMPLOT_API void PlotLine<T>(const char* label_id, const T* xs, const T* ys, int count, ImPlotLineFlags flags, int offset, int stride);
+    template IMPLOT_API void PlotLine<T>(const char* label_id, const T* xs, const T* ys, int count, ImPlotLineFlags flags, int offset, int stride); \
+    template IMPLOT_API void PlotLine<T>(const char* label_id, const ImPlotRing<T>& ring, ImPlotLineFlags flags);
 CALL_INSTANTIATE_FOR_NUMERIC_TYPES()
 #undef INSTANTIATE_MACRO
 
@@ -1646,6 +2022,8 @@ void PlotLineG(const char* label_id, ImPlotGetter getter_func, void* data, int c
 
 template <typename Getter>
 void PlotScatterEx(const char* label_id, const Getter& getter, ImPlotScatterFlags flags) {
+    IMGUI_PROFILE_ZONE("ImPlot::PlotScatter");
+    GImPlot->ParallelNextItem = true; // primitives may be deferred (see BeginParallelItems)
     if (BeginItemEx(label_id, Fitter1<Getter>(getter), flags, ImPlotCol_MarkerOutline)) {
         if (getter.Count <= 0) {
             EndItem();
@@ -1696,6 +2074,8 @@ void PlotScatterG(const char* label_id, ImPlotGetter getter_func, void* data, in
 
 template <typename Getter>
 void PlotStairsEx(const char* label_id, const Getter& getter, ImPlotStairsFlags flags) {
+    IMGUI_PROFILE_ZONE("ImPlot::PlotStairs");
+    GImPlot->ParallelNextItem = true; // primitives may be deferred (see BeginParallelItems)
     if (BeginItemEx(label_id, Fitter1<Getter>(getter), flags, ImPlotCol_Line)) {
         if (getter.Count <= 0) {
             EndItem();
@@ -1742,9 +2122,15 @@ void PlotStairs(const char* label_id, const T* xs, const T* ys, int count, ImPlo
     return PlotStairsEx(label_id, getter, flags);
 }
 
+template <typename T>
+void PlotStairs(const char* label_id, const ImPlotRing<T>& ring, ImPlotStairsFlags flags) {
+    PlotStairsEx(label_id, GetRingWindow(ring), flags);
+}
+
 #define INSTANTIATE_MACRO(T) \
     template IMPLOT_API void PlotStairs<T> (const char* label_id, const T* values, int count, double xscale, double x0, ImPlotStairsFlags flags, int offset, int stride); \
-    template IMPLOT_API void PlotStairs<T>(const char* label_id, const T* xs, const T* ys, int count, ImPlotStairsFlags flags, int offset, int stride);
+    template IMPLOT_API void PlotStairs<T>(const char* label_id, const T* xs, const T* ys, int count, ImPlotStairsFlags flags, int offset, int stride); \
+    template IMPLOT_API void PlotStairs<T>(const char* label_id, const ImPlotRing<T>& ring, ImPlotStairsFlags flags);
 CALL_INSTANTIATE_FOR_NUMERIC_TYPES()
 #undef INSTANTIATE_MACRO
 
@@ -1760,6 +2146,7 @@ void PlotStairsG(const char* label_id, ImPlotGetter getter_func, void* data, int
 
 template <typename Getter1, typename Getter2>
 void PlotShadedEx(const char* label_id, const Getter1& getter1, const Getter2& getter2, ImPlotShadedFlags flags) {
+    IMGUI_PROFILE_ZONE("ImPlot::PlotShaded");
     if (BeginItemEx(label_id, Fitter2<Getter1,Getter2>(getter1,getter2), flags, ImPlotCol_Fill)) {
         if (getter1.Count <= 0 || getter2.Count <= 0) {
             EndItem();
@@ -1804,7 +2191,19 @@ void PlotShaded(const char* label_id, const T* xs, const T* ys1, const T* ys2, i
     PlotShadedEx(label_id, getter1, getter2, flags);
 }
 
+template <typename T>
+void PlotShaded(const char* label_id, const ImPlotRing<T>& ring, double y_ref, ImPlotShadedFlags flags) {
+    if (y_ref == -HUGE_VAL)
+        y_ref = GetPlotLimits(IMPLOT_AUTO,IMPLOT_AUTO).Y.Min;
+    if (y_ref == HUGE_VAL)
+        y_ref = GetPlotLimits(IMPLOT_AUTO,IMPLOT_AUTO).Y.Max;
+    GetterRing<T> getter1 = GetRingWindow(ring);
+    GetterOverrideY<GetterRing<T>> getter2(getter1, y_ref);
+    PlotShadedEx(label_id, getter1, getter2, flags);
+}
+
 #define INSTANTIATE_MACRO(T) \
+    template IMPLOT_API void PlotShaded<T>(const char* label_id, const ImPlotRing<T>& ring, double y_ref, ImPlotShadedFlags flags); \
     template IMPLOT_API void PlotShaded<T>(const char* label_id, const T* values, int count, double y_ref, double xscale, double x0, ImPlotShadedFlags flags, int offset, int stride); \
     template IMPLOT_API void PlotShaded<T>(const char* label_id, const T* xs, const T* ys, int count, double y_ref, ImPlotShadedFlags flags, int offset, int stride); \
     template IMPLOT_API void PlotShaded<T>(const char* label_id, const T* xs, const T* ys1, const T* ys2, int count, ImPlotShadedFlags flags, int offset, int stride);
@@ -1824,6 +2223,7 @@ void PlotShadedG(const char* label_id, ImPlotGetter getter_func1, void* data1, I
 
 template <typename Getter1, typename Getter2>
 void PlotBarsVEx(const char* label_id, const Getter1& getter1, const Getter2 getter2, double width, ImPlotBarsFlags flags) {
+    IMGUI_PROFILE_ZONE("ImPlot::PlotBars");
     if (BeginItemEx(label_id, FitterBarV<Getter1,Getter2>(getter1,getter2,width), flags, ImPlotCol_Fill)) {
         if (getter1.Count <= 0 || getter2.Count <= 0) {
             EndItem();
@@ -1848,6 +2248,7 @@ void PlotBarsVEx(const char* label_id, const Getter1& getter1, const Getter2 get
 
 template <typename Getter1, typename Getter2>
 void PlotBarsHEx(const char* label_id, const Getter1& getter1, const Getter2& getter2, double height, ImPlotBarsFlags flags) {
+    IMGUI_PROFILE_ZONE("ImPlot::PlotBars");
     if (BeginItemEx(label_id, FitterBarH<Getter1,Getter2>(getter1,getter2,height), flags, ImPlotCol_Fill)) {
         if (getter1.Count <= 0 || getter2.Count <= 0) {
             EndItem();
@@ -1923,6 +2324,7 @@ void PlotBarsG(const char* label_id, ImPlotGetter getter_func, void* data, int c
 
 template <typename T>
 void PlotBarGroups(const char* const label_ids[], const T* values, int item_count, int group_count, double group_size, double shift, ImPlotBarGroupsFlags flags) {
+    IMGUI_PROFILE_ZONE("ImPlot::PlotBarGroups");
     const bool horz = ImHasFlag(flags, ImPlotBarGroupsFlags_Horizontal);
     const bool stack = ImHasFlag(flags, ImPlotBarGroupsFlags_Stacked);
     if (stack) {
@@ -2008,6 +2410,7 @@ CALL_INSTANTIATE_FOR_NUMERIC_TYPES()
 
 template <typename _GetterPos, typename _GetterNeg>
 void PlotErrorBarsVEx(const char* label_id, const _GetterPos& getter_pos, const _GetterNeg& getter_neg, ImPlotErrorBarsFlags flags) {
+    IMGUI_PROFILE_ZONE("ImPlot::PlotErrorBars");
     if (BeginItemEx(label_id, Fitter2<_GetterPos,_GetterNeg>(getter_pos, getter_neg), flags, IMPLOT_AUTO)) {
         if (getter_pos.Count <= 0 || getter_neg.Count <= 0) {
             EndItem();
@@ -2033,6 +2436,7 @@ void PlotErrorBarsVEx(const char* label_id, const _GetterPos& getter_pos, const
 
 template <typename _GetterPos, typename _GetterNeg>
 void PlotErrorBarsHEx(const char* label_id, const _GetterPos& getter_pos, const _GetterNeg& getter_neg, ImPlotErrorBarsFlags flags) {
+    IMGUI_PROFILE_ZONE("ImPlot::PlotErrorBars");
     if (BeginItemEx(label_id, Fitter2<_GetterPos,_GetterNeg>(getter_pos, getter_neg), flags, IMPLOT_AUTO)) {
         if (getter_pos.Count <= 0 || getter_neg.Count <= 0) {
             EndItem();
@@ -2096,6 +2500,7 @@ CALL_INSTANTIATE_FOR_NUMERIC_TYPES()
 
 template <typename _GetterM, typename _GetterB>
 void PlotStemsEx(const char* label_id, const _GetterM& getter_mark, const _GetterB& getter_base, ImPlotStemsFlags flags) {
+    IMGUI_PROFILE_ZONE("ImPlot::PlotStems");
     if (BeginItemEx(label_id, Fitter2<_GetterM,_GetterB>(getter_mark,getter_base), flags, ImPlotCol_Line)) {
         if (getter_mark.Count <= 0 || getter_base.Count <= 0) {
             EndItem();
@@ -2160,6 +2565,7 @@ CALL_INSTANTIATE_FOR_NUMERIC_TYPES()
 
 template <typename T>
 void PlotInfLines(const char* label_id, const T* values, int count, ImPlotInfLinesFlags flags, int offset, int stride) {
+    IMGUI_PROFILE_ZONE("ImPlot::PlotInfLines");
     const ImPlotRect lims = GetPlotLimits(IMPLOT_AUTO,IMPLOT_AUTO);
     if (ImHasFlag(flags, ImPlotInfLinesFlags_Horizontal)) {
         GetterXY<IndexerConst,IndexerIdx<T>> getter_min(IndexerConst(lims.X.Min),IndexerIdx<T>(values,count,offset,stride),count);
@@ -2278,6 +2684,7 @@ double PieChartSum(const T* values, int count, bool ignore_hidden) {
 
 template <typename T>
 void PlotPieChartEx(const char* const label_ids[], const T* values, int count, ImPlotPoint center, double radius, double angle0, ImPlotPieChartFlags flags) {
+    IMGUI_PROFILE_ZONE("ImPlot::PlotPieChart");
     ImDrawList& draw_list  = *GetPlotDrawList();
 
     const bool ignore_hidden = ImHasFlag(flags, ImPlotPieChartFlags_IgnoreHidden);
@@ -2520,6 +2927,7 @@ void RenderHeatmap(ImDrawList& draw_list, const T* values, int rows, int cols, d
 
 template <typename T>
 void PlotHeatmap(const char* label_id, const T* values, int rows, int cols, double scale_min, double scale_max, const char* fmt, const ImPlotPoint& bounds_min, const ImPlotPoint& bounds_max, ImPlotHeatmapFlags flags) {
+    IMGUI_PROFILE_ZONE("ImPlot::PlotHeatmap");
     if (BeginItemEx(label_id, FitterRect(bounds_min, bounds_max))) {
         if (rows <= 0 || cols <= 0) {
             EndItem();
@@ -2541,6 +2949,7 @@ CALL_INSTANTIATE_FOR_NUMERIC_TYPES()
 
 template <typename T>
 double PlotHistogram(const char* label_id, const T* values, int count, int bins, double bar_scale, ImPlotRange range, ImPlotHistogramFlags flags) {
+    IMGUI_PROFILE_ZONE("ImPlot::PlotHistogram");
 
     const bool cumulative = ImHasFlag(flags, ImPlotHistogramFlags_Cumulative);
     const bool density    = ImHasFlag(flags, ImPlotHistogramFlags_Density);
@@ -2627,6 +3036,7 @@ CALL_INSTANTIATE_FOR_NUMERIC_TYPES()
 
 template <typename T>
 double PlotHistogram2D(const char* label_id, const T* xs, const T* ys, int count, int x_bins, int y_bins, ImPlotRect range, ImPlotHistogramFlags flags) {
+    IMGUI_PROFILE_ZONE("ImPlot::PlotHistogram2D");
 
     // const bool cumulative = ImHasFlag(flags, ImPlotHistogramFlags_Cumulative); NOT SUPPORTED
     const bool density  = ImHasFlag(flags, ImPlotHistogramFlags_Density);
@@ -2711,6 +3121,7 @@ CALL_INSTANTIATE_FOR_NUMERIC_TYPES()
 
 template <typename Getter>
 void PlotDigitalEx(const char* label_id, Getter getter, ImPlotDigitalFlags flags) {
+    IMGUI_PROFILE_ZONE("ImPlot::PlotDigital");
     if (BeginItem(label_id, flags, ImPlotCol_Fill)) {
         ImPlotContext& gp = *GImPlot;
         ImDrawList& draw_list = *GetPlotDrawList();
@@ -2774,7 +3185,15 @@ void PlotDigital(const char* label_id, const T* xs, const T* ys, int count, ImPl
     GetterXY<IndexerIdx<T>,IndexerIdx<T>> getter(IndexerIdx<T>(xs,count,offset,stride),IndexerIdx<T>(ys,count,offset,stride),count);
     return PlotDigitalEx(label_id, getter, flags);
 }
-#define INSTANTIATE_MACRO(T) template IMPLOT_API void PlotDigital<T>(const char* label_id, const T* xs, const T* ys, int count, ImPlotDigitalFlags flags, int offset, int stride);
+
+template <typename T>
+void PlotDigital(const char* label_id, const ImPlotRing<T>& ring, ImPlotDigitalFlags flags) {
+    return PlotDigitalEx(label_id, GetRingWindow(ring), flags);
+}
+
+#define INSTANTIATE_MACRO(T) \
+    template IMPLOT_API void PlotDigital<T>(const char* label_id, const T* xs, const T* ys, int count, ImPlotDigitalFlags flags, int offset, int stride); \
+    template IMPLOT_API void PlotDigital<T>(const char* label_id, const ImPlotRing<T>& ring, ImPlotDigitalFlags flags);
 CALL_INSTANTIATE_FOR_NUMERIC_TYPES()
 #undef INSTANTIATE_MACRO
 
@@ -2789,6 +3208,7 @@ void PlotDigitalG(const char* label_id, ImPlotGetter getter_func, void* data, in
 //-----------------------------------------------------------------------------
 
 void PlotImage(const char* label_id, ImTextureID user_texture_id, const ImPlotPoint& bmin, const ImPlotPoint& bmax, const ImVec2& uv0, const ImVec2& uv1, const ImVec4& tint_col, ImPlotImageFlags) {
+    IMGUI_PROFILE_ZONE("ImPlot::PlotImage");
     if (BeginItemEx(label_id, FitterRect(bmin,bmax))) {
         ImU32 tint_col32 = ImGui::ColorConvertFloat4ToU32(tint_col);
         GetCurrentItem()->Color = tint_col32;
@@ -2807,6 +3227,7 @@ void PlotImage(const char* label_id, ImTextureID user_texture_id, const ImPlotPo
 //-----------------------------------------------------------------------------
 
 void PlotText(const char* text, double x, double y, const ImVec2& pixel_offset, ImPlotTextFlags flags) {
+    IMGUI_PROFILE_ZONE("ImPlot::PlotText");
     IM_ASSERT_USER_ERROR(GImPlot->CurrentPlot != nullptr, "PlotText() needs to be called between BeginPlot() and EndPlot()!");
     SetupLock();
     ImDrawList & draw_list = *GetPlotDrawList();
@@ -2839,6 +3260,7 @@ void PlotText(const char* text, double x, double y, const ImVec2& pixel_offset,
 //-----------------------------------------------------------------------------
 
 void PlotDummy(const char* label_id, ImPlotDummyFlags flags) {
+    IMGUI_PROFILE_ZONE("ImPlot::PlotDummy");
     if (BeginItem(label_id, flags, ImPlotCol_Line))
         EndItem();
 }
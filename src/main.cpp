@@ -1,3 +1,4 @@
+#include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include <imgui.h>
 #include <imgui_impl_glfw.h>
@@ -8,12 +9,30 @@
 #include <implot_internal.h>
 
 #include <vector>
+#include <algorithm>
 #include <cmath>
 
-#include <windows.h>
 #include <string>
 
 #include <ComPort.h>
+#include <GpuLinePlot.h>
+#include <WorkerPool.h>
+#include <PacketLog.h>
+#include <FrameAllocator.h>
+#include <PortScanner.h>
+#include <LatencyTrace.h>
+#include <FrameProfiler.h>
+#include <DecodePipeline.h>
+#include <FrameCheck.h>
+#include <Cobs.h>
+#include <ClockSync.h>
+#include <DerivedChannels.h>
+#include <WindowStats.h>
+#include <FilterStage.h>
+#include <ChannelAligner.h>
+#include <CsvExport.h>
+#include <FileImport.h>
+#include <ChannelPublisher.h>
 
 enum
 {
@@ -31,6 +50,8 @@ struct slip
     size_t len;         // Number of currently buffered bytes
     int mode;           // Operation mode. 0 - serial, 1 - network
     unsigned char prev; // Previously read character
+    int overflow;       // The current packet did not fit into buf
+    size_t overflows;   // Packets dropped because they did not fit into buf
 };
 
 struct ctx
@@ -47,7 +68,8 @@ struct ctx
 // Process incoming byte `c`.
 // In serial mode, do nothing, return 1.
 // In network mode, append a byte to the `buf` and increment `len`.
-// Return size of the buffered packet when switching to serial mode, or 0
+// Return size of the buffered packet when switching to serial mode, or 0.
+// A packet that did not fit into `buf` is dropped and counted in `overflows`
 static size_t slip_recv(unsigned char c, struct slip *slip)
 {
     size_t res = 0;
@@ -63,25 +85,52 @@ static size_t slip_recv(unsigned char c, struct slip *slip)
         }
         else if (c == END)
         {
-            res = slip->len;
+            res = slip->overflow ? 0 : slip->len;
+            slip->overflows += slip->overflow;
         }
         else if (c != ESC)
         {
             slip->buf[slip->len++] = c;
         }
         if (slip->len >= slip->size)
-            slip->len = 0; // Silent overflow
+            slip->len = 0, slip->overflow = 1;
     }
     slip->prev = c;
     // The "END" character flips the mode
     if (c == END)
-        slip->len = 0, slip->mode = !slip->mode;
+        slip->len = 0, slip->overflow = 0, slip->mode = !slip->mode;
     return res;
 }
 
+// Состояние принятого кадра в DecodePipeline::Frame::Status
+enum
+{
+    FRAME_GOOD = 0,
+    FRAME_CRC_FAILED,
+    FRAME_OVERFLOW,
+    FRAME_MALFORMED // Нарушена кодировка COBS
+};
+
+// Кодирование кадров на линии
+enum
+{
+    ENCODING_SLIP = 0,
+    ENCODING_COBS
+};
+
+// Счётчики кадров открытого порта: пишет только обработчик пула (по порядку приёма), читает UI
+struct FrameCounters
+{
+    std::atomic<ImU64> good{0};
+    std::atomic<ImU64> crc_failed{0};
+    std::atomic<ImU64> overflowed{0};
+    std::atomic<ImU64> malformed{0};
+    std::atomic<ImU64> resynced{0}; // Хорошие кадры сразу после испорченных
+};
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void RenderBottomMenu()
+void RenderBottomMenu(FrameAllocator &allocator, const DecodePipeline::Stats &decode, const FrameCounters &frames)
 {
     // Получаем размеры экрана (предполагается, что у вас есть доступ к этим данным)
     ImVec2 screenSize = ImGui::GetIO().DisplaySize; // Размер окна приложения
@@ -117,6 +166,23 @@ void RenderBottomMenu()
         // Действие для кнопки 3
     }
 
+    // Статистика выделений памяти ImGui/ImPlot за прошлый кадр
+    const FrameAllocator::Stats &stats = allocator.LastFrame();
+    ImGui::TextUnformatted(allocator.Format("Allocs/frame: %d (%d from malloc), %.1f KB, live %.1f KB, peak %.1f KB",
+                                            stats.Allocs, stats.SystemAllocs, stats.Bytes / 1024.0,
+                                            stats.LiveBytes / 1024.0, stats.PeakBytes / 1024.0));
+
+    // Пул декодирования принятых данных
+    ImGui::TextUnformatted(allocator.Format("Decode: %d workers, queue %d (max %d), %llu frames in %llu batches, %llu stalls, %llu reordered, %llu stolen, %llu bytes dropped",
+                                            decode.Workers, decode.Queued, decode.MaxQueued,
+                                            (unsigned long long)decode.Frames, (unsigned long long)decode.Batches,
+                                            (unsigned long long)decode.Stalls, (unsigned long long)decode.Reordered,
+                                            (unsigned long long)decode.Steals, (unsigned long long)decode.Dropped));
+    ImGui::TextUnformatted(allocator.Format("Frames: %llu good, %llu CRC failed, %llu overflowed, %llu malformed, %llu resynced",
+                                            (unsigned long long)frames.good.load(), (unsigned long long)frames.crc_failed.load(),
+                                            (unsigned long long)frames.overflowed.load(), (unsigned long long)frames.malformed.load(),
+                                            (unsigned long long)frames.resynced.load()));
+
     // Завершаем окно
     ImGui::End();
 }
@@ -126,11 +192,13 @@ struct ScrollingBuffer
 {
     int MaxSize;
     int Offset;
+    ImU64 Version; // Увеличивается при каждом изменении данных (версия для retained-режима ImPlot)
     ImVector<ImVec2> Data;
     ScrollingBuffer(int max_size = 6000)
     {
         MaxSize = max_size;
         Offset = 0;
+        Version = 0;
         Data.reserve(MaxSize);
     }
     void AddPoint(float x, float y)
@@ -142,6 +210,7 @@ struct ScrollingBuffer
             Data[Offset] = ImVec2(x, y);
             Offset = (Offset + 1) % MaxSize;
         }
+        Version++;
     }
     void Erase()
     {
@@ -149,12 +218,560 @@ struct ScrollingBuffer
         {
             Data.shrink(0);
             Offset = 0;
+            Version++;
         }
     }
 };
 
-void RenderGraphs()
+// Время графика в секундах по steady_clock, как у принятых кадров, а не сумма DeltaTime
+static const ImU64 graph_origin = LatencyTrace::Now();
+
+static double GraphTime(ImU64 ns)
+{
+    return (double)(ImS64)(ns - graph_origin) * 1e-9;
+}
+
+// Скользящая статистика канала за окно истории графика
+struct ChannelStats
+{
+    std::string name;
+    unsigned version = 0; // DerivedChannels::Version, при пересчёте канала статистика строится заново
+    ImU64 fed = 0;        // Следующая строка канала
+    WindowStats stats;
+};
+
+// Новые строки каналов в статистику, O(новых строк). Канал 0 - время
+void UpdateChannelStats(const DerivedChannels &channels, std::vector<ChannelStats> &stats, float window)
+{
+    const float *time = channels.Values(0);
+    const size_t rows = channels.Size(0);
+    stats.resize(channels.Count());
+    for (int i = 1; i < channels.Count(); i++)
+    {
+        ChannelStats &s = stats[i];
+        if (s.name != channels.Name(i) || s.version != channels.Version(i))
+        {
+            // Только строки, которые ещё могут попасть в окно
+            s.name = channels.Name(i);
+            s.version = channels.Version(i);
+            s.stats.Reset();
+            const float oldest = rows > 0 ? time[rows - 1] - (float)s.stats.MaxWindow() : 0.0f;
+            s.fed = channels.FirstRow() + (std::lower_bound(time, time + rows, oldest) - time);
+        }
+        s.stats.SetWindow(window);
+        const float *values = channels.Values(i);
+        s.fed = ImMax(s.fed, channels.FirstRow());
+        for (; s.fed < channels.FirstRow() + channels.Size(i); s.fed++)
+        {
+            const size_t row = (size_t)(s.fed - channels.FirstRow());
+            s.stats.Push(time[row], values[row]);
+        }
+    }
+}
+
+// Строки каналов, ещё не отданные ChannelPublisher
+struct PublisherFeed
+{
+    std::vector<std::string> names;
+    std::vector<unsigned> versions;
+    ImU64 fed = 0; // Следующая строка
+};
+
+// Новые строки всех каналов в общую память, блок публикуется каждый кадр. При изменении списка
+// каналов читатели получают новые имена, строки идут с текущего конца
+void UpdatePublisher(const DerivedChannels &channels, ChannelPublisher &publisher, PublisherFeed &feed)
+{
+    bool changed = (int)feed.names.size() != channels.Count();
+    for (int i = 0; !changed && i < channels.Count(); i++)
+        changed = feed.names[i] != channels.Name(i) || feed.versions[i] != channels.Version(i);
+    if (changed)
+    {
+        feed.names.clear();
+        feed.versions.clear();
+        for (int i = 0; i < channels.Count(); i++)
+        {
+            feed.names.push_back(channels.Name(i));
+            feed.versions.push_back(channels.Version(i));
+        }
+        publisher.SetChannels(feed.names);
+        feed.fed = channels.Rows();
+    }
+    const int count = ImMin(channels.Count(), (int)ChannelShm::MaxChannels);
+    float row[ChannelShm::MaxChannels];
+    feed.fed = ImMax(feed.fed, channels.FirstRow());
+    for (; feed.fed < channels.Rows(); feed.fed++)
+    {
+        const size_t index = (size_t)(feed.fed - channels.FirstRow());
+        for (int i = 0; i < count; i++)
+            row[i] = index < channels.Size(i) ? channels.Values(i)[index] : NAN;
+        publisher.Append(feed.fed, row);
+    }
+    publisher.Flush();
+}
+
+// Таблица статистики, O(каналов)
+void RenderChannelStats(const DerivedChannels &channels, const std::vector<ChannelStats> &stats)
+{
+    if (!ImGui::BeginTable("stats", 10, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchSame))
+        return;
+    const char *columns[] = {"Channel", "N", "Min", "Max", "Mean", "RMS", "StdDev", "P50", "P95", "P99"};
+    for (const char *column : columns)
+        ImGui::TableSetupColumn(column);
+    ImGui::TableHeadersRow();
+    for (int i = 1; i < (int)stats.size(); i++)
+    {
+        const WindowStats &s = stats[i].stats;
+        const double values[] = {s.Min(), s.Max(), s.Mean(), s.Rms(), s.StdDev(), s.Percentile(0.5), s.Percentile(0.95), s.Percentile(0.99)};
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGui::TextUnformatted(channels.Name(i));
+        ImGui::TableNextColumn();
+        ImGui::Text("%d", s.Count());
+        for (double value : values)
+        {
+            ImGui::TableNextColumn();
+            ImGui::Text("%.4g", value);
+        }
+    }
+    ImGui::EndTable();
+}
+
+// Фильтры источников графика, применяются кнопкой Apply
+struct FilterSettings
+{
+    std::vector<FilterStage::Design> designs; // По одному на источник, "t" не фильтруется
+    float sample_rate = 60.0f;                // Строки графика добавляются раз в кадр
+    int decimation = 1;
+};
+
+void RenderFilters(const DerivedChannels &channels, FilterSettings &settings, FilterStage &filter, bool *p_open)
+{
+    if (!ImGui::Begin("Filters", p_open))
+    {
+        ImGui::End();
+        return;
+    }
+    int sources = 0;
+    while (sources < channels.Count() && !channels.IsDerived(sources))
+        sources++;
+    settings.designs.resize(sources);
+    ImGui::SetNextItemWidth(ImGui::GetFontSize() * 8);
+    ImGui::InputFloat("Sample rate, Hz", &settings.sample_rate, 0, 0, "%.1f");
+    settings.sample_rate = ImMax(settings.sample_rate, 1.0f);
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(ImGui::GetFontSize() * 8);
+    ImGui::SliderInt("Decimation", &settings.decimation, 1, 16);
+    for (int i = 1; i < sources; i++)
+    {
+        FilterStage::Design &design = settings.designs[i];
+        ImGui::PushID(i);
+        ImGui::SeparatorText(channels.Name(i));
+        ImGui::SetNextItemWidth(ImGui::GetFontSize() * 12);
+        if (ImGui::BeginCombo("Type", FilterStage::TypeName(design.Kind)))
+        {
+            for (int type = 0; type < FilterStage::Type_COUNT; type++)
+            {
+                if (ImGui::Selectable(FilterStage::TypeName((FilterStage::Type)type), design.Kind == type))
+                    design.Kind = (FilterStage::Type)type;
+            }
+            ImGui::EndCombo();
+        }
+        if (design.Kind != FilterStage::Type_None)
+        {
+            ImGui::SetNextItemWidth(ImGui::GetFontSize() * 8);
+            ImGui::InputDouble(design.Kind == FilterStage::Type_Notch ? "Centre, Hz" : "Cutoff, Hz", &design.Cutoff, 0, 0, "%.2f");
+        }
+        if (design.Kind == FilterStage::Type_Notch)
+        {
+            ImGui::SetNextItemWidth(ImGui::GetFontSize() * 8);
+            ImGui::InputDouble("Q", &design.Q, 0, 0, "%.1f");
+        }
+        else if (design.Kind != FilterStage::Type_None)
+        {
+            ImGui::SetNextItemWidth(ImGui::GetFontSize() * 8);
+            ImGui::SliderInt("Order", &design.Order, 1, FilterStage::MaxOrder);
+        }
+        if (design.Kind == FilterStage::Type_ChebyshevLowPass || design.Kind == FilterStage::Type_ChebyshevHighPass)
+        {
+            ImGui::SetNextItemWidth(ImGui::GetFontSize() * 8);
+            ImGui::InputDouble("Ripple, dB", &design.RippleDb, 0, 0, "%.2f");
+        }
+        ImGui::PopID();
+    }
+    if (ImGui::Button("Apply"))
+        filter.Configure(sources, settings.designs.data(), settings.sample_rate, settings.decimation);
+    ImGui::SameLine();
+    ImGui::TextDisabled("resets the filter state");
+
+    // АЧХ выбранных фильтров
+    if (ImPlot::BeginPlot("##response", ImVec2(-1, -1)))
+    {
+        ImPlot::SetupAxes("Hz", "dB", ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_None);
+        ImPlot::SetupAxisLimits(ImAxis_Y1, -80, 5);
+        const int points = 256;
+        static float xs[points], ys[points];
+        for (int i = 1; i < sources; i++)
+        {
+            FilterStage::Biquad sections[FilterStage::MaxSections];
+            const int count = FilterStage::DesignBiquads(settings.designs[i], settings.sample_rate, sections);
+            if (count == 0)
+                continue;
+            for (int p = 0; p < points; p++)
+            {
+                xs[p] = settings.sample_rate * 0.5f * p / (points - 1);
+                ys[p] = (float)(20.0 * log10(FilterStage::Response(sections, count, xs[p], settings.sample_rate) + 1e-12));
+            }
+            ImPlot::PlotLine(channels.Name(i), xs, ys, points);
+        }
+        ImPlot::EndPlot();
+    }
+    ImGui::End();
+}
+
+// Выбор столбцов и интервала времени для экспорта каналов
+struct ExportSettings
+{
+    std::vector<std::string> names = {"t", "mouse_y"}; // Отмеченные каналы
+    float from = 0.0f, to = 0.0f;   // По каналу "t", to = 0 - до конца
+    int format = 0;                 // CSV, TSV
+    char filename[256] = "channels.csv";
+};
+
+// Копирует отмеченные каналы в интервале и отдаёт CsvExport, запись идёт в его потоке
+void RenderExport(const DerivedChannels &channels, ExportSettings &settings, CsvExport &exporter, bool *p_open)
+{
+    if (!ImGui::Begin("Export", p_open))
+    {
+        ImGui::End();
+        return;
+    }
+    for (int i = 0; i < channels.Count(); i++)
+    {
+        std::vector<std::string>::iterator it = std::find(settings.names.begin(), settings.names.end(), channels.Name(i));
+        bool selected = it != settings.names.end();
+        if (ImGui::Checkbox(channels.Name(i), &selected))
+        {
+            if (selected)
+                settings.names.push_back(channels.Name(i));
+            else
+                settings.names.erase(it);
+        }
+        ImGui::SameLine();
+    }
+    ImGui::NewLine();
+    ImGui::SetNextItemWidth(ImGui::GetFontSize() * 6);
+    ImGui::InputFloat("From, s", &settings.from, 0, 0, "%.2f");
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(ImGui::GetFontSize() * 6);
+    ImGui::InputFloat("To, s", &settings.to, 0, 0, "%.2f");
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(ImGui::GetFontSize() * 5);
+    ImGui::Combo("Format", &settings.format, "CSV\0TSV\0");
+    ImGui::SetNextItemWidth(ImGui::GetFontSize() * 16);
+    ImGui::InputText("File", settings.filename, sizeof(settings.filename));
+
+    if (exporter.Busy())
+    {
+        ImGui::ProgressBar(exporter.Progress(), ImVec2(ImGui::GetFontSize() * 16, 0));
+        ImGui::SameLine();
+        if (ImGui::Button("Cancel"))
+            exporter.Cancel();
+        ImGui::End();
+        return;
+    }
+    if (ImGui::Button("Export"))
+    {
+        // Строки в интервале: "t" не убывает
+        const float *time = channels.Values(0);
+        const size_t size = channels.Size(0);
+        size_t last = settings.to > 0.0f ? std::upper_bound(time, time + size, settings.to) - time : size;
+        std::vector<int> selected;
+        for (int i = 0; i < channels.Count(); i++)
+        {
+            if (std::find(settings.names.begin(), settings.names.end(), channels.Name(i)) == settings.names.end())
+                continue;
+            selected.push_back(i);
+            last = ImMin(last, channels.Size(i)); // Каналы-выражения могут отставать от источников
+        }
+        const size_t first = ImMin((size_t)(std::lower_bound(time, time + size, settings.from) - time), last);
+        std::vector<std::string> names;
+        std::vector<std::vector<float>> columns;
+        for (int i : selected)
+        {
+            names.push_back(channels.Name(i));
+            columns.emplace_back(channels.Values(i) + first, channels.Values(i) + last);
+        }
+        exporter.Start(settings.filename, std::move(names), std::move(columns), settings.format == 1 ? '\t' : ',');
+    }
+    const CsvExport::Result result = exporter.GetResult();
+    if (result.Done)
+    {
+        ImGui::SameLine();
+        if (result.Failed)
+            ImGui::TextColored(ImVec4(1, 0.4f, 0.4f, 1), "Failed to write %s", exporter.Filename().c_str());
+        else if (result.Cancelled)
+            ImGui::TextDisabled("Cancelled");
+        else
+            ImGui::Text("%llu rows, %.1f MB in %.2f s (%.0f rows/s, %.0f MB/s)", (unsigned long long)result.Rows,
+                        result.Bytes * 1e-6, result.Seconds, result.Rows / ImMax(result.Seconds, 1e-6),
+                        result.Bytes * 1e-6 / ImMax(result.Seconds, 1e-6));
+    }
+    ImGui::End();
+}
+
+// Файл для просмотра и положение окна в нём
+struct ImportSettings
+{
+    char filename[256] = "capture.csv";
+    int format = FileImport::Format_Csv;
+    bool device_timestamps = false;
+    std::string error;
+    double position = 0.0; // Начало окна, в единицах времени файла
+    float window = 10.0f;
+};
+
+// Точки столбца куска для ImPlot::PlotLineG: время double, значения float, с прореживанием
+struct ImportSeries
+{
+    const double *time;
+    const float *values;
+    int stride;
+};
+
+static ImPlotPoint ImportPoint(int idx, void *data)
+{
+    const ImportSeries &series = *(const ImportSeries *)data;
+    return ImPlotPoint(series.time[idx * series.stride], series.values[idx * series.stride]);
+}
+
+// Открывает CSV или дамп SLIP через FileImport и рисует окно времени из кусков, которые уже проиндексированы
+void RenderImport(FileImport &file_import, ImportSettings &settings, bool *p_open)
+{
+    if (!ImGui::Begin("Import", p_open))
+    {
+        ImGui::End();
+        return;
+    }
+    ImGui::SetNextItemWidth(ImGui::GetFontSize() * 16);
+    ImGui::InputText("File", settings.filename, sizeof(settings.filename));
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(ImGui::GetFontSize() * 7);
+    ImGui::Combo("Format", &settings.format, "CSV/TSV\0SLIP dump\0");
+    if (settings.format == FileImport::Format_SlipDump)
+    {
+        ImGui::SameLine();
+        ImGui::Checkbox("Device timestamps", &settings.device_timestamps);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Open"))
+    {
+        settings.error.clear();
+        settings.position = 0.0;
+        file_import.Open(settings.filename, (FileImport::Format)settings.format, settings.device_timestamps, &settings.error);
+    }
+    if (!settings.error.empty())
+        ImGui::TextColored(ImVec4(1, 0.4f, 0.4f, 1), "%s", settings.error.c_str());
+    const int indexed = file_import.Indexed();
+    if (!file_import.IsOpen() || indexed == 0)
+    {
+        ImGui::End();
+        return;
+    }
+    if (!file_import.Done())
+    {
+        char overlay[64];
+        snprintf(overlay, sizeof(overlay), "%d / %d chunks", indexed, file_import.ChunkCount());
+        ImGui::ProgressBar((float)indexed / file_import.ChunkCount(), ImVec2(ImGui::GetFontSize() * 16, 0), overlay);
+        ImGui::SameLine();
+    }
+    ImGui::Text("%.1f MB, %llu rows", file_import.FileSize() / 1048576.0, (unsigned long long)file_import.IndexedRows());
+
+    // Время по проиндексированным кускам
+    double first = NAN, last = NAN;
+    for (int i = 0; i < indexed && first != first; i++)
+        first = file_import.Info(i).FirstTime;
+    for (int i = indexed - 1; i >= 0 && last != last; i--)
+        last = file_import.Info(i).LastTime;
+    if (first != first)
+    {
+        ImGui::End();
+        return;
+    }
+    if (settings.position < first)
+        settings.position = first;
+    ImGui::SetNextItemWidth(ImGui::GetFontSize() * 24);
+    ImGui::SliderScalar(file_import.TimeName(), ImGuiDataType_Double, &settings.position, &first, &last, "%.3f");
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(ImGui::GetFontSize() * 6);
+    ImGui::InputFloat("Window", &settings.window, 0, 0, "%.2f");
+    settings.window = ImMax(settings.window, 1e-3f);
+
+    if (ImPlot::BeginPlot("##import", ImVec2(-1, -1)))
+    {
+        const double begin = settings.position, end = settings.position + settings.window;
+        ImPlot::SetupAxes(file_import.TimeName(), nullptr, ImPlotAxisFlags_None, ImPlotAxisFlags_AutoFit);
+        ImPlot::SetupAxisLimits(ImAxis_X1, begin, end, ImGuiCond_Always);
+        // Не больше 8 кусков и ~4 точек на пиксель
+        const int max_chunks = 8;
+        const int budget = (int)ImGui::GetContentRegionAvail().x * 4;
+        const int seek = file_import.Seek(begin);
+        for (int c = seek; c < indexed && c < seek + max_chunks; c++)
+        {
+            const FileImport::ChunkInfo &info = file_import.Info(c);
+            if (info.Rows == 0)
+                continue;
+            if (info.FirstTime > end)
+                break;
+            std::shared_ptr<const FileImport::Data> data = file_import.Get(c);
+            const double *time = data->Time.data();
+            const size_t from = std::lower_bound(time, time + data->Time.size(), begin) - time;
+            const size_t to = std::upper_bound(time, time + data->Time.size(), end) - time;
+            if (to <= from)
+                continue;
+            const int stride = (int)ImMax((to - from) / ImMax(budget, 1), (size_t)1);
+            for (int i = 0; i < file_import.ColumnCount(); i++)
+            {
+                ImportSeries series = {time + from, data->Columns[i].data() + from, stride};
+                ImPlot::PlotLineG(file_import.ColumnName(i), ImportPoint, &series, (int)((to - from) / stride));
+            }
+        }
+        ImPlot::EndPlot();
+    }
+    ImGui::End();
+}
+
+// Серии ChannelAligner: каналы графика кроме "t" и размеры принятых кадров со своим временем
+struct AlignerFeed
+{
+    std::vector<std::string> names; // Каналы, по которым построены серии
+    std::vector<unsigned> versions;
+    std::vector<ImU64> fed;         // Следующая строка канала
+    int rx_series = -1;
+};
+
+// Новые строки каналов и кадры порта в aligner. При изменении списка каналов серии строятся заново
+void UpdateAligner(const DerivedChannels &channels, ChannelAligner &aligner, AlignerFeed &feed,
+                   const std::vector<std::pair<double, float>> &rx_sizes, double now)
+{
+    bool changed = (int)feed.names.size() != channels.Count();
+    for (int i = 0; !changed && i < channels.Count(); i++)
+        changed = feed.names[i] != channels.Name(i) || feed.versions[i] != channels.Version(i);
+    if (changed)
+    {
+        aligner.Clear();
+        feed.names.clear();
+        feed.versions.clear();
+        feed.fed.clear();
+        for (int i = 0; i < channels.Count(); i++)
+        {
+            feed.names.push_back(channels.Name(i));
+            feed.versions.push_back(channels.Version(i));
+            feed.fed.push_back(channels.FirstRow() + channels.Size(i)); // С текущего момента
+            if (i > 0)
+                aligner.AddSeries(channels.Name(i));
+        }
+        feed.rx_series = aligner.AddSeries("rx_frame_size");
+    }
+    const float *time = channels.Values(0);
+    for (int i = 1; i < channels.Count(); i++)
+    {
+        const float *values = channels.Values(i);
+        ImU64 &fed = feed.fed[i];
+        fed = ImMax(fed, channels.FirstRow());
+        for (; fed < channels.FirstRow() + channels.Size(i); fed++)
+        {
+            const size_t row = (size_t)(fed - channels.FirstRow());
+            aligner.Append(i - 1, time[row], values[row]);
+        }
+    }
+    for (const std::pair<double, float> &sample : rx_sizes)
+        aligner.Append(feed.rx_series, sample.first, sample.second);
+    aligner.Update(now);
+}
+
+// XY-график и взаимная корреляция двух серий по выровненным столбцам
+void RenderAlignment(ChannelAligner &aligner, bool *p_open)
 {
+    if (!ImGui::Begin("XY plot", p_open))
+    {
+        ImGui::End();
+        return;
+    }
+    static int series_a = 0, series_b = 1;
+    static float window = 10.0f;
+    static float step_ms = 10.0f;
+    int mode = aligner.GetMode();
+    ImGui::SetNextItemWidth(ImGui::GetFontSize() * 6);
+    if (ImGui::InputFloat("Step, ms", &step_ms, 0, 0, "%.1f", ImGuiInputTextFlags_EnterReturnsTrue))
+        aligner.SetStep(ImMax(step_ms, 0.1f) * 1e-3);
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(ImGui::GetFontSize() * 8);
+    if (ImGui::Combo("Interpolation", &mode, "Zero-order hold\0Linear\0"))
+        aligner.SetMode((ChannelAligner::Mode)mode);
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(ImGui::GetFontSize() * 8);
+    ImGui::SliderFloat("Window", &window, 1, 60, "%.0f s");
+    const int count = aligner.Count();
+    series_a = ImClamp(series_a, 0, ImMax(count - 1, 0));
+    series_b = ImClamp(series_b, 0, ImMax(count - 1, 0));
+    for (int *series : {&series_a, &series_b})
+    {
+        ImGui::SetNextItemWidth(ImGui::GetFontSize() * 10);
+        if (ImGui::BeginCombo(series == &series_a ? "X" : "Y", count > 0 ? aligner.Name(*series) : ""))
+        {
+            for (int i = 0; i < count; i++)
+                if (ImGui::Selectable(aligner.Name(i), *series == i))
+                    *series = i;
+            ImGui::EndCombo();
+        }
+        if (series == &series_a)
+            ImGui::SameLine();
+    }
+    const size_t rows = aligner.Rows();
+    const size_t n = count > 0 ? ImMin(rows, (size_t)(window / aligner.Step())) : 0;
+    if (n < 2)
+    {
+        ImGui::TextDisabled("No aligned rows yet");
+        ImGui::End();
+        return;
+    }
+    const float *a = aligner.Column(series_a) + rows - n;
+    const float *b = aligner.Column(series_b) + rows - n;
+    const float half = ImGui::GetContentRegionAvail().x * 0.5f - ImGui::GetStyle().ItemSpacing.x;
+    if (ImPlot::BeginPlot("##xy", ImVec2(half, -1)))
+    {
+        ImPlot::SetupAxes(aligner.Name(series_a), aligner.Name(series_b), ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_AutoFit);
+        ImPlot::PlotLine("##xy", a, b, (int)n);
+        ImPlot::EndPlot();
+    }
+    ImGui::SameLine();
+    // Корреляция по последним строкам окна: O(строк * лагов)
+    const int max_lag = 50;
+    static float lags[2 * max_lag + 1], correlation[2 * max_lag + 1];
+    const int m = (int)ImMin(n, (size_t)4096);
+    ChannelAligner::CrossCorrelation(a + n - m, b + n - m, m, max_lag, correlation);
+    int peak = 0;
+    for (int i = 0; i <= 2 * max_lag; i++)
+    {
+        lags[i] = (float)((i - max_lag) * aligner.Step() * 1e3);
+        if (fabsf(correlation[i]) > fabsf(correlation[peak]))
+            peak = i;
+    }
+    if (ImPlot::BeginPlot("Cross-correlation", ImVec2(-1, -1)))
+    {
+        ImPlot::SetupAxes("lag of Y, ms", nullptr, ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_Lock);
+        ImPlot::SetupAxisLimits(ImAxis_Y1, -1, 1);
+        ImPlot::PlotLine("r", lags, correlation, 2 * max_lag + 1);
+        ImPlot::TagX(lags[peak], ImVec4(1, 1, 0, 1), "%.0f ms", lags[peak]);
+        ImPlot::EndPlot();
+    }
+    ImGui::End();
+}
+
+// Каналы: источники "t" (время, с) и "mouse_y", остальные - выражения над ними
+void RenderGraphs(GpuLinePlot &gpu_line, FilterStage &filter, DerivedChannels &channels, std::vector<ChannelStats> &stats)
+{
+    PROFILE_ZONE("RenderGraphs");
     ImVec2 screenSize = ImGui::GetIO().DisplaySize;                     // Размер экрана
     ImGui::SetNextWindowPos(ImVec2(0, 20));                             // Позиция: x=0, y=высота меню
     ImGui::SetNextWindowSize(ImVec2(screenSize.x, screenSize.y - 250)); // Размер: ширина экрана, высота = экран - меню
@@ -166,13 +783,28 @@ void RenderGraphs()
                      ImGuiWindowFlags_NoMove);   // Нельзя двигать
 
     static ScrollingBuffer sdata2;
+    static bool paused = false;
     ImVec2 mouse = ImGui::GetMousePos();
     static float t = 0;
-    t += ImGui::GetIO().DeltaTime;
-    sdata2.AddPoint(t, mouse.y * 0.0005f);
+    if (!paused)
+    {
+        t = (float)GraphTime(LatencyTrace::Now());
+        sdata2.AddPoint(t, mouse.y * 0.0005f);
+        // Источники проходят через фильтры, при прореживании строка выходит не каждый раз
+        float row[] = {t, mouse.y * 0.0005f};
+        if (filter.Process(row, 1, row) > 0)
+            channels.Append(row);
+    }
+    channels.Update(); // Только новые строки
 
     static float history = 10.0f;
-    ImGui::SliderFloat("History", &history, 1, 30, "%.1f s");
+    ImGui::SliderFloat("History", &history, 1, 30, "%.1f s"); // Не больше окна, которое хранит WindowStats
+    UpdateChannelStats(channels, stats, history);
+    ImGui::SameLine();
+    ImGui::Checkbox("Pause", &paused); // Замороженный график не перестраивает геометрию (retained mode)
+    static bool gpu_lines = true;
+    ImGui::SameLine();
+    ImGui::Checkbox("GPU lines", &gpu_lines); // Отрисовка линий шейдером, без тесселяции на CPU
 
     static ImPlotAxisFlags flags = ImPlotAxisFlags_NoTickLabels;
 
@@ -184,31 +816,100 @@ void RenderGraphs()
         ImPlot::SetNextFillStyle(IMPLOT_AUTO_COL, 0.5f);
         ImPlot::PushStyleVar(ImPlotStyleVar_LineWeight, 2.0f);
         ImPlot::SetupAxes("x", "y");
-        ImPlot::PlotLine("Mouse Y", &sdata2.Data[0].x, &sdata2.Data[0].y, sdata2.Data.size(), 0, sdata2.Offset, 2 * sizeof(float));
+        ImPlot::BeginParallelItems(); // С View > Parallel plot items вершины линий строятся в пуле потоков и сливаются в порядке вызовов
+        if (!gpu_lines || !gpu_line.PlotLine("Mouse Y", sdata2.Data.Data, sdata2.Data.size(), sdata2.MaxSize, sdata2.Offset, sdata2.Version))
+        {
+            // CPU путь: если GPU недоступен или оси нелинейные
+            ImPlot::SetNextItemRetained(sdata2.Version);
+            // Кольцевой буфер: X (время) возрастает, поэтому строятся только точки в видимом окне
+            ImPlot::PlotLine("Mouse Y", ImPlotRing<float>(&sdata2.Data[0].x, &sdata2.Data[0].y, sdata2.Data.size(), sdata2.Offset, true, 2 * sizeof(float)));
+        }
+        // Каналы кроме времени: строки в окне истории, время возрастает
+        const float *time = channels.Values(0);
+        const size_t from = std::lower_bound(time, time + channels.Size(0), t - history) - time;
+        for (int i = 0; i < channels.Count(); i++)
+        {
+            if (i > 0 && channels.Size(i) > from)
+                ImPlot::PlotLine(channels.Name(i), time + from, channels.Values(i) + from, (int)(channels.Size(i) - from));
+        }
+        ImPlot::EndParallelItems();
         ImPlot::EndPlot();
     }
+    RenderChannelStats(channels, stats);
     ImGui::End();
 }
 
-void OnDataReceive(char data)
-{
-}
-
 class Application
 {
 
 private:
+    FrameAllocator allocator; // Первый член: разрушается последним, после ImGui::DestroyContext()
     std::string openned_com_name = "No opened COM";
+    PacketLog packet_log; // Объявлен до COM: поток приёма завершается раньше, чем разрушается журнал
+    LatencyTrace latency; // Задержка кадра по этапам от чтения из порта до вывода на экран, тоже до COM
+    bool show_latency = false;
+    std::mutex rx_sizes_mutex;                       // Кадры приходят из потоков пула decoder, объявлены до него
+    std::vector<std::pair<double, float>> rx_sizes;  // Время (с, как у графика) и размер принятых кадров
+    std::vector<std::pair<double, float>> rx_sizes_ui;
+    FrameProfiler profiler; // Окно зон профилировщика, F9 - запись последних секунд в файл
+    bool show_profiler = false;
+    bool frame_timestamps = false;            // Кадры начинаются с 32-битного счётчика микросекунд устройства
+    std::atomic<bool> port_timestamps{false}; // Настройка открытого порта, читается потоками пула
+    ClockSync device_clock;                   // Часы устройства открытого порта в steady_clock хоста
+    bool show_clock = false;
+    FrameCheck::Type frame_check = FrameCheck::Type_None;            // Выбранная в меню проверка кадров, применяется при открытии порта
+    std::atomic<FrameCheck::Type> port_check{FrameCheck::Type_None}; // Проверка открытого порта, читается потоками пула
+    int frame_encoding = ENCODING_SLIP;                              // Выбранное в меню кодирование, применяется при открытии порта
+    std::atomic<int> port_encoding{ENCODING_SLIP};                   // Кодирование открытого порта
+    FrameCounters rx_frames;
+    bool rx_bad = false; // Последний кадр был испорчен (только обработчик пула)
+    // Разбор принятых данных в пуле потоков, после него COM: поток приёма останавливается первым.
+    // ~DecodePipeline доразбирает очередь и вызывает DeliverBatch, поэтому всё, чего касаются
+    // DecodeBatch и DeliverBatch, объявлено выше и разрушается позже
+    DecodePipeline decoder;
+    int com_stream;         // Поток данных COM-порта в decoder
+    DerivedChannels channels; // Данные графика и каналы-выражения над ними
+    std::vector<ChannelStats> channel_stats;
+    FilterStage filter; // Источники графика до записи в channels
+    FilterSettings filter_settings;
+    bool show_filters = false;
+    CsvExport exporter;
+    ExportSettings export_settings;
+    bool show_export = false;
+    FileImport file_import;
+    ImportSettings import_settings;
+    bool show_import = false;
+    ChannelPublisher publisher; // Каналы для других процессов через общую память "sept_channels"
+    PublisherFeed publisher_feed;
+    bool publish_channels = false;
+    ChannelAligner aligner; // Каналы разной частоты на общей сетке для XY-графика и корреляции
+    AlignerFeed aligner_feed;
+    bool show_xy = false;
+    bool show_channels = false;
     ComPort COM;
+    PortScanner ports;             // Список портов обновляется в фоновом потоке (подключение/отключение USB)
+    unsigned ports_generation = 0; // Последний обработанный снимок списка портов
+    std::string reconnect_serial;  // Серийный номер USB устройства открытого порта, пусто - не переподключать
+    int reconnect_baud = 0;
+    GpuLinePlot gpu_line;
+    WorkerPool workers;
+    bool parallel_items = false; // Вершины линий в пуле workers (View > Parallel plot items)
 
-    uint8_t slipbuf[32 * 1024]; // Buffer for SLIP context
+    static const size_t max_frame = 32 * 1024; // Более длинные кадры отбрасываются
     struct ctx ctx = {0};       // Program context
 
 public:
     Application() : window(nullptr)
     {
-        ctx.slip.buf = slipbuf;          // Set SLIP context - buffer
-        ctx.slip.size = sizeof(slipbuf); // Buffer size
+        com_stream = decoder.AddStream(
+            {END, true},
+            [](DecodePipeline::Batch &batch, void *app) { static_cast<Application *>(app)->DecodeBatch(batch); },
+            [](const DecodePipeline::Batch &batch, void *app) { static_cast<Application *>(app)->DeliverBatch(batch); },
+            this);
+        channels.AddSource("t"); // Порядок - как в строке RenderGraphs
+        channels.AddSource("mouse_y");
+        filter_settings.designs.resize(2);
+        filter.Configure(2, filter_settings.designs.data(), filter_settings.sample_rate, 1); // Без фильтров
 
         if (!glfwInit())
         {
@@ -227,14 +928,27 @@ public:
         glfwMakeContextCurrent(window);
         glfwSwapInterval(1);
 
+        // GL 3.3 функции для GPU отрисовки линий (ImGui использует свой загрузчик)
+        if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+        {
+            printf("Failed to load OpenGL functions, GPU lines disabled\n");
+        }
+
         IMGUI_CHECKVERSION();
+        allocator.Install(); // Пулы вместо malloc/free для ImGui и ImPlot
         ImGui::CreateContext();
         ImPlot::CreateContext();
 
         ImGuiIO &io = ImGui::GetIO();
-        (void)io;
         ImGui::StyleColorsDark();
 
+        // Готовый атлас шрифтов из кэша, пока шрифты, размеры и диапазоны не менялись
+        if (!ImFontAtlasBuildLoadCache(io.Fonts, "imgui_fonts.cache"))
+        {
+            io.Fonts->Build();
+            ImFontAtlasBuildSaveCache(io.Fonts, "imgui_fonts.cache");
+        }
+
         if (!ImGui_ImplGlfw_InitForOpenGL(window, true))
         {
             printf("Failed to initialize ImGui GLFW backend\n");
@@ -249,6 +963,7 @@ public:
 
     ~Application()
     {
+        gpu_line.Destroy();
         ImGui_ImplOpenGL3_Shutdown();
         ImGui_ImplGlfw_Shutdown();
         ImPlot::DestroyContext();
@@ -260,11 +975,202 @@ public:
         glfwTerminate();
     }
 
-    void slip_send(const void *buf, size_t len)
+    bool OpenPort(const SerialPortInfo &port, int baud)
+    {
+        // SLIP без проверки: END попеременно открывает и закрывает кадр, байты между кадрами - текст.
+        // С проверкой каждый END завершает кадр (RFC 1055), поэтому после сбоя поток выравнивается сам.
+        // COBS: каждый ноль завершает кадр
+        if (frame_encoding == ENCODING_COBS)
+            decoder.ResetStream(com_stream, {0, false});
+        else
+            decoder.ResetStream(com_stream, {END, frame_check == FrameCheck::Type_None});
+        port_check = frame_check;
+        port_encoding = frame_encoding;
+        port_timestamps = frame_timestamps;
+        device_clock.Reset();
+        rx_frames.good = rx_frames.crc_failed = rx_frames.overflowed = rx_frames.malformed = rx_frames.resynced = 0;
+        if (!COM.open(port.Path, baud, [this](const char *data, size_t len) { OnDataReceive(data, len); }))
+            return false;
+        openned_com_name = port.Name;
+        reconnect_serial = port.Serial;
+        reconnect_baud = baud;
+        return true;
+    }
+
+    // При сбросе USB устройство пропадает из списка и появляется снова, возможно под другим именем:
+    // порт закрывается и открывается заново по серийному номеру
+    void UpdatePorts()
+    {
+        if (ports.Generation() == ports_generation || reconnect_serial.empty())
+            return;
+        ports_generation = ports.Generation();
+        std::shared_ptr<const PortScanner::Snapshot> list = ports.Ports();
+        const SerialPortInfo *port = PortScanner::FindBySerial(*list, reconnect_serial);
+        if (COM.is_opened() && port == nullptr)
+        {
+            COM.close();
+            openned_com_name = "Reconnecting " + openned_com_name;
+        }
+        else if (!COM.is_opened() && port != nullptr)
+        {
+            OpenPort(*port, reconnect_baud);
+        }
+    }
+
+    // Вызывается из потока приёма COM-порта для каждого прочитанного блока. Здесь только поиск
+    // границ кадров, декодирование в пуле потоков decoder
+    void OnDataReceive(const char *data, size_t len)
+    {
+        decoder.Push(com_stream, data, len, LatencyTrace::Now()); // ReadFile только что вернул данные
+    }
+
+    // Поток пула: кадры пачки декодируются, проверяются и кладутся подряд в batch.Data
+    void DecodeBatch(DecodePipeline::Batch &batch)
+    {
+        const FrameCheck::Type check = port_check.load(std::memory_order_relaxed);
+        batch.Data.resize(batch.Raw.size()); // Декодированный кадр не длиннее исходного
+        if (port_encoding.load(std::memory_order_relaxed) == ENCODING_COBS)
+            DecodeCobs(batch, check);
+        else
+            DecodeSlip(batch, check);
+        const ImU64 decoded = LatencyTrace::Now();
+        for (size_t i = 0; i < batch.Frames.size(); i++)
+            latency.Record(LatencyTrace::Stage_Decode, batch.ReadTime, decoded);
+    }
+
+    // Кадр уже в batch.Data по смещению used: проверка контрольной суммы
+    static void AddFrame(DecodePipeline::Batch &batch, size_t &used, size_t len, FrameCheck::Type check)
+    {
+        if (FrameCheck::Verify(check, batch.Data.data() + used, &len))
+        {
+            batch.Frames.push_back({(ImU32)used, (ImU32)len, FRAME_GOOD});
+            used += len;
+        }
+        else
+        {
+            batch.Frames.push_back({(ImU32)used, 0, FRAME_CRC_FAILED});
+        }
+    }
+
+    // Тем же slip_recv, по байту
+    void DecodeSlip(DecodePipeline::Batch &batch, FrameCheck::Type check)
+    {
+        struct slip slip = {0};
+        // Пачка начинается сразу после END. Начало слишком длинного кадра отброшено - его хвост тоже
+        slip.mode = batch.Truncated || check != FrameCheck::Type_None;
+        slip.overflow = batch.Truncated;
+        slip.buf = batch.Data.data();
+        slip.size = ImMin(batch.Data.size(), max_frame);
+        size_t used = 0;
+        for (unsigned char c : batch.Raw)
+        {
+            const size_t overflows = slip.overflows;
+            size_t len = slip_recv(c, &slip);
+            if (slip.overflows != overflows)
+            {
+                batch.Frames.push_back({(ImU32)used, 0, FRAME_OVERFLOW});
+            }
+            else if (len > 0)
+            {
+                AddFrame(batch, used, len, check);
+                slip.buf = batch.Data.data() + used;
+                slip.size = ImMin(batch.Data.size() - used, max_frame);
+            }
+            if (c == END && check != FrameCheck::Type_None)
+                slip.mode = 1;
+        }
+    }
+
+    // Границы кадров - нули, поиск memchr, блоки копируются целиком
+    void DecodeCobs(DecodePipeline::Batch &batch, FrameCheck::Type check)
+    {
+        const unsigned char *p = batch.Raw.data();
+        const unsigned char *end = p + batch.Raw.size(); // Raw заканчивается нулём
+        bool truncated = batch.Truncated;                // Первый кадр - хвост отброшенного
+        size_t used = 0;
+        while (p < end)
+        {
+            const unsigned char *zero = (const unsigned char *)memchr(p, 0, end - p);
+            const size_t size = zero - p;
+            size_t len = 0;
+            if (truncated || size > max_frame)
+                batch.Frames.push_back({(ImU32)used, 0, FRAME_OVERFLOW});
+            else if (!Cobs::Decode(p, size, batch.Data.data() + used, &len))
+                batch.Frames.push_back({(ImU32)used, 0, FRAME_MALFORMED});
+            else if (size > 0) // Подряд идущие нули - пустые кадры
+                AddFrame(batch, used, len, check);
+            truncated = false;
+            p = zero + 1;
+        }
+    }
+
+    // Поток пула, пачки одного порта строго в порядке приёма
+    void DeliverBatch(const DecodePipeline::Batch &batch)
+    {
+        const bool timestamps = port_timestamps.load(std::memory_order_relaxed);
+        bool delivered = false;
+        for (const DecodePipeline::Frame &frame : batch.Frames)
+        {
+            if (frame.Status != FRAME_GOOD)
+            {
+                std::atomic<ImU64> &counter = frame.Status == FRAME_OVERFLOW    ? rx_frames.overflowed
+                                              : frame.Status == FRAME_MALFORMED ? rx_frames.malformed
+                                                                                : rx_frames.crc_failed;
+                counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                rx_bad = true;
+                continue;
+            }
+            rx_frames.good.store(rx_frames.good.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            if (rx_bad)
+            {
+                rx_frames.resynced.store(rx_frames.resynced.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                rx_bad = false;
+            }
+            // Время отсчёта: по часам устройства, иначе время чтения из порта
+            const unsigned char *data = batch.Data.data() + frame.Offset;
+            ImU64 time = batch.ReadTime;
+            if (timestamps && frame.Size >= 4)
+                time = device_clock.Update(data[0] | (data[1] << 8) | (data[2] << 16) | ((ImU32)data[3] << 24), batch.ReadTime);
+            packet_log.Add(data, frame.Size, std::chrono::steady_clock::time_point(std::chrono::nanoseconds(time)));
+            {
+                std::lock_guard<std::mutex> lock(rx_sizes_mutex);
+                rx_sizes.emplace_back(GraphTime(time), (float)frame.Size);
+            }
+            latency.Record(LatencyTrace::Stage_Enqueue, batch.ReadTime, LatencyTrace::Now());
+            delivered = true;
+        }
+        if (delivered)
+            latency.MarkPending(batch.ReadTime);
+    }
+
+    // Кадр в кодировке открытого порта, с контрольной суммой, если она включена
+    void SendFrame(const void *buf, size_t len)
+    {
+        const FrameCheck::Type check = port_check;
+        unsigned char trailer[4];
+        FrameCheck::Trailer(check, buf, len, trailer);
+        const size_t trailer_size = FrameCheck::TrailerSize(check);
+        if (port_encoding == ENCODING_COBS)
+        {
+            std::vector<unsigned char> frame((const unsigned char *)buf, (const unsigned char *)buf + len);
+            frame.insert(frame.end(), trailer, trailer + trailer_size);
+            std::vector<unsigned char> wire(Cobs::MaxEncodedSize(frame.size()) + 1);
+            size_t size = Cobs::Encode(frame.data(), frame.size(), wire.data());
+            wire[size++] = 0;
+            COM.Write(wire.data(), size);
+        }
+        else
+        {
+            COM.Write(END);
+            slip_send_escaped((const unsigned char *)buf, len);
+            slip_send_escaped(trailer, trailer_size);
+            COM.Write(END);
+        }
+    }
+
+    void slip_send_escaped(const unsigned char *p, size_t len)
     {
-        const unsigned char *p = (unsigned char *)buf;
         size_t i;
-        COM.Write(END);
         for (i = 0; i < len; i++)
         {
             if (p[i] == END)
@@ -282,7 +1188,6 @@ public:
                 COM.Write(p[i]);
             }
         }
-        COM.Write(END);
     }
 
     int run()
@@ -296,13 +1201,19 @@ public:
         bool is_red_background = false;
         float slider_value = 0.5f;   // Значение для слайдера
         bool checkbox_value = false; // Значение для чекбокса
+        latency.SetThreadName("UI");
+        ProfileZones::Get().SetThreadName("UI");
 
         while (!glfwWindowShouldClose(window))
         {
+            PROFILE_ZONE("Frame");
             glfwPollEvents();
+            UpdatePorts();
             ImGui_ImplOpenGL3_NewFrame();
             ImGui_ImplGlfw_NewFrame();
+            allocator.NewFrame();
             ImGui::NewFrame();
+            profiler.CheckCaptureKey();
 
             // Главное меню
             if (ImGui::BeginMainMenuBar())
@@ -313,6 +1224,14 @@ public:
                     {
                         printf("New file selected\n");
                     }
+                    if (ImGui::MenuItem("Publish channels", nullptr, &publish_channels))
+                    {
+                        publisher_feed = PublisherFeed();
+                        if (!publish_channels)
+                            publisher.Close();
+                        else if (!publisher.Open("sept_channels"))
+                            publish_channels = false;
+                    }
                     if (ImGui::MenuItem("Exit", "Ctrl+Q"))
                     {
                         glfwSetWindowShouldClose(window, true);
@@ -324,33 +1243,72 @@ public:
                 {
                     ImGui::MenuItem("Demo Window", nullptr, &show_demo_window);
                     ImGui::MenuItem("Red Background", nullptr, &is_red_background);
+                    ImGui::MenuItem("Packet log", nullptr, &ctx.verbose);
+                    ImGui::MenuItem("Latency", nullptr, &show_latency);
+                    ImGui::MenuItem("Profiler", "F9 capture", &show_profiler);
+                    ImGui::MenuItem("Clock sync", nullptr, &show_clock);
+                    ImGui::MenuItem("Channels", nullptr, &show_channels);
+                    ImGui::MenuItem("Filters", nullptr, &show_filters);
+                    ImGui::MenuItem("Export", nullptr, &show_export);
+                    ImGui::MenuItem("Import", nullptr, &show_import);
+                    ImGui::MenuItem("XY plot", nullptr, &show_xy);
+                    ImGui::Separator();
+                    // Вершины линий в пуле потоков. По умолчанию выключено: отложенный путь пишет геометрию
+                    // дважды и выигрывает только при свободных ядрах (bench/parallel_items_bench)
+                    if (ImGui::MenuItem("Parallel plot items", nullptr, &parallel_items, workers.threads() > 1))
+                    {
+                        ImPlot::SetParallelForFunc(parallel_items ? WorkerPool::ParallelForImPlot : nullptr, &workers);
+                    }
                     ImGui::EndMenu();
                 }
 
                 if (ImGui::BeginMenu(openned_com_name.c_str()))
                 {
-                    static std::vector<std::string> com_ports;
-
                     if (COM.is_opened())
                     {
                         if (ImGui::Button("Close"))
+                        {
                             COM.close();
+                            reconnect_serial.clear(); // Закрыт пользователем
+                        }
                     }
                     else
                     {
                         if (ImGui::Button("Update"))
-                            com_ports = COM.GetCOMPortsFromRegistry();
+                            ports.Rescan();
+                        ImGui::SameLine();
+                        ImGui::SetNextItemWidth(ImGui::GetFontSize() * 9);
+                        if (ImGui::BeginCombo("Frame check", FrameCheck::Name(frame_check)))
+                        {
+                            for (int i = 0; i < FrameCheck::Type_COUNT; i++)
+                            {
+                                if (ImGui::Selectable(FrameCheck::Name((FrameCheck::Type)i), frame_check == i))
+                                    frame_check = (FrameCheck::Type)i;
+                            }
+                            ImGui::EndCombo();
+                        }
+                        ImGui::SameLine();
+                        ImGui::SetNextItemWidth(ImGui::GetFontSize() * 6);
+                        ImGui::Combo("Encoding", &frame_encoding, "SLIP\0COBS\0");
+                        ImGui::SameLine();
+                        ImGui::Checkbox("Device timestamps", &frame_timestamps);
 
-                        if (com_ports.empty())
+                        std::shared_ptr<const PortScanner::Snapshot> com_ports = ports.Ports();
+                        if (com_ports->empty())
                         {
                             ImGui::Text("No com ports");
                         }
                         else
                         {
-                            for (const auto &port : com_ports)
+                            for (const SerialPortInfo &port : *com_ports)
                             {
-                                if (ImGui::CollapsingHeader(port.c_str()))
+                                std::string label = port.Name;
+                                if (!port.Description.empty())
+                                    label += " - " + port.Description;
+                                if (ImGui::CollapsingHeader(label.c_str()))
                                 {
+                                    if (port.Vid != 0)
+                                        ImGui::Text("USB %04X:%04X  S/N %s", port.Vid, port.Pid, port.Serial.empty() ? "-" : port.Serial.c_str());
                                     const char *items[] = {
                                         "9600",
                                         "115200",
@@ -359,10 +1317,7 @@ public:
 
                                     if (ImGui::Combo("combo", &item_current, items, IM_ARRAYSIZE(items)))
                                     {
-                                        if (COM.open("\\\\.\\" + port, atoi(items[item_current]), OnDataReceive))
-                                        {
-                                            openned_com_name = port;
-                                        }
+                                        OpenPort(port, atoi(items[item_current]));
                                     }
                                 }
                             }
@@ -376,7 +1331,7 @@ public:
                 {
                     if (ImGui::Button("send"))
                     {
-                        slip_send("AB\0x25", 3);
+                        SendFrame("AB\0x25", 3);
                     }
 
                     ImGui::EndMenu();
@@ -384,10 +1339,64 @@ public:
                 ImGui::EndMainMenuBar();
             }
 
-            RenderBottomMenu();
-            RenderGraphs();
+            RenderBottomMenu(allocator, decoder.GetStats(), rx_frames);
+            RenderGraphs(gpu_line, filter, channels, channel_stats);
+            {
+                std::lock_guard<std::mutex> lock(rx_sizes_mutex);
+                rx_sizes_ui.swap(rx_sizes);
+            }
+            UpdateAligner(channels, aligner, aligner_feed, rx_sizes_ui, GraphTime(LatencyTrace::Now()));
+            rx_sizes_ui.clear();
+            if (publish_channels)
+                UpdatePublisher(channels, publisher, publisher_feed);
             // Установка начальной позиции (опционально)
 
+            // Журнал принятых SLIP кадров (hexdump)
+            if (ctx.verbose)
+            {
+                packet_log.Draw("Packet log", &ctx.verbose);
+            }
+
+            if (show_latency)
+            {
+                latency.Draw("Latency", &show_latency);
+            }
+
+            if (show_profiler)
+            {
+                profiler.Draw("Profiler", &show_profiler);
+            }
+
+            if (show_clock)
+            {
+                device_clock.Draw("Clock sync", &show_clock);
+            }
+
+            if (show_channels)
+            {
+                channels.Draw("Channels", &show_channels);
+            }
+
+            if (show_filters)
+            {
+                RenderFilters(channels, filter_settings, filter, &show_filters);
+            }
+
+            if (show_export)
+            {
+                RenderExport(channels, export_settings, exporter, &show_export);
+            }
+
+            if (show_import)
+            {
+                RenderImport(file_import, import_settings, &show_import);
+            }
+
+            if (show_xy)
+            {
+                RenderAlignment(aligner, &show_xy);
+            }
+
             // Отображение демо-окна, если выбрано
             if (show_demo_window)
             {
@@ -396,6 +1405,11 @@ public:
 
             // Рендеринг
             ImGui::Render();
+            const ImU64 frame_read_time = latency.TakePending(); // Самый старый кадр, впервые попавший на экран
+            if (frame_read_time != 0)
+            {
+                latency.Record(LatencyTrace::Stage_Submit, frame_read_time, LatencyTrace::Now());
+            }
             int display_w, display_h;
             glfwGetFramebufferSize(window, &display_w, &display_h);
             glViewport(0, 0, display_w, display_h);
@@ -411,7 +1425,14 @@ public:
             glClear(GL_COLOR_BUFFER_BIT);
             ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 
-            glfwSwapBuffers(window);
+            {
+                PROFILE_ZONE("glfwSwapBuffers");
+                glfwSwapBuffers(window);
+            }
+            if (frame_read_time != 0)
+            {
+                latency.Record(LatencyTrace::Stage_Present, frame_read_time, LatencyTrace::Now());
+            }
         }
 
         return 0;
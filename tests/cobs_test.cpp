@@ -0,0 +1,134 @@
+// Cobs против эталонного кодека Cheshire и Baker (StuffData/UnStuffData из статьи, 1999)
+#include <Cobs.h>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+static int failures = 0;
+
+#define CHECK(cond, ...)                       \
+    do                                         \
+    {                                          \
+        if (!(cond))                           \
+        {                                      \
+            printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+            printf(__VA_ARGS__);               \
+            printf("\n");                      \
+            failures++;                        \
+        }                                      \
+    } while (0)
+
+// Эталон: блок закрывается на нуле и после 254 ненулевых байт, в конце всегда ещё один FinishBlock
+static std::vector<unsigned char> StuffData(const std::vector<unsigned char> &data)
+{
+    std::vector<unsigned char> dst(1);
+    size_t code_ptr = 0;
+    unsigned char code = 0x01;
+    for (unsigned char c : data)
+    {
+        if (c == 0)
+        {
+            dst[code_ptr] = code;
+            code_ptr = dst.size();
+            dst.push_back(0);
+            code = 0x01;
+        }
+        else
+        {
+            dst.push_back(c);
+            if (++code == 0xFF)
+            {
+                dst[code_ptr] = code;
+                code_ptr = dst.size();
+                dst.push_back(0);
+                code = 0x01;
+            }
+        }
+    }
+    dst[code_ptr] = code;
+    return dst;
+}
+
+static std::vector<unsigned char> UnStuffData(const std::vector<unsigned char> &src)
+{
+    std::vector<unsigned char> dst;
+    size_t i = 0;
+    while (i < src.size())
+    {
+        const int code = src[i++];
+        for (int k = 1; k < code && i < src.size(); k++)
+            dst.push_back(src[i++]);
+        if (code < 0xFF && i < src.size())
+            dst.push_back(0);
+    }
+    return dst;
+}
+
+static void Check(const std::vector<unsigned char> &payload, const char *what)
+{
+    const std::vector<unsigned char> reference = StuffData(payload);
+    std::vector<unsigned char> encoded(Cobs::MaxEncodedSize(payload.size()));
+    const size_t size = Cobs::Encode(payload.data(), payload.size(), encoded.data());
+    encoded.resize(size);
+    CHECK(size <= Cobs::MaxEncodedSize(payload.size()), "%s: %zu bytes over the bound", what, size);
+    CHECK(encoded == reference, "%s (%zu bytes): encoding differs from StuffData", what, payload.size());
+    CHECK(UnStuffData(encoded) == payload, "%s: UnStuffData does not restore the payload", what);
+
+    // Декодирование эталонной кодировки, в том числе на месте
+    std::vector<unsigned char> decoded(reference.size());
+    size_t decoded_size = 0;
+    const bool ok = Cobs::Decode(reference.data(), reference.size(), decoded.data(), &decoded_size);
+    decoded.resize(ok ? decoded_size : 0);
+    CHECK(ok && decoded == payload, "%s: Decode of the reference encoding", what);
+    std::vector<unsigned char> in_place = reference;
+    CHECK(Cobs::Decode(in_place.data(), in_place.size(), in_place.data(), &decoded_size) &&
+              std::vector<unsigned char>(in_place.begin(), in_place.begin() + decoded_size) == payload,
+          "%s: Decode in place", what);
+}
+
+int main()
+{
+    // Границы блоков: пусто, нули, серии ненулевых байт около кратных 254
+    Check({}, "empty");
+    Check({0}, "zero");
+    Check({0, 0, 0}, "zeros");
+    const size_t runs[] = {1, 253, 254, 255, 507, 508, 509, 762, 1016};
+    for (size_t n : runs)
+    {
+        char what[64];
+        std::vector<unsigned char> payload(n, 0x11);
+        snprintf(what, sizeof(what), "%zu non-zero", n);
+        Check(payload, what);
+        payload.push_back(0);
+        snprintf(what, sizeof(what), "%zu non-zero, zero", n);
+        Check(payload, what);
+        payload.insert(payload.begin(), 0);
+        snprintf(what, sizeof(what), "zero, %zu non-zero, zero", n);
+        Check(payload, what);
+    }
+
+    // Случайные кадры: разная длина и доля нулей
+    std::mt19937 rng(42);
+    for (int i = 0; i < 200000 && failures < 20; i++)
+    {
+        const size_t size = rng() % 1100;
+        const unsigned zero_per_mille = rng() % 4 == 0 ? 0 : rng() % 200;
+        std::vector<unsigned char> payload(size);
+        for (unsigned char &c : payload)
+            c = rng() % 1000 < zero_per_mille ? 0 : (unsigned char)(1 + rng() % 255);
+        Check(payload, "random");
+    }
+
+    // Ошибки: ноль внутри кадра, блок за концом кадра
+    const unsigned char zero_inside[] = {3, 1, 0};
+    const unsigned char past_end[] = {5, 1, 2};
+    unsigned char out[8];
+    size_t out_size;
+    CHECK(!Cobs::Decode(zero_inside, sizeof(zero_inside), out, &out_size), "zero inside a frame accepted");
+    CHECK(!Cobs::Decode(past_end, sizeof(past_end), out, &out_size), "block past the end accepted");
+
+    if (failures == 0)
+        printf("cobs: all checks passed\n");
+    return failures == 0 ? 0 : 1;
+}
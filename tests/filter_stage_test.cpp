@@ -0,0 +1,215 @@
+// FilterStage: частотные характеристики расчёта (-3 дБ Баттерворта, пульсации Чебышева, глубина режекции)
+// и Process() на месте для нескольких групп каналов с децимацией против скалярной прямой формы в double.
+#include <FilterStage.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+static int failures = 0;
+
+#define CHECK(cond, ...)                       \
+    do                                         \
+    {                                          \
+        if (!(cond))                           \
+        {                                      \
+            printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+            printf(__VA_ARGS__);               \
+            printf("\n");                      \
+            failures++;                        \
+        }                                      \
+    } while (0)
+
+static const double SampleRate = 1000.0;
+
+static double Db(const FilterStage::Design &design, double f)
+{
+    FilterStage::Biquad sections[FilterStage::MaxSections];
+    const int count = FilterStage::DesignBiquads(design, SampleRate, sections);
+    return 20.0 * log10(FilterStage::Response(sections, count, f, SampleRate));
+}
+
+static FilterStage::Design Make(FilterStage::Type kind, int order, double cutoff, double ripple_db = 1.0, double q = 10.0)
+{
+    FilterStage::Design design;
+    design.Kind = kind;
+    design.Order = order;
+    design.Cutoff = cutoff;
+    design.RippleDb = ripple_db;
+    design.Q = q;
+    return design;
+}
+
+static void CheckButterworth()
+{
+    for (int order = 1; order <= FilterStage::MaxOrder; order++)
+    {
+        for (double cutoff : {5.0, 50.0, 200.0})
+        {
+            const FilterStage::Design low = Make(FilterStage::Type_ButterworthLowPass, order, cutoff);
+            const FilterStage::Design high = Make(FilterStage::Type_ButterworthHighPass, order, cutoff);
+            CHECK(fabs(Db(low, cutoff) + 3.0103) < 0.01, "low-pass order %d at %g Hz: %.4f dB at the cutoff", order, cutoff, Db(low, cutoff));
+            CHECK(fabs(Db(high, cutoff) + 3.0103) < 0.01, "high-pass order %d at %g Hz: %.4f dB at the cutoff", order, cutoff, Db(high, cutoff));
+            CHECK(fabs(Db(low, 0.0)) < 1e-6, "low-pass order %d at %g Hz: %.6f dB at DC", order, cutoff, Db(low, 0.0));
+            CHECK(fabs(Db(high, SampleRate / 2)) < 1e-6, "high-pass order %d at %g Hz: %.6f dB at Nyquist", order, cutoff, Db(high, SampleRate / 2));
+            // Монотонно падает за частотой среза
+            CHECK(Db(low, cutoff * 1.5) < Db(low, cutoff * 1.2) && Db(low, cutoff * 1.2) < Db(low, cutoff),
+                  "low-pass order %d at %g Hz is not falling past the cutoff", order, cutoff);
+        }
+    }
+}
+
+// Тип I: в полосе пропускания между -ripple и 0 дБ, на частоте среза ровно -ripple
+static void CheckChebyshev()
+{
+    for (int order = 1; order <= FilterStage::MaxOrder; order++)
+    {
+        for (double ripple : {0.5, 1.0, 3.0})
+        {
+            const double cutoff = 50.0;
+            const FilterStage::Design low = Make(FilterStage::Type_ChebyshevLowPass, order, cutoff, ripple);
+            const FilterStage::Design high = Make(FilterStage::Type_ChebyshevHighPass, order, cutoff, ripple);
+            CHECK(fabs(Db(low, cutoff) + ripple) < 0.01, "low-pass order %d, %g dB: %.4f dB at the cutoff", order, ripple, Db(low, cutoff));
+            CHECK(fabs(Db(high, cutoff) + ripple) < 0.01, "high-pass order %d, %g dB: %.4f dB at the cutoff", order, ripple, Db(high, cutoff));
+            double low_min = 0, low_max = -1e9, high_min = 0, high_max = -1e9;
+            for (int i = 0; i <= 1000; i++)
+            {
+                const double f = cutoff * i / 1000.0; // полоса пропускания низких частот
+                low_min = fmin(low_min, Db(low, f)), low_max = fmax(low_max, Db(low, f));
+                const double g = cutoff + (SampleRate / 2 - cutoff) * i / 1000.0;
+                high_min = fmin(high_min, Db(high, g)), high_max = fmax(high_max, Db(high, g));
+            }
+            CHECK(low_max < 1e-6 && low_max > -0.01 && low_min > -ripple - 0.01,
+                  "low-pass order %d, %g dB: pass band from %.4f to %.4f dB", order, ripple, low_min, low_max);
+            CHECK(high_max < 1e-6 && high_max > -0.01 && high_min > -ripple - 0.01,
+                  "high-pass order %d, %g dB: pass band from %.4f to %.4f dB", order, ripple, high_min, high_max);
+        }
+    }
+}
+
+static void CheckNotch()
+{
+    for (double centre : {50.0, 60.0, 123.0})
+    {
+        for (double q : {2.0, 10.0, 30.0})
+        {
+            const FilterStage::Design notch = Make(FilterStage::Type_Notch, 2, centre, 1.0, q);
+            CHECK(Db(notch, centre) < -100.0, "notch %g Hz, Q %g: %.1f dB at the centre", centre, q, Db(notch, centre));
+            // Ширина по -3 дБ - centre / Q; при малой добротности края сдвинуты билинейным преобразованием
+            const double edge = centre / q / 2;
+            CHECK(q < 10 || (fabs(Db(notch, centre - edge) + 3.0) < 0.5 && fabs(Db(notch, centre + edge) + 3.0) < 0.5),
+                  "notch %g Hz, Q %g: %.2f and %.2f dB at the band edges", centre, q, Db(notch, centre - edge), Db(notch, centre + edge));
+            CHECK(fabs(Db(notch, 0.0)) < 1e-6 && fabs(Db(notch, SampleRate / 2)) < 1e-6,
+                  "notch %g Hz, Q %g: not flat away from the centre", centre, q);
+        }
+    }
+}
+
+// Прямая форма I в double для одного канала, затем КИХ по тем же коэффициентам
+static std::vector<double> Reference(const std::vector<double> &x, const FilterStage::Design &design, int decimation)
+{
+    FilterStage::Biquad sections[FilterStage::MaxSections];
+    const int count = FilterStage::DesignBiquads(design, SampleRate, sections);
+    std::vector<double> y = x;
+    for (int s = 0; s < count; s++)
+    {
+        const FilterStage::Biquad &c = sections[s];
+        double x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+        for (double &v : y)
+        {
+            const double out = c.B0 * v + c.B1 * x1 + c.B2 * x2 - c.A1 * y1 - c.A2 * y2;
+            x2 = x1, x1 = v, y2 = y1, y1 = out;
+            v = out;
+        }
+    }
+    if (decimation == 1)
+        return y;
+    std::vector<float> h;
+    FilterStage::DesignDecimator(decimation, 8 * decimation + 1, &h);
+    std::vector<double> out;
+    for (size_t row = decimation - 1; row < y.size(); row += decimation)
+    {
+        double acc = 0;
+        for (size_t k = 0; k < h.size() && k <= row; k++)
+            acc += h[k] * y[row - k];
+        out.push_back(acc);
+    }
+    return out;
+}
+
+static void CheckProcess(int decimation)
+{
+    // 7 каналов: полная группа и неполная, разные фильтры и каналы без фильтра
+    const int channels = 7, rows = 4000;
+    const FilterStage::Design designs[channels] = {
+        Make(FilterStage::Type_ButterworthLowPass, 4, 40.0),
+        Make(FilterStage::Type_None, 2, 0.0),
+        Make(FilterStage::Type_ChebyshevHighPass, 5, 20.0, 0.5),
+        Make(FilterStage::Type_Notch, 2, 50.0, 1.0, 5.0),
+        Make(FilterStage::Type_ChebyshevLowPass, 6, 100.0, 1.0),
+        Make(FilterStage::Type_ButterworthHighPass, 3, 5.0),
+        Make(FilterStage::Type_None, 2, 0.0),
+    };
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> noise(-1.0, 1.0);
+    std::vector<std::vector<double>> x(channels, std::vector<double>(rows));
+    std::vector<float> data(rows * channels);
+    for (int r = 0; r < rows; r++)
+        for (int c = 0; c < channels; c++)
+        {
+            x[c][r] = (float)(sin(2 * IM_PI * (c + 1) * 7.0 * r / SampleRate) + 0.3 * noise(rng));
+            data[r * channels + c] = (float)x[c][r];
+        }
+
+    FilterStage filter;
+    filter.Configure(channels, designs, SampleRate, decimation);
+    CHECK(filter.Decimation() == decimation, "Decimation() %d instead of %d", filter.Decimation(), decimation);
+
+    // Порции разной длины, на месте: выход пишется в начало той же порции
+    std::vector<float> out;
+    for (int row = 0; row < rows;)
+    {
+        const int n = std::min(rows - row, 1 + (int)(rng() % 97));
+        float *block = data.data() + row * channels;
+        const int written = filter.Process(block, n, block);
+        CHECK(written <= n / decimation + 1, "%d rows out of %d in", written, n);
+        out.insert(out.end(), block, block + written * channels);
+        row += n;
+    }
+    const size_t out_rows = out.size() / channels;
+    CHECK(out_rows == (size_t)(rows / decimation), "decimation %d: %zu rows out of %d", decimation, out_rows, rows);
+
+    for (int c = 0; c < channels; c++)
+    {
+        const std::vector<double> reference = Reference(x[c], designs[c], decimation);
+        double max_error = 0;
+        for (size_t r = 0; r < out_rows && r < reference.size(); r++)
+            max_error = fmax(max_error, fabs(out[r * channels + c] - reference[r]));
+        CHECK(max_error < 1e-4, "decimation %d, channel %d (%s): max error %g", decimation, c,
+              FilterStage::TypeName(designs[c].Kind), max_error);
+    }
+
+    // Reset() возвращает к нулевому состоянию: тот же вход - тот же выход
+    filter.Reset();
+    std::vector<float> again(x.size() * rows);
+    for (int r = 0; r < rows; r++)
+        for (int c = 0; c < channels; c++)
+            again[r * channels + c] = (float)x[c][r];
+    const int written = filter.Process(again.data(), rows, again.data());
+    again.resize(written * channels);
+    CHECK(again == out, "decimation %d: output after Reset() differs", decimation);
+}
+
+int main()
+{
+    CheckButterworth();
+    CheckChebyshev();
+    CheckNotch();
+    for (int decimation : {1, 2, 3, 8})
+        CheckProcess(decimation);
+
+    if (failures == 0)
+        printf("filter_stage: all checks passed\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,258 @@
+// ImGuiFlatStorage ведёт себя как ImGuiStorage: значения по умолчанию Get*/Set*/Get*Ref, случайные
+// последовательности операций, "удаление" ImPool (значение -1) и повторное использование, Clear(),
+// Rehash() и BuildSortByKey() после правки Data напрямую.
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+static int failures = 0;
+
+#define CHECK(cond, ...)                       \
+    do                                         \
+    {                                          \
+        if (!(cond))                           \
+        {                                      \
+            printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+            printf(__VA_ARGS__);               \
+            printf("\n");                      \
+            failures++;                        \
+        }                                      \
+    } while (0)
+
+static bool PairLess(const ImGuiStoragePair &a, const ImGuiStoragePair &b)
+{
+    return a.key < b.key;
+}
+
+// Те же пары (ключ и val_i), порядок не важен
+static bool SameContents(const ImGuiStorage &sorted, const ImGuiFlatStorage &flat)
+{
+    if (sorted.Data.Size != flat.Data.Size)
+        return false;
+    std::vector<ImGuiStoragePair> pairs(flat.Data.begin(), flat.Data.end());
+    std::sort(pairs.begin(), pairs.end(), PairLess);
+    for (int i = 0; i < sorted.Data.Size; i++)
+        if (pairs[i].key != sorted.Data[i].key || pairs[i].val_i != sorted.Data[i].val_i)
+            return false;
+    return true;
+}
+
+static void CheckDefaults()
+{
+    ImGuiStorage sorted;
+    ImGuiFlatStorage flat;
+    for (int pass = 0; pass < 2; pass++)
+    {
+        CHECK(sorted.GetInt(1) == 0 && flat.GetInt(1) == 0, "GetInt of a missing key");
+        CHECK(sorted.GetInt(1, 7) == 7 && flat.GetInt(1, 7) == 7, "GetInt default");
+        CHECK(!sorted.GetBool(2) && !flat.GetBool(2) && sorted.GetBool(2, true) && flat.GetBool(2, true), "GetBool default");
+        CHECK(sorted.GetFloat(3, 1.5f) == 1.5f && flat.GetFloat(3, 1.5f) == 1.5f, "GetFloat default");
+        CHECK(sorted.GetVoidPtr(4) == NULL && flat.GetVoidPtr(4) == NULL, "GetVoidPtr of a missing key");
+        CHECK(sorted.Data.Size == 0 && flat.Data.Size == 0, "Get* added a key");
+        sorted.Clear();
+        flat.Clear(); // второй проход - после Clear() непустого индекса
+        flat.SetInt(100, 1);
+        flat.Clear();
+    }
+
+    // Get*Ref добавляет ключ со значением по умолчанию, повторный вызов его не меняет
+    CHECK(*sorted.GetIntRef(10, 5) == 5 && *flat.GetIntRef(10, 5) == 5, "GetIntRef default");
+    CHECK(*sorted.GetIntRef(10, 6) == 5 && *flat.GetIntRef(10, 6) == 5, "GetIntRef of a present key");
+    CHECK(*sorted.GetVoidPtrRef(11) == NULL && *flat.GetVoidPtrRef(11) == NULL, "GetVoidPtrRef default");
+    int object;
+    CHECK(*sorted.GetVoidPtrRef(12, &object) == &object && *flat.GetVoidPtrRef(12, &object) == &object, "GetVoidPtrRef with a default");
+    *flat.GetVoidPtrRef(11) = &object;
+    *sorted.GetVoidPtrRef(11) = &object;
+    CHECK(flat.GetVoidPtr(11) == &object, "GetVoidPtrRef does not write through");
+    CHECK(*sorted.GetFloatRef(13, 2.5f) == 2.5f && *flat.GetFloatRef(13, 2.5f) == 2.5f, "GetFloatRef default");
+    CHECK(*sorted.GetBoolRef(14, true) && *flat.GetBoolRef(14, true), "GetBoolRef default");
+    CHECK(SameContents(sorted, flat), "contents differ after Get*Ref");
+
+    sorted.SetAllInt(9);
+    flat.SetAllInt(9);
+    CHECK(flat.GetInt(10) == 9 && flat.GetInt(14) == 9 && SameContents(sorted, flat), "SetAllInt");
+}
+
+// Ключи: случайные, подряд идущие, кратные 2^16 (одинаковые младшие биты) и ImHashStr меток
+static std::vector<ImGuiID> MakeKeys(int count, std::mt19937 &rng)
+{
+    std::vector<ImGuiID> keys;
+    for (int i = 0; i < count; i++)
+    {
+        switch (i % 4)
+        {
+        case 0:
+            keys.push_back((ImGuiID)rng());
+            break;
+        case 1:
+            keys.push_back((ImGuiID)i);
+            break;
+        case 2:
+            keys.push_back((ImGuiID)i << 16);
+            break;
+        default:
+        {
+            char label[32];
+            snprintf(label, sizeof(label), "item%d", i);
+            keys.push_back(ImHashStr(label));
+        }
+        }
+    }
+    return keys;
+}
+
+// У каждого ключа один тип значения: после SetInt() старшие байты val_p не определены в обоих хранилищах
+static void CheckRandomOperations()
+{
+    std::mt19937 rng(34);
+    int targets[64];
+    for (int round = 0; round < 20 && failures < 20; round++)
+    {
+        const std::vector<ImGuiID> keys = MakeKeys(round < 10 ? 64 : 5000, rng);
+        ImGuiStorage sorted;
+        ImGuiFlatStorage flat;
+        for (int op = 0; op < 50000; op++)
+        {
+            const size_t k = rng() % keys.size();
+            const ImGuiID key = keys[k];
+            const int value = (int)(rng() % 1000) - 500;
+            void *target = &targets[value & 63];
+            const int action = rng() % 4;
+            // Явная перестройка индекса на любой размер, в том числе меньше нужного
+            if (rng() % 1000 == 0)
+                flat.Rehash((int)(rng() % 4) * 16);
+            if (k % 3 == 0)
+            {
+                if (action == 0)
+                    sorted.SetInt(key, value), flat.SetInt(key, value);
+                else if (action == 1)
+                    sorted.SetBool(key, value > 0), flat.SetBool(key, value > 0);
+                else if (action == 2)
+                    CHECK(*sorted.GetIntRef(key, value) == *flat.GetIntRef(key, value), "GetIntRef of %08X", key);
+                else
+                    CHECK(sorted.GetInt(key, value) == flat.GetInt(key, value) && sorted.GetBool(key) == flat.GetBool(key), "GetInt of %08X", key);
+            }
+            else if (k % 3 == 1)
+            {
+                if (action < 2)
+                    sorted.SetFloat(key, value * 0.5f), flat.SetFloat(key, value * 0.5f);
+                else if (action == 2)
+                    CHECK(*sorted.GetFloatRef(key, value * 0.25f) == *flat.GetFloatRef(key, value * 0.25f), "GetFloatRef of %08X", key);
+                else
+                    CHECK(sorted.GetFloat(key, -1.0f) == flat.GetFloat(key, -1.0f), "GetFloat of %08X", key);
+            }
+            else
+            {
+                if (action < 2)
+                    sorted.SetVoidPtr(key, target), flat.SetVoidPtr(key, target);
+                else if (action == 2)
+                    CHECK(*sorted.GetVoidPtrRef(key) == *flat.GetVoidPtrRef(key), "GetVoidPtrRef of %08X", key);
+                else
+                    CHECK(sorted.GetVoidPtr(key) == flat.GetVoidPtr(key), "GetVoidPtr of %08X", key);
+            }
+        }
+        CHECK(SameContents(sorted, flat), "round %d: contents differ", round);
+        CHECK(flat.Slots.Size >= flat.Data.Size * 2, "round %d: index of %d slots over %d pairs", round, flat.Slots.Size, flat.Data.Size);
+        for (size_t k = 0; k < keys.size(); k++)
+        {
+            CHECK(sorted.GetInt(keys[k], 12345) == flat.GetInt(keys[k], 12345), "round %d: GetInt of %08X", round, keys[k]);
+            if (k % 3 == 2)
+                CHECK(sorted.GetVoidPtr(keys[k]) == flat.GetVoidPtr(keys[k]), "round %d: GetVoidPtr of %08X", round, keys[k]);
+        }
+    }
+}
+
+// Data правится напрямую, как это делает ImGuiSelectionBasicStorage, затем BuildSortByKey()
+static void CheckBuildSortByKey()
+{
+    ImGuiStorage sorted;
+    ImGuiFlatStorage flat;
+    for (int i = 0; i < 1000; i++)
+    {
+        sorted.Data.push_back(ImGuiStoragePair((ImGuiID)(i * 7919), i));
+        flat.Data.push_back(ImGuiStoragePair((ImGuiID)(i * 7919), i));
+    }
+    sorted.BuildSortByKey();
+    flat.BuildSortByKey();
+    CHECK(SameContents(sorted, flat), "contents differ after filling Data");
+    for (int i = 0; i < 1000; i++)
+        CHECK(flat.GetInt((ImGuiID)(i * 7919), -1) == i, "key %d not found after BuildSortByKey", i * 7919);
+
+    // Ключи переписаны, половина пар убрана с конца
+    for (int i = 0; i < 1000; i++)
+        sorted.Data[i].key += 1, flat.Data[i].key += 1;
+    sorted.Data.resize(500);
+    flat.Data.resize(500);
+    sorted.BuildSortByKey();
+    flat.BuildSortByKey();
+    CHECK(SameContents(sorted, flat), "contents differ after rewriting keys");
+    for (int i = 0; i < 1000; i++)
+        CHECK(sorted.GetInt((ImGuiID)(i * 7919 + 1), -1) == flat.GetInt((ImGuiID)(i * 7919 + 1), -1), "rewritten key %d", i);
+    CHECK(flat.GetInt(0, -1) == -1, "a removed key is still found");
+}
+
+// ImPool не удаляет ключи из карты: Remove() пишет -1, GetOrAddByKey() заново занимает ключ
+struct Item
+{
+    int Value = 42;
+};
+
+static void CheckPoolRemove()
+{
+    ImPool<Item> pool;
+    std::mt19937 rng(35);
+    const std::vector<ImGuiID> keys = MakeKeys(2000, rng);
+    std::vector<bool> alive(keys.size());
+    for (int op = 0; op < 100000 && failures < 20; op++)
+    {
+        const size_t k = rng() % keys.size();
+        Item *item = pool.GetByKey(keys[k]);
+        CHECK((item != NULL) == alive[k], "key %08X: alive %d, found %d", keys[k], (int)alive[k], item != NULL);
+        if (rng() % 3 == 0 && alive[k])
+        {
+            pool.Remove(keys[k], item);
+            alive[k] = false;
+        }
+        else if (!alive[k])
+        {
+            item = pool.GetOrAddByKey(keys[k]);
+            CHECK(item->Value == 42, "a reused slot is not constructed");
+            item->Value = (int)k;
+            alive[k] = true;
+        }
+        else
+        {
+            CHECK(item->Value == (int)k, "key %08X maps to the item of another key", keys[k]);
+        }
+        if (op == 50000)
+        {
+            pool.Clear();
+            std::fill(alive.begin(), alive.end(), false);
+        }
+    }
+    int count = 0, visited = 0;
+    for (size_t k = 0; k < keys.size(); k++)
+        count += alive[k];
+    for (int n = 0; n < pool.GetMapSize(); n++)
+        if (Item *item = pool.TryGetMapData(n))
+        {
+            CHECK(alive[item->Value] && pool.GetByKey(keys[item->Value]) == item, "iteration visits a dead item");
+            visited++;
+        }
+    CHECK(pool.GetAliveCount() == count && visited == count, "%d alive, %d counted, %d visited", count, pool.GetAliveCount(), visited);
+}
+
+int main()
+{
+    CheckDefaults();
+    CheckRandomOperations();
+    CheckBuildSortByKey();
+    CheckPoolRemove();
+
+    if (failures == 0)
+        printf("flat_storage: all checks passed\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,198 @@
+// ImHashData/ImHashStr: контрольные значения CRC-32C, смысл "###" и совпадение с прежним побайтовым
+// расчётом, коллизии на сгенерированных строках ID. Собирается дважды: с выбором crc32 по CPUID
+// и только с таблицами (IMGUI_DISABLE_CRC32_DISPATCH).
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+static int failures = 0;
+
+#define CHECK(cond, ...)                       \
+    do                                         \
+    {                                          \
+        if (!(cond))                           \
+        {                                      \
+            printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+            printf(__VA_ARGS__);               \
+            printf("\n");                      \
+            failures++;                        \
+        }                                      \
+    } while (0)
+
+// Прежняя реализация Dear ImGui 1.91.7, по байту и побитно вместо таблицы
+static ImU32 ReferenceStep(ImU32 crc, unsigned char c)
+{
+    crc ^= c;
+    for (int b = 0; b < 8; b++)
+        crc = crc & 1 ? (crc >> 1) ^ 0x82F63B78 : crc >> 1;
+    return crc;
+}
+
+static ImGuiID ReferenceHashData(const void *data_p, size_t data_size, ImGuiID seed)
+{
+    ImU32 crc = ~seed;
+    const unsigned char *data = (const unsigned char *)data_p;
+    while (data_size-- != 0)
+        crc = ReferenceStep(crc, *data++);
+    return ~crc;
+}
+
+static ImGuiID ReferenceHashStr(const char *data_p, size_t data_size, ImGuiID seed)
+{
+    seed = ~seed;
+    ImU32 crc = seed;
+    const unsigned char *data = (const unsigned char *)data_p;
+    if (data_size != 0)
+    {
+        while (data_size-- != 0)
+        {
+            unsigned char c = *data++;
+            if (c == '#' && data_size >= 2 && data[0] == '#' && data[1] == '#')
+                crc = seed;
+            crc = ReferenceStep(crc, c);
+        }
+    }
+    else
+    {
+        while (unsigned char c = *data++)
+        {
+            if (c == '#' && data[0] == '#' && data[1] == '#')
+                crc = seed;
+            crc = ReferenceStep(crc, c);
+        }
+    }
+    return ~crc;
+}
+
+static ImGuiID Str(const char *s, ImGuiID seed = 0)
+{
+    return ImHashStr(s, 0, seed);
+}
+
+// Значения из RFC 3720, B.4, и "123456789" из каталога CRC
+static void CheckKnownValues()
+{
+    unsigned char zeros[32], ones[32], up[32], down[32];
+    for (int i = 0; i < 32; i++)
+        zeros[i] = 0, ones[i] = 0xFF, up[i] = (unsigned char)i, down[i] = (unsigned char)(31 - i);
+    CHECK(ImHashData("123456789", 9, 0) == 0xE3069283, "\"123456789\": %08X", ImHashData("123456789", 9, 0));
+    CHECK(ImHashData(zeros, 32, 0) == 0x8A9136AA, "32 zero bytes: %08X", ImHashData(zeros, 32, 0));
+    CHECK(ImHashData(ones, 32, 0) == 0x62A8AB43, "32 0xFF bytes: %08X", ImHashData(ones, 32, 0));
+    CHECK(ImHashData(up, 32, 0) == 0x46DD794E, "0..31: %08X", ImHashData(up, 32, 0));
+    CHECK(ImHashData(down, 32, 0) == 0x113FDB5C, "31..0: %08X", ImHashData(down, 32, 0));
+    CHECK(ImHashData("", 0, 0) == 0, "empty: %08X", ImHashData("", 0, 0));
+    CHECK(ImHashStr("123456789", 9, 0) == 0xE3069283 && Str("123456789") == 0xE3069283, "ImHashStr(\"123456789\")");
+    // Затравка - продолжение: хеш от конкатенации
+    CHECK(ImHashData("56789", 5, ImHashData("1234", 4, 0)) == 0xE3069283, "seed does not continue the CRC");
+}
+
+static void CheckSharpSharpSharp()
+{
+    CHECK(Str("label###id") == Str("###id"), "label###id != ###id");
+    CHECK(Str("other label###id") == Str("label###id"), "the label before ### changes the ID");
+    CHECK(Str("a###b###c") == Str("###c"), "only the last ### counts");
+    CHECK(Str("x#####id") == Str("###id"), "##### resets at its last ###");
+    CHECK(Str("a##x") != Str("b##x"), "## resets the hash");
+    CHECK(Str("###id", 5) != Str("###id", 6), "### drops the seed");
+    CHECK(Str("label###id", 77) == Str("###id", 77), "label###id with a seed");
+    CHECK(ImHashStr("ab###", 5, 0) == ImHashStr("###", 3, 0), "### at the end of a known size");
+    CHECK(ImHashStr("ab##", 4, 0) == ImHashData("ab##", 4, 0), "## at the end of a known size is not a reset");
+    CHECK(ImHashStr("ab##c###", 4, 0) == ImHashData("ab##", 4, 0), "### past a known size is seen");
+    CHECK(ImHashStr("label###id", 0, 0) == ImHashStr("label###id", 10, 0), "known and zero-terminated sizes differ");
+
+    // ### на каждом смещении длинной метки: блоки по 8 и 4 байта не пропускают его
+    for (int prefix = 0; prefix < 40; prefix++)
+        for (int suffix = 0; suffix < 20; suffix++)
+        {
+            const std::string id = "###" + std::string(suffix, 'i');
+            const std::string label = std::string(prefix, 'L') + id;
+            CHECK(Str(label.c_str(), 3) == Str(id.c_str(), 3), "%d label bytes before %s", prefix, id.c_str());
+            CHECK(ImHashStr(label.c_str(), label.size(), 3) == ImHashStr(id.c_str(), id.size(), 3),
+                  "%d label bytes before %s, known size", prefix, id.c_str());
+        }
+}
+
+// Случайные строки с 20% '#' на разных выравниваниях, обе формы размера, разные затравки
+static void CheckAgainstReference()
+{
+    std::mt19937 rng(33);
+    std::vector<char> buffer(256 + 16);
+    for (int i = 0; i < 200000 && failures < 20; i++)
+    {
+        const size_t offset = rng() % 16, size = rng() % 200;
+        char *s = buffer.data() + offset;
+        for (size_t k = 0; k < size; k++)
+            s[k] = rng() % 5 == 0 ? '#' : (char)(1 + rng() % 255);
+        s[size] = 0;
+        const ImGuiID seed = rng() % 4 == 0 ? 0 : (ImGuiID)rng();
+        CHECK(ImHashData(s, size, seed) == ReferenceHashData(s, size, seed), "ImHashData, %zu bytes at +%zu", size, offset);
+        CHECK(size == 0 || ImHashStr(s, size, seed) == ReferenceHashStr(s, size, seed), "ImHashStr, %zu bytes at +%zu", size, offset);
+        CHECK(ImHashStr(s, 0, seed) == ReferenceHashStr(s, 0, seed), "ImHashStr, zero-terminated %zu bytes at +%zu", size, offset);
+    }
+}
+
+// Пары одинаковых ID среди `ids`
+static size_t Collisions(std::vector<ImGuiID> ids)
+{
+    std::sort(ids.begin(), ids.end());
+    size_t pairs = 0;
+    for (size_t i = 1; i < ids.size(); i++)
+        pairs += ids[i] == ids[i - 1];
+    return pairs;
+}
+
+// ID, какие строит приложение: каналы, графики, строки таблиц, PushID(int) и PushID(ptr)
+static void CheckCollisions()
+{
+    std::vector<ImGuiID> ids;
+    const ImGuiID window = Str("Graphs");
+    char label[64];
+    for (int i = 0; i < 200000; i++)
+    {
+        snprintf(label, sizeof(label), "ch%d", i);
+        ids.push_back(ImHashStr(label, 0, window));
+        snprintf(label, sizeof(label), "Plot %d##plot%d", i % 16, i);
+        ids.push_back(ImHashStr(label, 0, window));
+        snprintf(label, sizeof(label), "##row%d_%d", i / 64, i % 64);
+        ids.push_back(ImHashStr(label, 0, window));
+        snprintf(label, sizeof(label), "value %d###channel%d", i * 7, i);
+        ids.push_back(ImHashStr(label, 0, window));
+    }
+    // Для 32-битного равномерного хеша ожидается n^2 / 2^33 пар
+    const double expected = (double)ids.size() * ids.size() / 8589934592.0;
+    const size_t labels = Collisions(ids);
+    printf("%zu labels: %zu colliding pairs, %.1f expected of a uniform hash\n", ids.size(), labels, expected);
+    CHECK(labels <= expected * 2 + 10, "%zu colliding pairs among %zu labels", labels, ids.size());
+
+    // Четыре байта под одной затравкой - CRC взаимно однозначен; указатели различаются в младших
+    // 26 битах, а CRC-32 различает любые отличия в пределах 32 бит подряд: ни одной коллизии
+    std::vector<ImGuiID> ints;
+    for (int i = 0; i < 1000000; i++)
+        ints.push_back(ImHashData(&i, sizeof(i), window));
+    CHECK(Collisions(ints) == 0, "%zu colliding pairs among PushID(int)", Collisions(ints));
+    std::vector<ImGuiID> pointers;
+    for (size_t i = 0; i < 1000000; i++)
+    {
+        const void *p = (const char *)(uintptr_t)0x7f0000001000ULL + i * 48;
+        pointers.push_back(ImHashData(&p, sizeof(p), window));
+    }
+    CHECK(Collisions(pointers) == 0, "%zu colliding pairs among PushID(ptr)", Collisions(pointers));
+}
+
+int main()
+{
+    CheckKnownValues();
+    CheckSharpSharpSharp();
+    CheckAgainstReference();
+    CheckCollisions();
+
+    if (failures == 0)
+        printf("hash: all checks passed\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,160 @@
+// PortScanner и ComPort: снимок списка портов (отсортирован, пути заполнены, поиск по пути и серийному
+// номеру), Rescan() без смены списка не меняет поколение. Под POSIX - ComPort через псевдотерминал:
+// приём пачками, запись, повторное открытие, закрытие при исчезнувшем устройстве.
+// На Windows собирается и запускается ветка реестра PortScanner и ComPort на OVERLAPPED.
+#include <ComPort.h>
+#include <PortScanner.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#ifndef _WIN32
+#include <stdlib.h>
+#endif
+
+static int failures = 0;
+
+#define CHECK(cond, ...)                       \
+    do                                         \
+    {                                          \
+        if (!(cond))                           \
+        {                                      \
+            printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+            printf(__VA_ARGS__);               \
+            printf("\n");                      \
+            failures++;                        \
+        }                                      \
+    } while (0)
+
+template <typename F>
+static bool WaitFor(F done, int ms = 2000)
+{
+    const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(ms);
+    while (!done())
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+            return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return true;
+}
+
+static void CheckScanner()
+{
+    const PortScanner::Snapshot ports = PortScanner::Scan();
+    printf("%zu serial ports\n", ports.size());
+    for (size_t i = 0; i < ports.size(); i++)
+    {
+        const SerialPortInfo &port = ports[i];
+        printf("  %s %s [%s] %04X:%04X %s\n", port.Name.c_str(), port.Path.c_str(), port.Description.c_str(), port.Vid, port.Pid,
+               port.Serial.c_str());
+        CHECK(!port.Name.empty() && !port.Path.empty(), "port %zu without a name or path", i);
+        CHECK(i == 0 || ports[i - 1].Name < port.Name, "ports are not sorted by name at %s", port.Name.c_str());
+        CHECK(PortScanner::FindByPath(ports, port.Path) == &port, "FindByPath(%s)", port.Path.c_str());
+        if (!port.Serial.empty())
+            CHECK(PortScanner::FindBySerial(ports, port.Serial) != nullptr, "FindBySerial(%s)", port.Serial.c_str());
+    }
+    CHECK(PortScanner::FindBySerial(ports, "") == nullptr, "an empty serial number matches a port");
+    CHECK(PortScanner::FindByPath(ports, "no such port") == nullptr, "FindByPath of a missing port");
+
+    // Фоновый поток публикует первый снимок, повторный скан того же списка поколение не меняет
+    PortScanner scanner;
+    CHECK(WaitFor([&] { return *scanner.Ports() == PortScanner::Scan(); }), "the background snapshot differs from Scan()");
+    const unsigned generation = scanner.Generation();
+    std::shared_ptr<const PortScanner::Snapshot> before = scanner.Ports();
+    scanner.Rescan();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    if (*before == PortScanner::Scan())
+        CHECK(scanner.Generation() == generation, "Rescan() of an unchanged list bumped the generation");
+}
+
+#ifndef _WIN32
+// Ведущая сторона псевдотерминала играет устройство, ComPort открывает подчинённую
+static void CheckComPort()
+{
+    const int master = posix_openpt(O_RDWR | O_NOCTTY);
+    CHECK(master >= 0 && grantpt(master) == 0 && unlockpt(master) == 0, "posix_openpt");
+    if (master < 0)
+        return;
+    const std::string path = ptsname(master);
+
+    std::mutex mutex;
+    std::string received;
+    const auto callback = [&](const char *data, size_t len) {
+        std::lock_guard<std::mutex> lock(mutex);
+        received.append(data, len);
+    };
+    const auto got = [&](size_t size) {
+        return WaitFor([&] {
+            std::lock_guard<std::mutex> lock(mutex);
+            return received.size() >= size;
+        });
+    };
+
+    ComPort port;
+    CHECK(!port.is_opened(), "a new port is open");
+    CHECK(!port.open("/dev/no-such-port", 115200, callback) && !port.is_opened(), "opened a missing port");
+    CHECK(!port.open(path, 12345, callback) && !port.is_opened(), "opened with an unsupported baud rate");
+    CHECK(port.open(path, 115200, callback) && port.is_opened(), "open(%s)", path.c_str());
+    CHECK(!port.open(path, 115200, callback), "open() of an open port");
+
+    // Все байты, включая управляющие символы терминала: режим сырой
+    std::string frame;
+    for (int i = 0; i < 256; i++)
+        frame.push_back((char)i);
+    for (int i = 0; i < 40; i++)
+        CHECK(write(master, frame.data(), frame.size()) == (ssize_t)frame.size(), "write to the master");
+    CHECK(got(frame.size() * 40), "received %zu of %zu bytes", received.size(), frame.size() * 40);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        bool same = received.size() == frame.size() * 40;
+        for (size_t i = 0; same && i < received.size(); i++)
+            same = received[i] == frame[i % frame.size()];
+        CHECK(same, "received bytes differ from the sent ones");
+        received.clear();
+    }
+
+    // Запись всеми тремя перегрузками
+    uint8_t buf[3] = {0xC0, 0x00, 0x0A};
+    CHECK(port.Write(buf, sizeof(buf)), "Write(buf, len)");
+    CHECK(port.Write(std::string("\r\nabc")), "Write(string)");
+    port.Write((unsigned char)0xDB);
+    std::string echo;
+    WaitFor([&] {
+        char chunk[64];
+        const ssize_t n = read(master, chunk, sizeof(chunk));
+        if (n > 0)
+            echo.append(chunk, (size_t)n);
+        return echo.size() >= 9;
+    });
+    CHECK(echo == std::string("\xC0\x00\x0A\r\nabc\xDB", 9), "the device got %zu bytes", echo.size());
+
+    // close() останавливает поток чтения без данных в порту, после него порт открывается снова
+    port.close();
+    CHECK(!port.is_opened(), "is_opened() after close()");
+    port.close();
+    CHECK(port.open(path, 921600, callback), "reopen");
+    CHECK(write(master, "xyz", 3) == 3 && got(3), "receive after reopen");
+
+    // Устройство исчезло: поток чтения выходит сам, порт закрывается как обычно
+    close(master);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    CHECK(port.is_opened(), "the port closed itself on hang-up");
+    port.close();
+    CHECK(!port.is_opened(), "is_opened() after close() of a hung-up port");
+}
+#endif
+
+int main()
+{
+    CheckScanner();
+#ifndef _WIN32
+    CheckComPort();
+#endif
+
+    if (failures == 0)
+        printf("port: all checks passed\n");
+    return failures == 0 ? 0 : 1;
+}